@@ -0,0 +1,108 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "gain_capital_bar_builder.h"
+#include "gain_capital_market_data.h"
+#include "gain_capital_price.h"
+
+namespace
+{
+
+namespace GC = gaincapital;
+
+std::vector<GC::GCPriceBar> make_minute_bars(std::int64_t const num_bars)
+{
+    std::vector<GC::GCPriceBar> bars;
+    bars.reserve(static_cast<std::size_t>(num_bars));
+    for (std::int64_t i = 0; i < num_bars; ++i)
+    {
+        GC::GCPrice const open = GC::GCPrice::from_units(125000 + (i * 7919) % 500, 5);
+        bars.push_back({1700000000000 + i * 60000, open, open + GC::GCPrice::from_units(20, 5), open - GC::GCPrice::from_units(20, 5), open});
+    }
+    return bars;
+}
+
+// =================================================================================
+// Tick Aggregation
+// =================================================================================
+
+void BM_BarBuilder_AddTick(benchmark::State& state)
+{
+    /* Ticks 250ms apart, so the minute series roll every 240 ticks and the rest update in place */
+    GC::GCBarBuilder builder;
+    GC::GCPriceTick tick {1700000000000, GC::GCPrice {1.25, 5}};
+    GC::GCPrice const step = GC::GCPrice::from_units(1, 5);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(builder.add_tick(tick));
+        tick.timestamp_ms += 250;
+        tick.price += step;
+    }
+}
+
+void BM_BarBuilder_CurrentBar(benchmark::State& state)
+{
+    GC::GCBarBuilder builder;
+    for (std::int64_t i = 0; i < 10000; ++i)
+    {
+        builder.add_tick({1700000000000 + i * 250, GC::GCPrice::from_units(125000 + i, 5)});
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(builder.current("MINUTE", 5));
+    }
+}
+
+// =================================================================================
+// Resampling
+// =================================================================================
+
+void BM_Resample_Rows(benchmark::State& state)
+{
+    /* The same single pass over an array of bar structs, comparing fixed-point prices */
+    std::vector<GC::GCPriceBar> const bars = make_minute_bars(100000);
+    std::int64_t const period_ms           = state.range(0) * 60000;
+    for (auto _ : state)
+    {
+        std::vector<GC::GCPriceBar> result;
+        for (GC::GCPriceBar const& bar : bars)
+        {
+            std::int64_t const start = bar.timestamp_ms - bar.timestamp_ms % period_ms;
+            if (result.empty() || result.back().timestamp_ms != start)
+            {
+                result.push_back({start, bar.open, bar.high, bar.low, bar.close});
+                continue;
+            }
+            result.back().high  = std::max(result.back().high, bar.high);
+            result.back().low   = std::min(result.back().low, bar.low);
+            result.back().close = bar.close;
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+
+void BM_Resample_Columnar(benchmark::State& state)
+{
+    GC::GCBarColumns const columns = GC::GCBarColumns::from_bars(make_minute_bars(100000), 5);
+    for (auto _ : state)
+    {
+        auto result = GC::resample_bars(columns, "MINUTE", 1, state.range(0) < 60 ? "MINUTE" : "HOUR",
+                                        static_cast<std::size_t>(state.range(0) < 60 ? state.range(0) : state.range(0) / 60));
+        benchmark::DoNotOptimize(result.value().close.data());
+    }
+}
+
+BENCHMARK(BM_BarBuilder_AddTick);
+BENCHMARK(BM_BarBuilder_CurrentBar);
+BENCHMARK(BM_Resample_Rows)->Arg(5)->Arg(15)->Arg(60);
+BENCHMARK(BM_Resample_Columnar)->Arg(5)->Arg(15)->Arg(60);
+
+}// namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,166 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "gain_capital_client.h"
+#include "gain_capital_metrics.h"
+#include "gain_capital_mock_server.h"
+#include "gain_capital_order.h"
+
+namespace
+{
+
+namespace GC = gaincapital;
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+struct Scenario
+{
+    char const* name;
+    GC::GCMockFaults faults;
+};
+
+// Every Scenario Runs Over a 200us Base Latency
+std::array<Scenario, 6> const SCENARIOS {{
+    {"clean", {}},
+    {"jitter", {.jitter = microseconds {300}, .tail_probability = 0.01, .tail_latency = milliseconds {20}}},
+    {"slow_body", {.body_bytes_per_second = 10'000'000}},
+    {"resets", {.reset_probability = 0.01}},
+    {"503_bursts", {.burst_probability = 0.005, .burst_length = 10, .burst_status = 503}},
+    {"stalls", {.stall_probability = 0.01, .stall = milliseconds {50}}},
+}};
+
+std::unique_ptr<GC::GCMockServer> start_server(GC::GCMockFaults const& faults)
+{
+    GC::GCMockServerConfig config;
+    config.threads      = 2;
+    config.history_rows = 1000;
+    config.latency      = microseconds {200};
+    config.faults       = faults;
+    return std::move(GC::GCMockServer::start(config).value());
+}
+
+void report_latencies(benchmark::State& state, std::vector<double>& latencies_us)
+{
+    std::sort(latencies_us.begin(), latencies_us.end());
+    auto const percentile = [&latencies_us](double const q)
+    { return latencies_us[std::min(latencies_us.size() - 1, static_cast<std::size_t>(q * static_cast<double>(latencies_us.size())))]; };
+    state.counters["p50_us"]   = percentile(0.5);
+    state.counters["p99_us"]   = percentile(0.99);
+    state.counters["p99.9_us"] = percentile(0.999);
+    state.counters["max_us"]   = latencies_us.back();
+}
+
+// =================================================================================
+// Client Tail Latency Against a Degraded Mock Server
+// =================================================================================
+
+void BM_Fault_GetTickHistory(benchmark::State& state)
+{
+    /* One blocking 1000-tick history call per iteration; a fault surfaces as an error, the client does not retry */
+    Scenario const& scenario = SCENARIOS[static_cast<std::size_t>(state.range(0))];
+    auto server              = start_server(scenario.faults);
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(server->url());
+    [[maybe_unused]] auto const auth_response = gc.authenticate_session();
+    [[maybe_unused]] auto const market_id     = gc.return_market_id("USD/CAD");
+
+    std::vector<double> latencies_us;
+    std::int64_t errors = 0;
+    for (auto _ : state)
+    {
+        auto const start  = std::chrono::steady_clock::now();
+        auto tick_response = gc.get_tick_history("USD/CAD", 1000);
+        latencies_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        errors += tick_response.has_value() ? 0 : 1;
+        benchmark::DoNotOptimize(tick_response);
+    }
+    report_latencies(state, latencies_us);
+    state.counters["error_rate"] = static_cast<double>(errors) / static_cast<double>(state.iterations());
+    state.SetLabel(scenario.name);
+}
+
+void BM_Fault_GetTickHistory_Hedged(benchmark::State& state)
+{
+    /* As above with hedging on; improvement_us compares against the client's own unhedged holdout reads */
+    Scenario const& scenario = SCENARIOS[static_cast<std::size_t>(state.range(0))];
+    auto server              = start_server(scenario.faults);
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(server->url());
+    gc.set_hedging(true);
+    [[maybe_unused]] auto const auth_response = gc.authenticate_session();
+    [[maybe_unused]] auto const market_id     = gc.return_market_id("USD/CAD");
+
+    std::vector<double> latencies_us;
+    std::int64_t errors = 0;
+    for (auto _ : state)
+    {
+        auto const start   = std::chrono::steady_clock::now();
+        auto tick_response = gc.get_tick_history("USD/CAD", 1000);
+        latencies_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        errors += tick_response.has_value() ? 0 : 1;
+        benchmark::DoNotOptimize(tick_response);
+    }
+    report_latencies(state, latencies_us);
+    GC::GCMetricsSnapshot const metrics = gc.get_metrics();
+    double const hedges_sent            = static_cast<double>(metrics.hedges_sent);
+    state.counters["error_rate"]        = static_cast<double>(errors) / static_cast<double>(state.iterations());
+    state.counters["hedge_rate"]        = metrics.hedge_rate();
+    state.counters["hedge_win_rate"]    = metrics.hedges_sent == 0 ? 0.0 : static_cast<double>(metrics.hedge_wins) / hedges_sent;
+    state.counters["improvement_us"]    = metrics.hedge_p99_improvement_us();
+    state.SetLabel(scenario.name);
+}
+
+// =================================================================================
+// Order Retries Against a Degraded Mock Server
+// =================================================================================
+
+void BM_Fault_PlaceOrder(benchmark::State& state)
+{
+    /*
+     * Each order fetches bid and ask then posts, retrying the post every 100ms for up to five seconds.
+     * requests_per_order counts every request sent, including the active order checks after a failed post.
+     */
+    Scenario const& scenario = SCENARIOS[static_cast<std::size_t>(state.range(0))];
+    auto server              = start_server(scenario.faults);
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(server->url());
+    [[maybe_unused]] auto const auth_response = gc.authenticate_session();
+    [[maybe_unused]] auto const market_id     = gc.return_market_id("USD/CAD");
+    std::uint64_t const requests_before       = gc.get_metrics().requests_sent;
+
+    std::vector<double> latencies_us;
+    std::int64_t failed = 0;
+    for (auto _ : state)
+    {
+        auto const start   = std::chrono::steady_clock::now();
+        auto order_response = gc.trade_order(GC::StopLimitOrder {"USD/CAD", "buy", 1000, 1.1, std::nullopt, std::nullopt});
+        latencies_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        failed += order_response.has_value() ? 0 : 1;
+        benchmark::DoNotOptimize(order_response);
+    }
+    report_latencies(state, latencies_us);
+    state.counters["failure_rate"]       = static_cast<double>(failed) / static_cast<double>(state.iterations());
+    state.counters["requests_per_order"] = static_cast<double>(gc.get_metrics().requests_sent - requests_before) /
+                                           static_cast<double>(state.iterations());
+    state.SetLabel(scenario.name);
+}
+
+BENCHMARK(BM_Fault_GetTickHistory)->DenseRange(0, SCENARIOS.size() - 1)->Iterations(2000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Fault_GetTickHistory_Hedged)->Arg(0)->Arg(1)->Arg(5)->Iterations(2000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Fault_PlaceOrder)->Arg(0)->Arg(3)->Arg(4)->Iterations(500)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+}// namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,106 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+#include "json/json.hpp"
+
+#include "gain_capital_client.h"
+#include "gain_capital_exception.h"
+#include "gain_capital_mock_server.h"
+
+namespace
+{
+
+namespace GC = gaincapital;
+
+GC::GCMockServer& mock_server()
+{
+    static std::unique_ptr<GC::GCMockServer> const server = []
+    {
+        GC::GCMockServerConfig config;
+        config.threads = 4;
+        return std::move(GC::GCMockServer::start(config).value());
+    }();
+    return *server;
+}
+
+void authenticate(GC::GCClient& gc)
+{
+    gc.set_testing_rest_urls(mock_server().url());
+    gc.set_request_coalescing(false);
+    [[maybe_unused]] auto const auth_response = gc.authenticate_session();
+    [[maybe_unused]] auto const market_id     = gc.return_market_id("USD/CAD");
+}
+
+// =================================================================================
+// Client Throughput Against the Loopback Mock Server
+// =================================================================================
+
+void BM_Load_GetPrices_Async(benchmark::State& state)
+{
+    /* Keeps state.range(0) requests in flight through the client's event loop */
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    authenticate(gc);
+
+    std::size_t const batch = static_cast<std::size_t>(state.range(0));
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t remaining = 0;
+    std::atomic<std::size_t> failures {0};
+    auto const on_response = [&](std::expected<nlohmann::json, GC::GCException> response)
+    {
+        if (! response)
+        {
+            failures.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> const lock {mutex};
+        if (--remaining == 0)
+        {
+            done.notify_one();
+        }
+    };
+
+    for (auto _ : state)
+    {
+        remaining = batch;
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            gc.get_prices_async(on_response, "USD/CAD", 10);
+        }
+        std::unique_lock<std::mutex> lock {mutex};
+        done.wait(lock, [&remaining] { return remaining == 0; });
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(static_cast<std::size_t>(state.iterations()) * batch));
+    state.counters["failures"] = static_cast<double>(failures.load());
+}
+
+void BM_Load_TickHistory(benchmark::State& state)
+{
+    /* One blocking call per iteration; state.range(0) ticks per response */
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    authenticate(gc);
+
+    for (auto _ : state)
+    {
+        auto tick_response = gc.get_tick_history("USD/CAD", static_cast<std::size_t>(state.range(0)));
+        benchmark::DoNotOptimize(tick_response);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Load_GetPrices_Async)->Arg(64)->Arg(512)->UseRealTime();
+BENCHMARK(BM_Load_TickHistory)->Arg(100)->Arg(10000)->UseRealTime();
+
+}// namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,127 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "httpmockserver/mock_server.h"
+#include "json/json.hpp"
+
+#include "gain_capital_client.h"
+#include "gain_capital_order.h"
+
+namespace
+{
+
+namespace GC = gaincapital;
+
+std::string const URL = "http://localhost:9203";
+
+class HTTPMock : public httpmock::MockServer
+{
+  public:
+    /// Create HTTP server on port 9203
+    explicit HTTPMock(int port = 9203) : MockServer(port) {}
+
+  private:
+    /// Handler called by MockServer on HTTP request.
+    Response responseHandler(std::string const& url, std::string const& method, std::string const& data, std::vector<UrlArg> const& urlArguments,
+                             std::vector<Header> const& headers) override
+    {
+        if (method == "POST" && url == "/Session")
+        {
+            return Response(200, "{\"statusCode\": 0, \"session\": \"123\"}");
+        }
+        else if (method == "POST" && matchesPrefix(url, "/Session/validate"))
+        {
+            return Response(200, "{\"isAuthenticated\": true}");
+        }
+        else if (method == "GET" && matchesPrefix(url, "/userAccount/ClientAndTradingAccount"))
+        {
+            return Response(200, "{\"tradingAccounts\": [{\"tradingAccountId\":\"TradingTestID\", \"clientAccountId\":\"ClientTestID\"}]}");
+        }
+        else if (method == "GET" && matchesPrefix(url, "/cfd/markets"))
+        {
+            return Response(200, "{\"Markets\": [{\"MarketId\": 123}]}");
+        }
+        else if (method == "GET" && matchesPrefix(url, "/market/123/tickhistory"))
+        {
+            return Response(200, "{\"PriceTicks\":[{\"TickDate\":\"\\/Date(1700000000000)\\/\",\"Price\":1.0}]}");
+        }
+        else if (method == "POST" && matchesPrefix(url, "/order/newstoplimitorder"))
+        {
+            return Response(200, "{\"OrderId\": 1001}");
+        }
+        else if (method == "POST" && matchesPrefix(url, "/order/updatestoplimitorder"))
+        {
+            return Response(200, "{\"OrderId\": 1001, \"StatusReason\": 1, \"Status\": 1}");
+        }
+        else if (method == "POST" && matchesPrefix(url, "/order/cancel"))
+        {
+            return Response(200, "{}");
+        }
+        return Response(404, "Not Found");
+    }
+
+    /// Return true if \p url starts with \p str.
+    bool matchesPrefix(std::string const& url, std::string const& str) const { return url.substr(0, str.size()) == str; }
+};
+
+// =================================================================================
+// Re-Pricing a Working Stop / Limit Order | Loopback Round Trips
+// =================================================================================
+
+void BM_Reprice_CancelAndResubmit(benchmark::State& state)
+{
+    /* Cancel pays for a session validation; the new order pays for a quote fetch */
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    [[maybe_unused]] auto const auth_response = gc.authenticate_session();
+
+    GC::GCPrice trigger_price {1.0, 5};
+    GC::GCPrice const stop_price {0.9, 5};
+    GC::GCPrice const limit_price {1.1, 5};
+    for (auto _ : state)
+    {
+        auto cancel_response = gc.cancel_order("1001");
+        auto order_response  = gc.trade_order(GC::StopLimitOrder {"USD/CAD", "buy", 1000, trigger_price, stop_price, limit_price});
+        benchmark::DoNotOptimize(order_response);
+        trigger_price += GC::GCPrice::from_units(1, 5);
+    }
+}
+
+void BM_Reprice_Amend(benchmark::State& state)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    [[maybe_unused]] auto const auth_response = gc.authenticate_session();
+
+    GC::GCPrice trigger_price {1.0, 5};
+    GC::GCPrice const stop_price {0.9, 5};
+    GC::GCPrice const limit_price {1.1, 5};
+    for (auto _ : state)
+    {
+        auto amend_response = gc.amend_order("1001", GC::StopLimitOrder {"USD/CAD", "buy", 1000, trigger_price, stop_price, limit_price});
+        benchmark::DoNotOptimize(amend_response);
+        trigger_price += GC::GCPrice::from_units(1, 5);
+    }
+}
+
+BENCHMARK(BM_Reprice_CancelAndResubmit)->UseRealTime();
+BENCHMARK(BM_Reprice_Amend)->UseRealTime();
+
+}// namespace
+
+int main(int argc, char** argv)
+{
+    HTTPMock server;
+    server.start();
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    server.stop();
+    return 0;
+}
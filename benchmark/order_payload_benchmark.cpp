@@ -0,0 +1,110 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <array>
+#include <charconv>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "json/json.hpp"
+
+#include "gain_capital_order.h"
+#include "gain_capital_price.h"
+
+namespace
+{
+
+namespace GC = gaincapital;
+
+// =================================================================================
+// Order To Wire
+// =================================================================================
+
+void BM_OrderPayload_Json(benchmark::State& state)
+{
+    /* The previous trade_order attempt: rebuild, merge and dump the payload every retry */
+    nlohmann::json trade_map;
+    trade_map["USD/CAD"] = {{"Direction", "buy"}, {"Quantity", 1000}, {"TriggerPrice", 1.3}, {"StopPrice", 1.2}, {"LimitPrice", 1.4}};
+    double bid_price     = 1.25;
+    for (auto _ : state)
+    {
+        std::vector<nlohmann::json> if_done;
+        if_done.emplace_back(nlohmann::json {{"Stop",
+                                              {{"TriggerPrice", trade_map["USD/CAD"]["StopPrice"].dump()},
+                                               {"Direction", "sell"},
+                                               {"Quantity", trade_map["USD/CAD"]["Quantity"].dump()}}}});
+        if_done.emplace_back(nlohmann::json {{"Limit",
+                                              {{"TriggerPrice", trade_map["USD/CAD"]["LimitPrice"].dump()},
+                                               {"Direction", "sell"},
+                                               {"Quantity", trade_map["USD/CAD"]["Quantity"].dump()}}}});
+        nlohmann::json trade_payload = {
+            {"Direction", trade_map["USD/CAD"]["Direction"]},
+            {"MarketId", "401484347"},
+            {"Quantity", trade_map["USD/CAD"]["Quantity"].dump()},
+            {"MarketName", "USD/CAD"},
+            {"TradingAccountId", "TradingTestID"},
+            {"OfferPrice", nlohmann::json(bid_price + 0.0002).dump()},
+            {"BidPrice", nlohmann::json(bid_price).dump()},
+        };
+        nlohmann::json additional_payload = {{"TriggerPrice", trade_map["USD/CAD"]["TriggerPrice"].dump()}, {"IfDone", if_done}};
+        trade_payload.update(additional_payload);
+        std::string const wire = trade_payload.dump();
+        benchmark::DoNotOptimize(wire.data());
+        bid_price += 1e-5;
+    }
+}
+
+void BM_OrderPayload_Template(benchmark::State& state)
+{
+    GC::GCOrderTemplate order_template {GC::StopLimitOrder {"USD/CAD", "buy", 1000, 1.3, 1.2, 1.4}, "401484347", "TradingTestID"};
+    GC::GCPrice bid_price {1.25, 5};
+    GC::GCPrice const spread = GC::GCPrice::from_units(20, 5);
+    GC::GCPrice const tick   = GC::GCPrice::from_units(1, 5);
+    for (auto _ : state)
+    {
+        std::string const& wire = order_template.render(bid_price, bid_price + spread);
+        benchmark::DoNotOptimize(wire.data());
+        bid_price += tick;
+    }
+}
+
+// =================================================================================
+// Price Text
+// =================================================================================
+
+void BM_PriceRoundTrip_Double(benchmark::State& state)
+{
+    /* from_chars into a double and shortest-form to_chars back out */
+    std::string const text = "1.27485";
+    std::array<char, 32> digits {};
+    for (auto _ : state)
+    {
+        double price = 0;
+        std::from_chars(text.data(), text.data() + text.size(), price);
+        auto const [ptr, err] = std::to_chars(digits.data(), digits.data() + digits.size(), price);
+        benchmark::DoNotOptimize(ptr);
+    }
+}
+
+void BM_PriceRoundTrip_Fixed(benchmark::State& state)
+{
+    std::string const text = "1.27485";
+    std::string buffer;
+    buffer.reserve(32);
+    for (auto _ : state)
+    {
+        buffer.clear();
+        GC::GCPrice::parse(text, 5)->append_to(buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+}
+
+BENCHMARK(BM_OrderPayload_Json);
+BENCHMARK(BM_OrderPayload_Template);
+BENCHMARK(BM_PriceRoundTrip_Double);
+BENCHMARK(BM_PriceRoundTrip_Fixed);
+
+}// namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,133 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+
+#include "gain_capital_client.h"
+#include "gain_capital_transport.h"
+
+namespace
+{
+
+namespace GC = gaincapital;
+
+std::string const URL = "http://replay.invalid";
+
+class CannedServer final : public GC::GCTransport
+{
+    /* Stands in for the API while the synthetic session is recorded */
+  public:
+    std::uint64_t submit(GC::NetworkRequest request, GC::NetworkCallback callback) override
+    {
+        std::string_view const path = std::string_view {request.url}.substr(URL.size());
+        GC::NetworkResponse response {200, "", "", {}};
+        if (path == "/Session")
+        {
+            response.text = "{\"statusCode\": 0, \"session\": \"123\"}";
+        }
+        else if (path.starts_with("/userAccount/ClientAndTradingAccount"))
+        {
+            response.text = "{\"tradingAccounts\": [{\"tradingAccountId\":\"TradingTestID\", \"clientAccountId\":\"ClientTestID\"}]}";
+        }
+        else if (path.starts_with("/cfd/markets"))
+        {
+            response.text = "{\"Markets\": [{\"MarketId\": 123}]}";
+        }
+        else if (path.starts_with("/market/123/tickhistory"))
+        {
+            response.text = "{\"PriceTicks\":[";
+            for (std::size_t i = 0; i < 1000; ++i)
+            {
+                response.text += (i == 0 ? "" : ",") + std::string("{\"TickDate\":\"\\/Date(") + std::to_string(1700000000000 + i * 250) +
+                                 ")\\/\",\"Price\":1.2" + std::to_string(1000 + i % 900) + "}";
+            }
+            response.text += "]}";
+        }
+        else
+        {
+            response.status_code = 404;
+        }
+        callback(std::move(response));
+        return 0;
+    }
+
+    [[nodiscard]] std::size_t in_flight() const noexcept override { return 0; }
+};
+
+std::filesystem::path const& session_log()
+{
+    /*
+     * GC_SESSION_LOG names a recorded production session to replay; it should contain the calls below.
+     * Otherwise a synthetic session is recorded once from canned responses.
+     */
+    static std::filesystem::path const path = []
+    {
+        if (char const* recorded = std::getenv("GC_SESSION_LOG"))
+        {
+            return std::filesystem::path {recorded};
+        }
+        std::filesystem::path file = std::filesystem::temp_directory_path() / "gc_replay_benchmark.gcrr";
+        GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+        gc.set_testing_rest_urls(URL);
+        auto recorder = GC::GCRecordingTransport::open(file, std::make_shared<CannedServer>());
+        gc.set_transport(recorder.value());
+        [[maybe_unused]] auto const auth_response    = gc.authenticate_session();
+        [[maybe_unused]] auto const account_response = gc.get_account_info();
+        [[maybe_unused]] auto const tick_response    = gc.get_tick_history("USD/CAD", 1000);
+        [[maybe_unused]] auto const flushed          = recorder.value()->flush();
+        return file;
+    }();
+    return path;
+}
+
+// =================================================================================
+// Client Call Path Over a Replayed Session | No Network, No Recorded Latency
+// =================================================================================
+
+void BM_Replay_AccountInfo(benchmark::State& state)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto replay = GC::GCReplayTransport::open(session_log(), 0.0);
+    gc.set_transport(replay.value());
+    [[maybe_unused]] auto const auth_response = gc.authenticate_session();
+
+    for (auto _ : state)
+    {
+        auto account_response = gc.get_account_info();
+        benchmark::DoNotOptimize(account_response);
+    }
+    state.counters["misses"] = static_cast<double>(replay.value()->misses());
+}
+
+void BM_Replay_TickHistory(benchmark::State& state)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto replay = GC::GCReplayTransport::open(session_log(), 0.0);
+    gc.set_transport(replay.value());
+    [[maybe_unused]] auto const auth_response = gc.authenticate_session();
+
+    for (auto _ : state)
+    {
+        auto tick_response = gc.get_tick_history("USD/CAD", 1000);
+        benchmark::DoNotOptimize(tick_response);
+    }
+    state.counters["misses"] = static_cast<double>(replay.value()->misses());
+}
+
+BENCHMARK(BM_Replay_AccountInfo)->UseRealTime();
+BENCHMARK(BM_Replay_TickHistory)->UseRealTime();
+
+}// namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,154 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "json/json.hpp"
+
+#include "gain_capital_market_data.h"
+
+namespace
+{
+
+namespace GC = gaincapital;
+
+std::atomic<std::size_t> allocation_count {0};
+
+std::string make_tick_history(std::int64_t const num_ticks)
+{
+    std::string body = "{\"PriceTicks\":[";
+    for (std::int64_t i = 0; i < num_ticks; ++i)
+    {
+        body += (i ? "," : "");
+        body += "{\"TickDate\":\"\\/Date(" + std::to_string(1700000000000 + i * 250) + ")\\/\",\"Price\":" +
+                std::to_string(1.25 + static_cast<double>(i) * 1e-5) + "}";
+    }
+    return body + "]}";
+}
+
+std::string make_bar_history(std::int64_t const num_bars)
+{
+    std::string body = "{\"PriceBars\":[";
+    for (std::int64_t i = 0; i < num_bars; ++i)
+    {
+        std::string const price = std::to_string(1.25 + static_cast<double>(i) * 1e-4);
+        body += (i ? "," : "");
+        body += "{\"BarDate\":\"\\/Date(" + std::to_string(1700000000000 + i * 60000) + ")\\/\",\"Open\":" + price + ",\"High\":" + price +
+                ",\"Low\":" + price + ",\"Close\":" + price + "}";
+    }
+    return body + "],\"PartialPriceBar\":null}";
+}
+
+void report_allocations(benchmark::State& state, std::size_t const allocations_before)
+{
+    state.counters["allocs_per_call"] =
+        benchmark::Counter(static_cast<double>(allocation_count.load() - allocations_before), benchmark::Counter::kAvgIterations);
+}
+
+// =================================================================================
+// Tick History
+// =================================================================================
+
+void BM_TickHistory_Json(benchmark::State& state)
+{
+    /* The get_prices path: a heap-allocated json tree the caller then walks */
+    std::string const body               = make_tick_history(state.range(0));
+    std::size_t const allocations_before = allocation_count.load();
+    for (auto _ : state)
+    {
+        nlohmann::json const response = nlohmann::json::parse(body);
+        std::vector<GC::GCPriceTick> ticks;
+        ticks.reserve(response["PriceTicks"].size());
+        for (auto const& tick : response["PriceTicks"])
+        {
+            auto const timestamp_response = GC::parse_wcf_date(tick["TickDate"].get_ref<std::string const&>());
+            ticks.emplace_back(timestamp_response.value(), GC::GCPrice {tick["Price"].get<double>()});
+        }
+        benchmark::DoNotOptimize(ticks.data());
+    }
+    report_allocations(state, allocations_before);
+}
+
+void BM_TickHistory_Arena(benchmark::State& state)
+{
+    std::string const body               = make_tick_history(state.range(0));
+    auto warm_up                         = GC::parse_price_ticks(body);
+    std::size_t const allocations_before = allocation_count.load();
+    for (auto _ : state)
+    {
+        auto ticks = GC::parse_price_ticks(body);
+        benchmark::DoNotOptimize(ticks.value().data());
+    }
+    report_allocations(state, allocations_before);
+}
+
+// =================================================================================
+// Bar History
+// =================================================================================
+
+void BM_BarHistory_Json(benchmark::State& state)
+{
+    std::string const body               = make_bar_history(state.range(0));
+    std::size_t const allocations_before = allocation_count.load();
+    for (auto _ : state)
+    {
+        nlohmann::json const response = nlohmann::json::parse(body);
+        std::vector<GC::GCPriceBar> bars;
+        bars.reserve(response["PriceBars"].size());
+        for (auto const& bar : response["PriceBars"])
+        {
+            auto const timestamp_response = GC::parse_wcf_date(bar["BarDate"].get_ref<std::string const&>());
+            bars.emplace_back(timestamp_response.value(), GC::GCPrice {bar["Open"].get<double>()}, GC::GCPrice {bar["High"].get<double>()},
+                              GC::GCPrice {bar["Low"].get<double>()}, GC::GCPrice {bar["Close"].get<double>()});
+        }
+        benchmark::DoNotOptimize(bars.data());
+    }
+    report_allocations(state, allocations_before);
+}
+
+void BM_BarHistory_Arena(benchmark::State& state)
+{
+    std::string const body               = make_bar_history(state.range(0));
+    auto warm_up                         = GC::parse_price_bars(body);
+    std::size_t const allocations_before = allocation_count.load();
+    for (auto _ : state)
+    {
+        auto bars = GC::parse_price_bars(body);
+        benchmark::DoNotOptimize(bars.value().data());
+    }
+    report_allocations(state, allocations_before);
+}
+
+BENCHMARK(BM_TickHistory_Json)->Arg(100)->Arg(1000);
+BENCHMARK(BM_TickHistory_Arena)->Arg(100)->Arg(1000);
+BENCHMARK(BM_BarHistory_Json)->Arg(100)->Arg(1000);
+BENCHMARK(BM_BarHistory_Arena)->Arg(100)->Arg(1000);
+
+}// namespace
+
+// =================================================================================
+// Global Allocation Counting
+// =================================================================================
+
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+BENCHMARK_MAIN();
@@ -0,0 +1,111 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "benchmark/benchmark.h"
+
+#include "gain_capital_position_book.h"
+#include "gain_capital_risk.h"
+
+namespace
+{
+
+namespace GC = gaincapital;
+
+std::atomic<std::size_t> allocation_count {0};
+
+void report_allocations(benchmark::State& state, std::size_t const allocations_before)
+{
+    state.counters["allocs_per_call"] =
+        benchmark::Counter(static_cast<double>(allocation_count.load() - allocations_before), benchmark::Counter::kAvgIterations);
+}
+
+std::shared_ptr<GC::GCPositionBook> make_book(std::int64_t const num_markets)
+{
+    auto book = std::make_shared<GC::GCPositionBook>();
+    for (std::int64_t market_id = 0; market_id < num_markets; ++market_id)
+    {
+        book->apply_fill(market_id, 1000, 1.25);
+    }
+    return book;
+}
+
+// =================================================================================
+// Pre-Trade Checks
+// =================================================================================
+
+void BM_RiskCheck_NoLimits(benchmark::State& state)
+{
+    GC::GCRiskEngine engine {make_book(state.range(0))};
+    GC::GCRiskOrder order {state.range(0) / 2, 1000, 1.25, 1.2499, 1.2501};
+
+    std::size_t const allocations_before = allocation_count.load();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(engine.check(order, false));
+    }
+    report_allocations(state, allocations_before);
+}
+
+void BM_RiskCheck_AllLimits(benchmark::State& state)
+{
+    /* Every limit enabled and passing, with a per-market override; the order rate is exercised without running dry */
+    GC::GCRiskEngine engine {make_book(state.range(0))};
+    engine.set_limits({.max_notional = 1e7, .max_position = 1e6, .max_orders_per_second = 1e12, .price_band = 0.01});
+    engine.set_market_limits(state.range(0) / 2, {.max_notional = 1e6, .max_position = 1e5, .max_orders_per_second = 1e12, .price_band = 0.01});
+    GC::GCRiskOrder order {state.range(0) / 2, 1000, 1.25, 1.2499, 1.2501};
+
+    std::size_t const allocations_before = allocation_count.load();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(engine.check(order));
+    }
+    report_allocations(state, allocations_before);
+}
+
+void BM_RiskCheck_CustomRule(benchmark::State& state)
+{
+    GC::GCRiskEngine engine {make_book(state.range(0))};
+    engine.set_limits({.max_notional = 1e7, .max_position = 1e6, .price_band = 0.01});
+    engine.add_rule([](GC::GCRiskOrder const& order) { return order.signed_quantity < 1e6; });
+    GC::GCRiskOrder order {state.range(0) / 2, 1000, 1.25, 1.2499, 1.2501};
+
+    std::size_t const allocations_before = allocation_count.load();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(engine.check(order, false));
+    }
+    report_allocations(state, allocations_before);
+}
+
+BENCHMARK(BM_RiskCheck_NoLimits)->Arg(10)->Arg(10000);
+BENCHMARK(BM_RiskCheck_AllLimits)->Arg(10)->Arg(10000);
+BENCHMARK(BM_RiskCheck_CustomRule)->Arg(10)->Arg(10000);
+
+}// namespace
+
+// =================================================================================
+// Global Allocation Counting
+// =================================================================================
+
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+BENCHMARK_MAIN();
@@ -0,0 +1,137 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "json/json.hpp"
+
+#include "gain_capital_market_data.h"
+#include "gain_capital_price.h"
+#include "gain_capital_tick_store.h"
+
+namespace
+{
+
+namespace GC = gaincapital;
+
+constexpr std::int64_t NUM_TICKS = 1'000'000;
+
+std::vector<GC::GCPriceTick> make_ticks()
+{
+    /* Irregular 50ms - 1s spacing with a random walk of up to +/- 3 pips */
+    std::vector<GC::GCPriceTick> ticks;
+    ticks.reserve(NUM_TICKS);
+    std::int64_t timestamp = 1700000000000;
+    std::int64_t units     = 125000;
+    std::uint64_t state    = 88172645463325252ULL;
+    for (std::int64_t i = 0; i < NUM_TICKS; ++i)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        timestamp += 50 + static_cast<std::int64_t>(state % 950);
+        units += static_cast<std::int64_t>((state >> 16) % 7) - 3;
+        ticks.push_back({timestamp, GC::GCPrice::from_units(units, 5)});
+    }
+    return ticks;
+}
+
+std::vector<GC::GCPriceTick> const& tick_data()
+{
+    static std::vector<GC::GCPriceTick> const ticks = make_ticks();
+    return ticks;
+}
+
+std::filesystem::path const& tick_file()
+{
+    static std::filesystem::path const path = []
+    {
+        std::filesystem::path file = std::filesystem::temp_directory_path() / "gc_tick_store_benchmark.gctk";
+        std::filesystem::remove(file);
+        auto writer = GC::GCTickWriter::open(file, 5);
+        [[maybe_unused]] auto const appended = writer.value().append(tick_data());
+        [[maybe_unused]] auto const closed   = writer.value().close();
+        return file;
+    }();
+    return path;
+}
+
+// =================================================================================
+// Size
+// =================================================================================
+
+void BM_TickStore_Write(benchmark::State& state)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "gc_tick_store_write.gctk";
+    for (auto _ : state)
+    {
+        std::filesystem::remove(path);
+        auto writer = GC::GCTickWriter::open(path, 5, static_cast<std::uint32_t>(state.range(0)));
+        [[maybe_unused]] auto const appended = writer.value().append(tick_data());
+        [[maybe_unused]] auto const closed   = writer.value().close();
+    }
+    state.counters["bytes_per_tick"] = static_cast<double>(std::filesystem::file_size(path)) / NUM_TICKS;
+    state.SetItemsProcessed(state.iterations() * NUM_TICKS);
+    std::filesystem::remove(path);
+}
+
+void BM_TickStore_JsonSize(benchmark::State& state)
+{
+    /* The tickhistory response shape the archive replaces */
+    std::string body;
+    for (auto _ : state)
+    {
+        nlohmann::json price_ticks = nlohmann::json::array();
+        for (std::int64_t i = 0; i < 100000; ++i)
+        {
+            GC::GCPriceTick const& tick = tick_data()[static_cast<std::size_t>(i)];
+            price_ticks.push_back({{"TickDate", "/Date(" + std::to_string(tick.timestamp_ms) + ")/"}, {"Price", tick.price.to_double()}});
+        }
+        body = nlohmann::json {{"PriceTicks", price_ticks}}.dump();
+    }
+    state.counters["bytes_per_tick"] = static_cast<double>(body.size()) / 100000;
+}
+
+// =================================================================================
+// Decode
+// =================================================================================
+
+void BM_TickStore_DecodeAll(benchmark::State& state)
+{
+    auto reader = GC::GCTickReader::open(tick_file());
+    for (auto _ : state)
+    {
+        auto ticks = reader.value().read();
+        benchmark::DoNotOptimize(ticks.value().data());
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_TICKS);
+}
+
+void BM_TickStore_RangeRead(benchmark::State& state)
+{
+    /* A one hour window from the middle of the file touches one or two blocks */
+    auto reader                      = GC::GCTickReader::open(tick_file());
+    std::int64_t const from_ms       = tick_data()[NUM_TICKS / 2].timestamp_ms;
+    std::uint64_t const decoded_from = reader.value().blocks_decoded();
+    for (auto _ : state)
+    {
+        auto ticks = reader.value().read(from_ms, from_ms + 3600000);
+        benchmark::DoNotOptimize(ticks.value().data());
+    }
+    state.counters["blocks_per_read"] =
+        benchmark::Counter(static_cast<double>(reader.value().blocks_decoded() - decoded_from), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_TickStore_Write)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TickStore_JsonSize)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TickStore_DecodeAll)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TickStore_RangeRead);
+
+}// namespace
+
+BENCHMARK_MAIN();
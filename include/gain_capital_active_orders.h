@@ -0,0 +1,68 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_ACTIVE_ORDERS_H
+#define GAIN_CAPITAL_ACTIVE_ORDERS_H
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t
+#include <mutex>        // for mutex
+#include <optional>     // for optional
+#include <string>       // for basic_string
+#include <unordered_map>// for unordered_map
+#include <vector>       // for vector
+
+#include "json/json.hpp"// for json
+
+namespace gaincapital
+{
+
+struct GCActiveOrdersDelta
+{
+    std::vector<nlohmann::json> added;
+    std::vector<nlohmann::json> changed;
+    std::vector<std::int64_t> removed;
+
+    [[nodiscard]] bool empty() const noexcept { return added.empty() && changed.empty() && removed.empty(); }
+};
+
+class GCActiveOrderTracker
+{
+    /*
+     * Per trading account state for list_active_orders: the size of the last listing, which sizes the next
+     * request's MaxResults window, and the last delta snapshot keyed by order ID.
+     */
+  public:
+    static constexpr std::size_t MAX_WINDOW = 65536;
+
+    explicit GCActiveOrderTracker(std::size_t const initial_page_size = 100);
+
+    void set_page_size(std::size_t const size);
+
+    [[nodiscard]] std::size_t window(std::string const& account) const;
+
+    void record_count(std::string const& account, std::size_t const count);
+
+    [[nodiscard]] std::optional<GCActiveOrdersDelta> diff(std::string const& account, nlohmann::json const& active_orders);
+
+    void clear();
+
+    [[nodiscard]] static nlohmann::json const* order_body(nlohmann::json const& entry);
+
+    [[nodiscard]] static std::optional<std::int64_t> read_order_id(nlohmann::json const& entry);
+
+  private:
+    struct AccountState
+    {
+        std::size_t last_count {};
+        std::unordered_map<std::int64_t, nlohmann::json> orders;
+    };
+
+    mutable std::mutex mutex;
+    std::size_t page_size;
+    std::unordered_map<std::string, AccountState> accounts;
+};
+
+}// namespace gaincapital
+
+#endif
@@ -0,0 +1,104 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_ARENA_H
+#define GAIN_CAPITAL_ARENA_H
+
+#include <cstddef>        // for size_t, byte
+#include <cstdint>        // for int64_t, uint64_t
+#include <map>            // for map
+#include <memory_resource>// for monotonic_buffer_resource
+#include <optional>       // for optional
+#include <string>         // for basic_string, char_traits
+#include <vector>         // for vector
+
+#include "json/json.hpp"// for basic_json
+
+namespace gaincapital
+{
+
+class GCArena
+{
+    /*
+     * Per-thread monotonic arena for short-lived response trees. Deallocation is a no-op; memory is
+     * reclaimed all at once by reset(). The retained block grows to the high-water mark, so steady-state
+     * parsing performs no heap allocations.
+     */
+  public:
+    explicit GCArena(std::size_t initial_size = 64 * 1024);
+
+    // No Copy or Move | Handed Out by Reference
+    GCArena(GCArena const& obj) = delete;
+
+    GCArena& operator=(GCArena const& obj) = delete;
+
+    GCArena(GCArena&& obj) = delete;
+
+    GCArena& operator=(GCArena&& obj) = delete;
+
+    [[nodiscard]] void* allocate(std::size_t bytes, std::size_t alignment);
+
+    void reset();
+
+    [[nodiscard]] std::size_t allocations() const noexcept;
+
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    [[nodiscard]] static GCArena& thread_local_arena();
+
+  private:
+    friend class GCArenaScope;
+
+    std::vector<std::byte> block;
+    std::optional<std::pmr::monotonic_buffer_resource> resource;
+    std::size_t allocation_count {};
+    std::size_t bytes_requested {};
+    std::size_t scope_depth {};
+};
+
+class GCArenaScope
+{
+    /*
+     * Resets the calling thread's arena when the outermost scope exits. Nothing allocated through
+     * GCArenaAllocator inside the scope may outlive it.
+     */
+  public:
+    GCArenaScope() noexcept;
+
+    ~GCArenaScope();
+
+    GCArenaScope(GCArenaScope const& obj) = delete;
+
+    GCArenaScope& operator=(GCArenaScope const& obj) = delete;
+};
+
+template <typename T>
+class GCArenaAllocator
+{
+    /*
+     * Stateless allocator over GCArena::thread_local_arena(); stateless so nlohmann::basic_json can default construct it.
+     */
+  public:
+    using value_type = T;
+
+    GCArenaAllocator() noexcept = default;
+
+    template <typename U>
+    GCArenaAllocator(GCArenaAllocator<U> const&) noexcept
+    {
+    }
+
+    [[nodiscard]] T* allocate(std::size_t n) { return static_cast<T*>(GCArena::thread_local_arena().allocate(n * sizeof(T), alignof(T))); }
+
+    void deallocate(T*, std::size_t) noexcept {}
+
+    friend bool operator==(GCArenaAllocator const&, GCArenaAllocator const&) noexcept { return true; }
+};
+
+using GCArenaString = std::basic_string<char, std::char_traits<char>, GCArenaAllocator<char>>;
+
+using GCArenaJson = nlohmann::basic_json<std::map, std::vector, GCArenaString, bool, std::int64_t, std::uint64_t, double, GCArenaAllocator>;
+
+}// namespace gaincapital
+
+#endif
@@ -0,0 +1,103 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_BAR_BUILDER_H
+#define GAIN_CAPITAL_BAR_BUILDER_H
+
+#include <array>       // for array
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t, uint8_t
+#include <expected>    // for expected
+#include <optional>    // for optional
+#include <shared_mutex>// for shared_mutex
+#include <span>        // for span
+#include <string>      // for basic_string
+#include <string_view> // for string_view
+#include <vector>      // for vector
+
+#include "gain_capital_exception.h"  // for GCException
+#include "gain_capital_market_data.h"// for GCPriceTick, GCPriceBar
+#include "gain_capital_price.h"      // for GCPrice
+
+namespace gaincapital
+{
+
+class GCBarBuilder
+{
+    /*
+     * Aggregates one market's ticks into every bar series get_ohlc serves: MINUTE spans 1, 2, 3, 5, 10, 15, 30,
+     * HOUR spans 1, 2, 4, 8, then DAY, WEEK and MONTH. A tick updates the open bar of each series in place;
+     * a completed bar moves into a fixed ring of recent history, so every tick costs the same constant work.
+     * Bars are aligned to UTC boundaries, weeks start on Monday, and intervals without ticks produce no bar.
+     */
+  public:
+    static constexpr std::size_t SERIES_COUNT = 14;
+
+    explicit GCBarBuilder(std::size_t const history = 500);
+
+    bool add_tick(GCPriceTick const& tick);
+
+    std::size_t add_ticks(std::span<GCPriceTick const> ticks);
+
+    [[nodiscard]] std::optional<GCPriceBar> current(std::string_view interval, std::size_t const span = 1) const;
+
+    [[nodiscard]] std::expected<std::vector<GCPriceBar>, GCException> bars(std::string_view interval, std::size_t const num_bars,
+                                                                           std::size_t const span = 1) const;
+
+    [[nodiscard]] std::int64_t last_tick_ms() const;
+
+    void clear();
+
+  private:
+    struct Series
+    {
+        std::int64_t period_ms {};
+        std::int64_t bar_end_ms {};
+        bool has_open {};
+        GCPriceBar open_bar;
+        std::vector<GCPriceBar> completed;
+        std::size_t head {};
+    };
+
+    mutable std::shared_mutex mutex;
+    std::array<Series, SERIES_COUNT> series;
+    std::size_t history_size {};
+    std::int64_t last_tick {};
+    bool has_ticks {};
+
+    void roll(Series& bar_series, GCPriceTick const& tick) const;
+};
+
+struct GCBarColumns
+{
+    /*
+     * Bars stored column by column, with prices as int64 units at a shared number of decimals,
+     * so range reductions run over contiguous integers.
+     */
+    std::uint8_t decimals {GCPrice::DEFAULT_DECIMALS};
+    std::vector<std::int64_t> timestamp_ms;
+    std::vector<std::int64_t> open;
+    std::vector<std::int64_t> high;
+    std::vector<std::int64_t> low;
+    std::vector<std::int64_t> close;
+
+    [[nodiscard]] static GCBarColumns from_bars(std::span<GCPriceBar const> bars, std::uint8_t const decimals = GCPrice::DEFAULT_DECIMALS);
+
+    [[nodiscard]] std::vector<GCPriceBar> to_bars() const;
+
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    void reserve(std::size_t const count);
+};
+
+/*
+ * Derives a coarser get_ohlc series from a finer one without another download, e.g. MINUTE / 1 into MINUTE / 15,
+ * HOUR / 1 and DAY. Intervals and spans follow get_ohlc; the source must be MINUTE, HOUR or DAY.
+ */
+[[nodiscard]] std::expected<GCBarColumns, GCException> resample_bars(GCBarColumns const& bars, std::string_view from_interval,
+                                                                     std::size_t const from_span, std::string_view to_interval,
+                                                                     std::size_t const to_span = 1);
+
+}// namespace gaincapital
+
+#endif
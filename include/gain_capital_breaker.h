@@ -0,0 +1,93 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_BREAKER_H
+#define GAIN_CAPITAL_BREAKER_H
+
+#include <chrono>       // for steady_clock, milliseconds
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint8_t, uint64_t
+#include <memory>       // for shared_ptr
+#include <optional>     // for optional
+#include <shared_mutex> // for shared_mutex
+#include <string>       // for basic_string
+#include <string_view>  // for string_view
+#include <unordered_map>// for unordered_map
+#include <vector>       // for vector
+
+#include "gain_capital_transport.h"// for NetworkResponse
+
+namespace gaincapital
+{
+
+struct GCBreakerPolicy
+{
+    std::chrono::milliseconds window {10'000};// rolling window the rates are measured over
+    std::size_t min_requests {20};// fewer completions in the window never trip the breaker
+    double failure_ratio {0.5};// transport errors, 429s and 5xxs; a caller's expired deadline is not a failure
+    std::chrono::milliseconds slow_call {2'000};// a slower response counts as slow whatever its status
+    double slow_call_ratio {0.8};
+    std::chrono::milliseconds open_duration {5'000};// requests fail fast for this long after a trip
+    std::size_t probes {3};// half-open requests that must all succeed to close the breaker
+};
+
+enum class GCBreakerState : std::uint8_t
+{
+    Closed,
+    Open,
+    HalfOpen
+};
+
+struct GCBreakerStats
+{
+    std::string endpoint;
+    GCBreakerState state {GCBreakerState::Closed};
+    std::uint64_t requests {};// completed within the window
+    std::uint64_t failures {};
+    std::uint64_t slow_calls {};
+    std::uint64_t trips {};
+    std::uint64_t rejected {};
+};
+
+class GCCircuitBreaker
+{
+    /*
+     * One breaker per endpoint, keyed on method and URL path with numeric segments and the query removed, so
+     * every market shares its endpoint's breaker. A closed breaker trips open once the failure or slow call
+     * rate over the window crosses its threshold. An open breaker rejects requests until open_duration has
+     * passed, then lets a few probes through: if they all succeed it closes, and one failure reopens it.
+     */
+  public:
+    struct Endpoint;
+
+    struct Permit
+    {
+        std::shared_ptr<Endpoint> endpoint;
+        std::chrono::steady_clock::time_point start;
+        std::uint64_t generation {};
+        bool probe {};
+    };
+
+    explicit GCCircuitBreaker(GCBreakerPolicy breaker_policy);
+
+    [[nodiscard]] std::optional<Permit> acquire(std::string_view type, std::string_view url);
+
+    void record(Permit const& permit, NetworkResponse const& response);
+
+    [[nodiscard]] std::vector<GCBreakerStats> stats() const;
+
+    [[nodiscard]] static std::string endpoint_key(std::string_view type, std::string_view url);
+
+  private:
+    GCBreakerPolicy policy;
+    std::chrono::steady_clock::duration bucket_width;
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Endpoint>> endpoints;
+
+    [[nodiscard]] std::shared_ptr<Endpoint> find_or_add(std::string key);
+};
+
+}// namespace gaincapital
+
+#endif
@@ -0,0 +1,61 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_CACHE_H
+#define GAIN_CAPITAL_CACHE_H
+
+#include <chrono>       // for milliseconds
+#include <cstddef>      // for size_t
+#include <optional>     // for optional
+#include <shared_mutex> // for shared_mutex
+#include <string>       // for basic_string
+#include <string_view>  // for string_view
+#include <unordered_map>// for unordered_map
+#include <utility>      // for pair
+#include <vector>       // for vector
+
+#include "cpr/cprtypes.h"// for Header
+#include "json/json.hpp" // for json
+
+namespace gaincapital
+{
+
+class GCResponseCache
+{
+    /*
+     * Opt-in TTL cache for idempotent GET responses. TTLs are configured per endpoint path
+     * and capped by the server's Cache-Control header; no-store and no-cache responses are never cached.
+     */
+  public:
+    explicit GCResponseCache(std::size_t capacity = 1024);
+
+    void set_ttl(std::string endpoint, std::chrono::milliseconds ttl);
+
+    [[nodiscard]] std::chrono::milliseconds ttl_for(std::string_view url) const;
+
+    [[nodiscard]] std::optional<nlohmann::json> lookup(std::string const& key) const;
+
+    void store(std::string const& key, nlohmann::json const& value, std::chrono::milliseconds ttl, cpr::Header const& response_header);
+
+    void clear();
+
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] static std::optional<std::chrono::milliseconds> server_max_age(cpr::Header const& response_header);
+
+  private:
+    struct Entry
+    {
+        nlohmann::json value;
+        std::chrono::steady_clock::time_point expires_at;
+    };
+
+    std::size_t max_entries;
+    mutable std::shared_mutex mutex;
+    std::vector<std::pair<std::string, std::chrono::milliseconds>> endpoint_ttls;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+}// namespace gaincapital
+
+#endif
@@ -4,26 +4,63 @@
 #ifndef GAIN_CAPITAL_CLIENT_H
 #define GAIN_CAPITAL_CLIENT_H
 
+#include <atomic>         // for atomic
+#include <chrono>         // for milliseconds
 #include <cstddef>        // for size_t
+#include <cstdint>        // for uint64_t
 #include <expected>       // for expected
+#include <functional>     // for function
+#include <memory>         // for shared_ptr
+#include <optional>       // for optional
+#include <shared_mutex>   // for shared_mutex
 #include <source_location>// for source_location...
+#include <span>           // for span
 #include <string>         // for basic_string
+#include <thread>         // for jthread
 #include <unordered_map>  // for unordered_map
+#include <utility>        // for pair
+#include <vector>         // for vector
 
 #include "cpr/cprtypes.h"// for Header
 #include "json/json.hpp" // for json_ref
 
-#include "gain_capital_exception.h"// for GCException
+#include "gain_capital_active_orders.h"// for GCActiveOrderTracker
+#include "gain_capital_breaker.h"      // for GCCircuitBreaker, GCBreakerPolicy, GCBreakerStats
+#include "gain_capital_cache.h"        // for GCResponseCache
+#include "gain_capital_deadline.h"     // for GCDeadline, GCDeadlineScope
+#include "gain_capital_exception.h"    // for GCException
+#include "gain_capital_hedge.h"        // for GCHedger, GCHedgePolicy
+#include "gain_capital_market_data.h"  // for GCPriceTick, GCPriceBar
+#include "gain_capital_market_spec.h"  // for GCMarketSpec
+#include "gain_capital_metrics.h"      // for GCMetrics
+#include "gain_capital_order.h"        // for MarketOrder, StopLimitOrder
+#include "gain_capital_order_manager.h"// for GCOrderManager
+#include "gain_capital_position_book.h"// for GCPositionBook
+#include "gain_capital_reactor.h"      // for GCReactor
+#include "gain_capital_risk.h"         // for GCRiskEngine
+#include "gain_capital_session.h"      // for GCSessionStore
+#include "gain_capital_single_flight.h"// for GCSingleFlight
+#include "gain_capital_transport.h"    // for GCTransport
 
 namespace gaincapital
 {
 
+using GCCallback = std::function<void(std::expected<nlohmann::json, GCException>)>;
+
+struct GCCancelResult
+{
+    std::string order_id;
+    std::expected<nlohmann::json, GCException> response;
+};
+
 class GCClient
 {
 
   public:
+    // Account IDs used for the next authentication; calls read them from the session snapshot (see get_session)
     std::string CLASS_trading_account_id;
     std::string CLASS_client_account_id;
+    // Guarded internally by market_id_mutex; do not modify while other threads use the client
     std::unordered_map<std::string, std::string> market_id_map;
 
     GCClient() = default;
@@ -32,14 +69,14 @@ class GCClient
 
     ~GCClient() = default;
 
-    // Move ONLY | No Copy Constructor
+    // No Copy or Move | The Keep Alive and Reconcile Threads Capture This Client; Hold It by Pointer to Transfer It
     GCClient(GCClient const& obj) = delete;
 
     GCClient& operator=(GCClient const& obj) = delete;
 
-    GCClient(GCClient&& obj) noexcept = default;
+    GCClient(GCClient&& obj) = delete;
 
-    GCClient& operator=(GCClient&& obj) noexcept = default;
+    GCClient& operator=(GCClient&& obj) = delete;
 
     // =================================================================================================================
     // AUTHENTICATION
@@ -49,6 +86,16 @@ class GCClient
 
     [[nodiscard]] std::expected<bool, GCException> validate_session();
 
+    [[nodiscard]] std::expected<bool, GCException> start_session_keep_alive(
+        std::chrono::milliseconds const validate_interval = std::chrono::seconds {60},
+        std::chrono::milliseconds const max_session_age   = std::chrono::milliseconds::zero());
+
+    void stop_session_keep_alive();
+
+    [[nodiscard]] std::expected<bool, GCException> start_position_reconcile(std::chrono::milliseconds const interval = std::chrono::seconds {30});
+
+    void stop_position_reconcile();
+
     // =================================================================================================================
     // API CALLS
     // =================================================================================================================
@@ -61,6 +108,8 @@ class GCClient
 
     [[nodiscard]] std::expected<nlohmann::json, GCException> get_market_info(std::string const& market_name);
 
+    [[nodiscard]] std::expected<std::size_t, GCException> load_market_specs(std::vector<std::string> const& market_names);
+
     [[nodiscard]] std::expected<nlohmann::json, GCException> get_prices(std::string const& market_name, std::size_t const num_ticks = 1,
                                                                         std::size_t const from_ts = 0, std::size_t const to_ts = 0,
                                                                         std::string price_type = "MID");
@@ -69,14 +118,54 @@ class GCClient
                                                                       std::size_t const num_ticks = 1, std::size_t span = 1,
                                                                       std::size_t const from_ts = 0, std::size_t const to_ts = 0);
 
+    [[nodiscard]] std::expected<std::vector<GCPriceTick>, GCException> get_tick_history(std::string const& market_name,
+                                                                                        std::size_t const num_ticks = 1,
+                                                                                        std::size_t const from_ts = 0, std::size_t const to_ts = 0,
+                                                                                        std::string price_type = "MID");
+
+    [[nodiscard]] std::expected<std::vector<GCPriceBar>, GCException> get_bar_history(std::string const& market_name, std::string interval,
+                                                                                      std::size_t const num_ticks = 1, std::size_t span = 1,
+                                                                                      std::size_t const from_ts = 0, std::size_t const to_ts = 0);
+
     [[nodiscard]] std::expected<nlohmann::json, GCException> trade_order(nlohmann::json& trade_map, std::string type, std::string tr_account_id = "");
 
+    [[nodiscard]] std::expected<nlohmann::json, GCException> trade_order(MarketOrder const& order, std::string tr_account_id = "");
+
+    [[nodiscard]] std::expected<nlohmann::json, GCException> trade_order(StopLimitOrder const& order, std::string tr_account_id = "");
+
+    [[nodiscard]] std::expected<nlohmann::json, GCException> amend_order(std::string const& order_id, StopLimitOrder const& order,
+                                                                         std::string tr_account_id = "");
+
     [[nodiscard]] std::expected<nlohmann::json, GCException> list_open_positions(std::string tr_account_id = "");
 
     [[nodiscard]] std::expected<nlohmann::json, GCException> list_active_orders(std::string tr_account_id = "");
 
+    [[nodiscard]] std::expected<GCActiveOrdersDelta, GCException> list_active_orders_delta(std::string tr_account_id = "");
+
     [[nodiscard]] std::expected<nlohmann::json, GCException> cancel_order(std::string const& order_id, std::string tr_account_id = "");
 
+    [[nodiscard]] std::expected<std::vector<GCCancelResult>, GCException> cancel_orders(std::span<std::string const> order_ids,
+                                                                                        std::string tr_account_id       = "",
+                                                                                        std::size_t const max_in_flight = 8);
+
+    [[nodiscard]] std::expected<std::vector<GCCancelResult>, GCException> cancel_all(std::string const& market_name   = "",
+                                                                                     std::string tr_account_id       = "",
+                                                                                     std::size_t const max_in_flight = 8);
+
+    [[nodiscard]] std::expected<bool, GCException> reconcile_orders(std::string tr_account_id = "");
+
+    [[nodiscard]] std::expected<std::size_t, GCException> reconcile_positions(std::string tr_account_id = "");
+
+    // =================================================================================================================
+    // ASYNC API CALLS
+    // =================================================================================================================
+
+    void get_prices_async(GCCallback callback, std::string const& market_name, std::size_t const num_ticks = 1, std::size_t const from_ts = 0,
+                          std::size_t const to_ts = 0, std::string price_type = "MID");
+
+    void get_ohlc_async(GCCallback callback, std::string const& market_name, std::string interval, std::size_t const num_ticks = 1,
+                        std::size_t span = 1, std::size_t const from_ts = 0, std::size_t const to_ts = 0);
+
     // =================================================================================================================
     // UTILITIES
     // =================================================================================================================
@@ -87,18 +176,77 @@ class GCClient
 
     [[nodiscard]] std::expected<bool, GCException> validate_auth_payload() const;
 
+    [[nodiscard]] std::shared_ptr<GCSession const> get_session() const;
+
+    void set_request_coalescing(bool const enabled);
+
+    void set_hedging(bool const enabled, GCHedgePolicy policy = {});
+
+    void set_request_timeout(std::chrono::milliseconds const timeout);
+
+    void set_circuit_breaker(bool const enabled, GCBreakerPolicy policy = {});
+
+    [[nodiscard]] std::vector<GCBreakerStats> get_circuit_breaker_stats() const;
+
+    void set_cache_ttl(std::string const& endpoint, std::chrono::milliseconds const ttl);
+
+    void clear_response_cache();
+
+    void set_active_orders_page_size(std::size_t const page_size);
+
+    void set_risk_limits(GCRiskLimits const& limits);
+
+    [[nodiscard]] std::expected<bool, GCException> set_market_risk_limits(std::string const& market_name, GCRiskLimits const& limits);
+
+    void add_risk_rule(GCRiskRule rule);
+
+    [[nodiscard]] std::optional<GCMarketSpec> get_market_spec(std::string const& market_name) const;
+
+    [[nodiscard]] GCOrderManager const& get_order_manager() const;
+
+    [[nodiscard]] GCPositionBook const& get_position_book() const;
+
+    [[nodiscard]] GCMetricsSnapshot get_metrics() const;
+
+    void set_transport(std::shared_ptr<GCTransport> new_transport);
+
+    [[nodiscard]] std::shared_ptr<GCTransport> get_transport() const;
+
     void set_testing_rest_urls(std::string const& url);
 
   private:
     std::string rest_url_v2 = "https://ciapi.cityindex.com/v2";
     std::string rest_url = "https://ciapi.cityindex.com/TradingAPI";
-    cpr::Header session_header;
     nlohmann::json auth_payload, session_payload;
+    std::atomic<std::shared_ptr<GCTransport>> transport {std::make_shared<GCReactor>()};
+    std::shared_ptr<GCSessionStore> session_store             = std::make_shared<GCSessionStore>();
+    std::unique_ptr<std::shared_mutex> market_id_mutex        = std::make_unique<std::shared_mutex>();
+    std::shared_ptr<GCSingleFlight<GCCallback>> single_flight = std::make_shared<GCSingleFlight<GCCallback>>();
+    std::shared_ptr<GCResponseCache> response_cache           = std::make_shared<GCResponseCache>();
+    std::shared_ptr<GCMetrics> metrics                        = std::make_shared<GCMetrics>();
+    std::shared_ptr<GCPositionBook> position_book             = std::make_shared<GCPositionBook>();
+    std::shared_ptr<GCOrderManager> order_manager             = make_order_manager(position_book);
+    std::shared_ptr<GCRiskEngine> risk_engine                 = std::make_shared<GCRiskEngine>(position_book);
+    std::shared_ptr<GCActiveOrderTracker> active_orders       = std::make_shared<GCActiveOrderTracker>();
+    std::shared_ptr<GCMarketSpecStore> market_specs           = std::make_shared<GCMarketSpecStore>();
+    std::atomic<std::shared_ptr<GCHedger>> hedger;
+    std::atomic<std::shared_ptr<GCCircuitBreaker>> breaker;
+    std::atomic<bool> coalesce_requests {true};
+    std::atomic<std::chrono::milliseconds> request_timeout {std::chrono::seconds {30}};
+    // Declared Last | Joined Before the Transport and Session Store Are Destroyed
+    std::jthread keep_alive_thread;
+    std::jthread position_reconcile_thread;
 
     // =================================================================================================================
     // AUTHENTICATION
     // =================================================================================================================
 
+    [[nodiscard]] std::expected<bool, GCException> reauthenticate_session(std::uint64_t const stale_generation);
+
+    [[nodiscard]] std::expected<bool, GCException> check_session();
+
+    [[nodiscard]] std::expected<bool, GCException> log_on(std::source_location const& location);
+
     [[nodiscard]] std::expected<bool, GCException> set_trading_account_id();
 
     // =================================================================================================================
@@ -108,6 +256,41 @@ class GCClient
     [[nodiscard]] std::expected<nlohmann::json, GCException> make_network_call(
         cpr::Header const& header, cpr::Url const& url, std::string const& payload, std::string const& type,
         std::source_location const& location = std::source_location::current());
+
+    [[nodiscard]] std::expected<NetworkResponse, GCException> make_raw_network_call(
+        cpr::Header const& header, cpr::Url const& url, std::string const& payload, std::string const& type,
+        std::source_location const& location = std::source_location::current());
+
+    void make_network_call_async(cpr::Header const& header, cpr::Url const& url, std::string const& payload, std::string const& type,
+                                 GCCallback callback, std::source_location const& location = std::source_location::current());
+
+    void submit_request(NetworkRequest request, NetworkCallback callback);
+
+    [[nodiscard]] GCDeadline request_deadline() const noexcept;
+
+    [[nodiscard]] std::expected<nlohmann::json, GCException> place_order(GCOrderTemplate& order_template, std::string const& market_name,
+                                                                         std::uint64_t const client_order_id, std::source_location const& location);
+
+    [[nodiscard]] std::vector<std::expected<nlohmann::json, GCException>> make_network_calls(
+        cpr::Header const& header, std::vector<std::pair<cpr::Url, std::string>> const& requests, std::string const& type,
+        std::size_t const max_in_flight, std::source_location const& location);
+
+    [[nodiscard]] std::vector<GCCancelResult> dispatch_cancels(std::shared_ptr<GCSession const> const& session,
+                                                               std::span<std::string const> order_ids, std::string const& tr_account_id,
+                                                               std::size_t const max_in_flight, std::source_location const& location);
+
+    [[nodiscard]] static std::shared_ptr<GCOrderManager> make_order_manager(std::shared_ptr<GCPositionBook> const& position_book);
+
+    [[nodiscard]] static std::expected<nlohmann::json, GCException> parse_network_response(NetworkResponse const& resp,
+                                                                                           std::source_location const& location);
+
+    [[nodiscard]] std::expected<cpr::Url, GCException> build_prices_url(std::string const& market_name, std::size_t const num_ticks,
+                                                                       std::size_t const from_ts, std::size_t const to_ts, std::string price_type,
+                                                                       std::source_location const& location);
+
+    [[nodiscard]] std::expected<cpr::Url, GCException> build_ohlc_url(std::string const& market_name, std::string interval,
+                                                                     std::size_t const num_ticks, std::size_t span, std::size_t const from_ts,
+                                                                     std::size_t const to_ts, std::source_location const& location);
 };
 
 }// namespace gaincapital
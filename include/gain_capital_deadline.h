@@ -0,0 +1,47 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_DEADLINE_H
+#define GAIN_CAPITAL_DEADLINE_H
+
+#include <chrono>// for steady_clock, milliseconds
+
+namespace gaincapital
+{
+
+using GCDeadline = std::chrono::steady_clock::time_point;
+
+constexpr GCDeadline NO_DEADLINE = GCDeadline::max();
+
+class GCDeadlineScope
+{
+    /*
+     * Bounds every client call made on this thread while the scope is alive, including the calls a method makes
+     * internally and its retries. A nested scope can only shorten the deadline. Async calls take the deadline in
+     * force when they are issued.
+     */
+  public:
+    explicit GCDeadlineScope(std::chrono::milliseconds const budget);
+
+    explicit GCDeadlineScope(GCDeadline const deadline);
+
+    ~GCDeadlineScope();
+
+    // No Copy or Move | Restores the Enclosing Deadline on Destruction
+    GCDeadlineScope(GCDeadlineScope const& obj) = delete;
+
+    GCDeadlineScope& operator=(GCDeadlineScope const& obj) = delete;
+
+    GCDeadlineScope(GCDeadlineScope&& obj) = delete;
+
+    GCDeadlineScope& operator=(GCDeadlineScope&& obj) = delete;
+
+    [[nodiscard]] static GCDeadline current() noexcept;
+
+  private:
+    GCDeadline enclosing;
+};
+
+}// namespace gaincapital
+
+#endif
@@ -4,25 +4,36 @@
 #ifndef GAIN_CAPITAL_EXCEPTION_H
 #define GAIN_CAPITAL_EXCEPTION_H
 
+#include <cstdint>  // for uint8_t
 #include <stdexcept>// for runtime_error
 #include <string>   // for basic_string
 
 namespace gaincapital
 {
 
+enum class GCErrorCode : std::uint8_t
+{
+    Unspecified,
+    DeadlineExceeded,
+    CircuitOpen
+};
+
 class GCException : public std::runtime_error
 {
   public:
     std::string message;
     std::string func_name;
+    GCErrorCode error_code {GCErrorCode::Unspecified};
 
     GCException() = delete;
 
-    GCException(std::string func_name, std::string const& message);
+    GCException(std::string func_name, std::string const& message, GCErrorCode const code = GCErrorCode::Unspecified);
 
     [[nodiscard]] char const* what() const noexcept override;
 
     [[nodiscard]] char const* where() const noexcept;
+
+    [[nodiscard]] GCErrorCode code() const noexcept;
 };
 
 }// namespace gaincapital
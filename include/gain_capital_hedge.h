@@ -0,0 +1,93 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_HEDGE_H
+#define GAIN_CAPITAL_HEDGE_H
+
+#include <chrono>            // for steady_clock, microseconds, milliseconds
+#include <condition_variable>// for condition_variable
+#include <cstdint>           // for uint64_t
+#include <map>               // for multimap
+#include <memory>            // for shared_ptr
+#include <mutex>             // for mutex
+#include <string>            // for basic_string
+#include <thread>            // for thread
+#include <vector>            // for vector
+
+#include "gain_capital_transport.h"// for GCTransport, NetworkRequest, NetworkCallback
+
+namespace gaincapital
+{
+
+struct GCHedgePolicy
+{
+    double percentile {0.95};// of recent read latencies, used as the hedge delay
+    std::chrono::milliseconds min_delay {2};
+    std::chrono::milliseconds max_delay {500};// also the delay until enough latencies are known
+    double max_hedge_fraction {0.1};// hedges sent never exceed this share of hedgeable reads
+    double holdout_fraction {0.05};// reads never hedged, the baseline the p99 improvement is measured against
+    std::vector<std::string> endpoints {"/tickhistory", "/barhistory", "/cfd/markets"};
+};
+
+struct GCHedgeStats
+{
+    std::uint64_t hedgeable_reads {};
+    std::uint64_t hedges_sent {};
+    std::uint64_t hedge_wins {};
+    double hedged_read_p99_us {};// reads eligible for a hedge, as the caller saw them
+    double unhedged_read_p99_us {};// the holdout reads
+};
+
+class GCHedger
+{
+    /*
+     * Hedges idempotent GETs. A read on a hedged endpoint with no response after the delay is sent again, and the
+     * transport carries the copy on another pooled connection. The first response wins and the other request is
+     * cancelled; a transport failure on one is ignored while the other is still in flight. The delay tracks a
+     * percentile of recent read latencies, and hedges are capped at a share of reads so a slow server is not
+     * met with double the load. Hedge timers run on a thread owned by the hedger.
+     */
+  public:
+    explicit GCHedger(GCHedgePolicy policy);
+
+    ~GCHedger();
+
+    // No Copy or Move | Owns the Timer Thread
+    GCHedger(GCHedger const& obj) = delete;
+
+    GCHedger& operator=(GCHedger const& obj) = delete;
+
+    GCHedger(GCHedger&& obj) = delete;
+
+    GCHedger& operator=(GCHedger&& obj) = delete;
+
+    [[nodiscard]] bool hedges(NetworkRequest const& request) const noexcept;
+
+    void submit(std::shared_ptr<GCTransport> const& transport, NetworkRequest request, NetworkCallback callback);
+
+    [[nodiscard]] std::chrono::microseconds hedge_delay() const;
+
+    [[nodiscard]] GCHedgeStats stats() const;
+
+  private:
+    struct Race;
+    struct Statistics;// Shared With Callbacks in Flight, Which May Outlive the Hedger
+
+    std::shared_ptr<Statistics> statistics;
+
+    std::mutex timer_mutex;
+    std::condition_variable timer_ready;
+    std::multimap<std::chrono::steady_clock::time_point, std::shared_ptr<Race>> timers;
+    bool stopping {false};
+    std::thread timer_thread;
+
+    void run();
+
+    static void send_hedge(std::shared_ptr<Race> const& race);
+
+    static void complete(std::shared_ptr<Race> const& race, bool const from_hedge, NetworkResponse&& response);
+};
+
+}// namespace gaincapital
+
+#endif
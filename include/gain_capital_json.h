@@ -0,0 +1,18 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_JSON_H
+#define GAIN_CAPITAL_JSON_H
+
+#include <optional>// for optional
+
+#include "json/json.hpp"// for json
+
+namespace gaincapital
+{
+
+[[nodiscard]] std::optional<double> read_number(nlohmann::json const& object, char const* key);
+
+}// namespace gaincapital
+
+#endif
@@ -0,0 +1,51 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_MARKET_DATA_H
+#define GAIN_CAPITAL_MARKET_DATA_H
+
+#include <cstdint>        // for int64_t, uint8_t
+#include <expected>       // for expected
+#include <source_location>// for source_location
+#include <string_view>    // for string_view
+#include <vector>         // for vector
+
+#include "gain_capital_exception.h"// for GCException
+#include "gain_capital_price.h"    // for GCPrice
+
+namespace gaincapital
+{
+
+struct GCPriceTick
+{
+    std::int64_t timestamp_ms {};
+    GCPrice price;
+};
+
+struct GCPriceBar
+{
+    std::int64_t timestamp_ms {};
+    GCPrice open;
+    GCPrice high;
+    GCPrice low;
+    GCPrice close;
+};
+
+/*
+ * Decode tickhistory / barhistory response bodies into flat vectors, with prices fixed at the market's decimals.
+ * The intermediate JSON tree lives in the calling thread's GCArena and is discarded before returning.
+ */
+[[nodiscard]] std::expected<std::vector<GCPriceTick>, GCException> parse_price_ticks(
+    std::string_view text, std::uint8_t const decimals = GCPrice::DEFAULT_DECIMALS,
+    std::source_location const& location = std::source_location::current());
+
+[[nodiscard]] std::expected<std::vector<GCPriceBar>, GCException> parse_price_bars(
+    std::string_view text, std::uint8_t const decimals = GCPrice::DEFAULT_DECIMALS,
+    std::source_location const& location = std::source_location::current());
+
+[[nodiscard]] std::expected<std::int64_t, GCException> parse_wcf_date(std::string_view date,
+                                                                      std::source_location const& location = std::source_location::current());
+
+}// namespace gaincapital
+
+#endif
@@ -0,0 +1,81 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_MARKET_SPEC_H
+#define GAIN_CAPITAL_MARKET_SPEC_H
+
+#include <atomic>       // for atomic
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t, uint8_t
+#include <functional>   // for hash, equal_to
+#include <memory>       // for shared_ptr
+#include <mutex>        // for mutex
+#include <optional>     // for optional
+#include <string>       // for basic_string
+#include <string_view>  // for string_view
+#include <unordered_map>// for unordered_map
+#include <utility>      // for pair
+#include <vector>       // for vector
+
+#include "json/json.hpp"// for json
+
+namespace gaincapital
+{
+
+struct GCMarketSpec
+{
+    std::int64_t market_id {};
+    double min_quantity {};
+    double max_long_quantity {};
+    double max_short_quantity {};
+    double quantity_increment {};
+    double bet_per {};
+    double margin_factor {};
+    std::uint8_t price_decimals {};
+
+    [[nodiscard]] double round_price(double const price) const noexcept;
+
+    [[nodiscard]] std::optional<std::string_view> check_quantity(double const signed_quantity) const noexcept;
+};
+
+/*
+ * Reads a /market/{id}/information response. Quantity limits the server omits are left at zero, meaning unchecked.
+ */
+[[nodiscard]] std::optional<GCMarketSpec> parse_market_spec(nlohmann::json const& market_information);
+
+class GCMarketSpecStore
+{
+    /*
+     * RCU-style holder for market specs. Readers look up an immutable snapshot without locking; writers
+     * serialize on the writer mutex and publish a merged copy.
+     */
+  public:
+    GCMarketSpecStore() = default;
+
+    [[nodiscard]] std::optional<GCMarketSpec> find(std::string_view market_name) const;
+
+    [[nodiscard]] std::optional<GCMarketSpec> find(std::int64_t const market_id) const;
+
+    void publish(std::vector<std::pair<std::string, GCMarketSpec>> const& specs);
+
+  private:
+    struct NameHash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view> {}(name); }
+    };
+
+    struct Snapshot
+    {
+        std::unordered_map<std::string, GCMarketSpec, NameHash, std::equal_to<>> by_name;
+        std::unordered_map<std::int64_t, GCMarketSpec> by_id;
+    };
+
+    std::atomic<std::shared_ptr<Snapshot const>> current {std::make_shared<Snapshot const>()};
+    std::mutex writer;
+};
+
+}// namespace gaincapital
+
+#endif
@@ -0,0 +1,62 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_METRICS_H
+#define GAIN_CAPITAL_METRICS_H
+
+#include <atomic> // for atomic
+#include <cstdint>// for uint64_t
+
+namespace gaincapital
+{
+
+struct GCMetricsSnapshot
+{
+    std::uint64_t requests_sent {};
+    std::uint64_t requests_failed {};
+    std::uint64_t requests_coalesced {};
+    std::uint64_t cache_hits {};
+    std::uint64_t cache_misses {};
+    std::uint64_t hedgeable_reads {};
+    std::uint64_t hedges_sent {};
+    std::uint64_t hedge_wins {};
+    double hedged_read_p99_us {};
+    double unhedged_read_p99_us {};// holdout reads, never hedged
+    std::uint64_t circuit_trips {};
+    std::uint64_t circuit_rejections {};// also counted in requests_sent and requests_failed
+
+    [[nodiscard]] double cache_hit_rate() const noexcept;
+
+    [[nodiscard]] double hedge_rate() const noexcept;
+
+    [[nodiscard]] double hedge_p99_improvement_us() const noexcept;
+};
+
+class GCMetrics
+{
+    /*
+     * Lock-free counters updated on the request path; read through snapshot().
+     */
+  public:
+    GCMetrics() = default;
+
+    void record_request() noexcept;
+
+    void record_failure() noexcept;
+
+    void record_cache_hit() noexcept;
+
+    void record_cache_miss() noexcept;
+
+    [[nodiscard]] GCMetricsSnapshot snapshot() const noexcept;
+
+  private:
+    std::atomic<std::uint64_t> requests_sent {0};
+    std::atomic<std::uint64_t> requests_failed {0};
+    std::atomic<std::uint64_t> cache_hits {0};
+    std::atomic<std::uint64_t> cache_misses {0};
+};
+
+}// namespace gaincapital
+
+#endif
@@ -0,0 +1,90 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_ORDER_H
+#define GAIN_CAPITAL_ORDER_H
+
+#include <cstdint>    // for uint8_t, int64_t
+#include <optional>   // for optional
+#include <string>     // for basic_string
+#include <string_view>// for string_view
+#include <utility>    // for pair
+#include <vector>     // for vector
+
+#include "json/json.hpp"// for json
+
+#include "gain_capital_price.h"// for GCPrice
+
+namespace gaincapital
+{
+
+struct MarketOrder
+{
+    std::string market_name;
+    std::string direction;
+    double quantity {};
+};
+
+struct StopLimitOrder
+{
+    std::string market_name;
+    std::string direction;
+    double quantity {};
+    GCPrice trigger_price;
+    std::optional<GCPrice> stop_price;
+    std::optional<GCPrice> limit_price;
+
+    StopLimitOrder() = default;
+
+    StopLimitOrder(std::string market, std::string side, double const order_quantity, GCPrice const trigger,
+                   std::optional<GCPrice> const stop = std::nullopt, std::optional<GCPrice> const limit = std::nullopt);
+
+    // Prices Given as Doubles Are Held at the Default Decimals Until the Order Is Conformed to Its Market's Spec
+    StopLimitOrder(std::string market, std::string side, double const order_quantity, double const trigger,
+                   std::optional<double> const stop = std::nullopt, std::optional<double> const limit = std::nullopt);
+};
+
+class GCOrderTemplate
+{
+    /*
+     * Order payload serialized once with its static fields in place. Each attempt only writes
+     * BidPrice, OfferPrice and Quantity into the gaps, reusing the same output buffer.
+     */
+  public:
+    GCOrderTemplate(MarketOrder const& order, std::string const& market_id, std::string const& trading_account_id,
+                    std::string const& reference = "");
+
+    GCOrderTemplate(StopLimitOrder const& order, std::string const& market_id, std::string const& trading_account_id,
+                    std::string const& reference = "");
+
+    [[nodiscard]] static GCOrderTemplate amend(StopLimitOrder const& order, std::string const& market_id, std::string const& trading_account_id,
+                                               std::int64_t const order_id);
+
+    [[nodiscard]] std::string const& render(GCPrice const bid_price, GCPrice const offer_price);
+
+    [[nodiscard]] std::string const& render(GCPrice const bid_price, GCPrice const offer_price, double const quantity);
+
+    [[nodiscard]] std::string_view endpoint() const noexcept;
+
+  private:
+    enum class Slot : std::uint8_t
+    {
+        BidPrice,
+        OfferPrice,
+        Quantity
+    };
+
+    std::vector<std::pair<std::string, Slot>> segments;
+    std::string tail;
+    std::string buffer;
+    std::string_view path;
+    double default_quantity {};
+
+    GCOrderTemplate(std::string_view const endpoint_path, double const quantity);
+
+    void compile(nlohmann::json payload, std::string const& reference);
+};
+
+}// namespace gaincapital
+
+#endif
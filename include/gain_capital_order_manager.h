@@ -0,0 +1,122 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_ORDER_MANAGER_H
+#define GAIN_CAPITAL_ORDER_MANAGER_H
+
+#include <chrono>       // for steady_clock
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t, int64_t
+#include <functional>   // for function
+#include <mutex>        // for mutex
+#include <optional>     // for optional
+#include <string>       // for basic_string
+#include <string_view>  // for string_view
+#include <unordered_map>// for unordered_map
+#include <unordered_set>// for unordered_set
+#include <vector>       // for vector
+
+#include "json/json.hpp"// for json
+
+namespace gaincapital
+{
+
+enum class GCOrderState : std::uint8_t
+{
+    Pending,
+    Acked,
+    Working,
+    Closed,// left the active list without a cancel from this client; filled or expired, not yet confirmed
+    Unknown,// sent, but the reply was lost; settled by the active orders or the open positions
+    Filled,
+    Cancelled,
+    Rejected
+};
+
+struct GCOrderRecord
+{
+    std::uint64_t client_order_id {};
+    std::int64_t order_id {};
+    std::int64_t market_id {};
+    double signed_quantity {};
+    double price {};
+    std::chrono::steady_clock::time_point updated_at {};
+    std::uint16_t attempts {};
+    GCOrderState state {GCOrderState::Pending};
+    bool resting {};
+    bool cancel_requested {};
+};
+
+using GCFillListener = std::function<void(GCOrderRecord const&)>;
+
+class GCOrderManager
+{
+    /*
+     * Local order table. Every order gets a client order ID that is sent as its Reference, so a retry after an
+     * ambiguous failure can first look for the order on the server instead of placing a duplicate.
+     * Records live in a flat vector indexed by client order ID; server order IDs map back into it.
+     * Reconcile passes only walk the records not yet filled, cancelled or rejected.
+     */
+  public:
+    explicit GCOrderManager(std::string reference_prefix = default_prefix());
+
+    [[nodiscard]] std::uint64_t create(std::int64_t const market_id, double const signed_quantity, bool const resting, double const price = 0);
+
+    [[nodiscard]] std::string reference(std::uint64_t const client_order_id) const;
+
+    [[nodiscard]] std::optional<std::uint64_t> parse_reference(std::string_view reference) const;
+
+    void record_attempt(std::uint64_t const client_order_id, double const bid_price, double const offer_price);
+
+    void acknowledge(std::uint64_t const client_order_id, std::int64_t const order_id);
+
+    void reject(std::uint64_t const client_order_id);
+
+    void mark_unknown(std::uint64_t const client_order_id);
+
+    void request_cancel(std::int64_t const order_id);
+
+    void withdraw_cancel(std::int64_t const order_id);
+
+    void amend(std::int64_t const order_id, double const signed_quantity, double const price);
+
+    [[nodiscard]] std::optional<std::size_t> reconcile(nlohmann::json const& active_orders);
+
+    [[nodiscard]] std::size_t confirm_fills(std::int64_t const market_id, double const quantity_change);
+
+    [[nodiscard]] std::optional<std::int64_t> find_on_server(nlohmann::json const& active_orders, std::uint64_t const client_order_id) const;
+
+    [[nodiscard]] std::optional<GCOrderRecord> find(std::uint64_t const client_order_id) const;
+
+    [[nodiscard]] std::optional<GCOrderRecord> find_by_order_id(std::int64_t const order_id) const;
+
+    [[nodiscard]] std::vector<GCOrderRecord> snapshot() const;
+
+    void set_fill_listener(GCFillListener listener);
+
+    [[nodiscard]] static std::string default_prefix();
+
+  private:
+    struct ActiveOrder
+    {
+        std::int64_t order_id {};
+        std::string reference;
+    };
+
+    std::string prefix;
+    mutable std::mutex mutex;
+    std::vector<GCOrderRecord> records;
+    std::unordered_map<std::int64_t, std::size_t> order_index;
+    std::vector<std::size_t> open_records;
+    GCFillListener fill_listener;
+
+    [[nodiscard]] GCOrderRecord* lookup(std::uint64_t const client_order_id);
+
+    void prune_open_records();
+
+    [[nodiscard]] static std::optional<std::vector<ActiveOrder>> read_active_orders(nlohmann::json const& active_orders);
+};
+
+}// namespace gaincapital
+
+#endif
@@ -0,0 +1,63 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_POSITION_BOOK_H
+#define GAIN_CAPITAL_POSITION_BOOK_H
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t, uint64_t
+#include <functional>   // for function
+#include <optional>     // for optional
+#include <shared_mutex> // for shared_mutex
+#include <unordered_map>// for unordered_map
+#include <vector>       // for vector
+
+#include "json/json.hpp"// for json
+
+namespace gaincapital
+{
+
+struct GCPosition
+{
+    std::int64_t market_id {};
+    double net_quantity {};
+    double average_price {};
+};
+
+using GCCorrectionListener = std::function<void(std::int64_t const market_id, double const quantity_change)>;
+
+class GCPositionBook
+{
+    /*
+     * Net position per market ID, updated from local fills and corrected by reconciling against open positions.
+     * Exposure reads take a shared lock and a single hash lookup.
+     */
+  public:
+    GCPositionBook() = default;
+
+    void apply_fill(std::int64_t const market_id, double const signed_quantity, double const price);
+
+    [[nodiscard]] double exposure(std::int64_t const market_id) const;
+
+    [[nodiscard]] std::optional<GCPosition> position(std::int64_t const market_id) const;
+
+    [[nodiscard]] std::vector<GCPosition> snapshot() const;
+
+    [[nodiscard]] std::uint64_t fill_sequence() const;
+
+    [[nodiscard]] std::optional<std::size_t> reconcile(nlohmann::json const& open_positions,
+                                                       std::optional<std::uint64_t> const fill_stamp = std::nullopt);
+
+    void set_correction_listener(GCCorrectionListener listener);
+
+  private:
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::int64_t, GCPosition> positions;
+    std::unordered_map<std::int64_t, std::uint64_t> last_fill;// fill sequence of each market's latest local fill
+    std::uint64_t fills {};
+    GCCorrectionListener correction_listener;
+};
+
+}// namespace gaincapital
+
+#endif
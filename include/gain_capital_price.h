@@ -0,0 +1,68 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_PRICE_H
+#define GAIN_CAPITAL_PRICE_H
+
+#include <compare>    // for strong_ordering
+#include <cstdint>    // for int64_t, uint8_t
+#include <optional>   // for optional
+#include <string>     // for basic_string
+#include <string_view>// for string_view
+
+namespace gaincapital
+{
+
+class GCPrice
+{
+    /*
+     * Fixed-point price held as an int64 count of 10^-decimals units, where decimals is the market's
+     * quoted precision. Comparisons and arithmetic stay in integers; text is produced only at the wire.
+     */
+  public:
+    static constexpr std::uint8_t DEFAULT_DECIMALS = 6;
+
+    static constexpr std::uint8_t MAX_DECIMALS = 18;
+
+    constexpr GCPrice() noexcept = default;
+
+    explicit GCPrice(double const value, std::uint8_t const decimals = DEFAULT_DECIMALS) noexcept;
+
+    [[nodiscard]] static GCPrice from_units(std::int64_t const units, std::uint8_t const decimals) noexcept;
+
+    [[nodiscard]] static std::optional<GCPrice> parse(std::string_view text, std::uint8_t const decimals = DEFAULT_DECIMALS) noexcept;
+
+    [[nodiscard]] std::int64_t units() const noexcept { return price_units; }
+
+    [[nodiscard]] std::uint8_t decimals() const noexcept { return price_decimals; }
+
+    [[nodiscard]] GCPrice rescale(std::uint8_t const decimals) const noexcept;
+
+    [[nodiscard]] double to_double() const noexcept;
+
+    void append_to(std::string& buffer) const;
+
+    [[nodiscard]] std::string to_string() const;
+
+    [[nodiscard]] GCPrice operator+(GCPrice const& other) const noexcept;
+
+    [[nodiscard]] GCPrice operator-(GCPrice const& other) const noexcept;
+
+    [[nodiscard]] GCPrice operator*(std::int64_t const factor) const noexcept;
+
+    GCPrice& operator+=(GCPrice const& other) noexcept;
+
+    GCPrice& operator-=(GCPrice const& other) noexcept;
+
+    [[nodiscard]] bool operator==(GCPrice const& other) const noexcept;
+
+    [[nodiscard]] std::strong_ordering operator<=>(GCPrice const& other) const noexcept;
+
+  private:
+    std::int64_t price_units {};
+    std::uint8_t price_decimals {DEFAULT_DECIMALS};
+};
+
+}// namespace gaincapital
+
+#endif
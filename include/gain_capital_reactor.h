@@ -0,0 +1,90 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_REACTOR_H
+#define GAIN_CAPITAL_REACTOR_H
+
+#include <atomic>       // for atomic
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint64_t
+#include <deque>        // for deque
+#include <memory>       // for unique_ptr
+#include <mutex>        // for mutex
+#include <thread>       // for thread
+#include <unordered_map>// for unordered_map
+#include <vector>       // for vector
+
+#include "gain_capital_transport.h"// for GCTransport, NetworkRequest, NetworkCallback
+
+namespace gaincapital
+{
+
+class GCReactor final : public GCTransport
+{
+    /*
+     * Drives every in-flight HTTP transfer through a single curl_multi handle on one epoll thread.
+     * Callbacks are invoked on the reactor thread and must not block.
+     */
+  public:
+    // Throws GCException if the epoll instance, eventfd or curl multi handle cannot be created
+    GCReactor();
+
+    ~GCReactor() override;
+
+    // No Copy or Move | Owned Through Pointer
+    GCReactor(GCReactor const& obj) = delete;
+
+    GCReactor& operator=(GCReactor const& obj) = delete;
+
+    GCReactor(GCReactor&& obj) = delete;
+
+    GCReactor& operator=(GCReactor&& obj) = delete;
+
+    std::uint64_t submit(NetworkRequest request, NetworkCallback callback) override;
+
+    void cancel(std::uint64_t const id) override;
+
+    [[nodiscard]] std::size_t in_flight() const noexcept override;
+
+  private:
+    struct Transfer;
+
+    void* multi_handle {};
+    int epoll_fd {-1};
+    int wake_fd {-1};
+    long long timer_deadline_ms {-1};
+    std::atomic<bool> stopping {false};
+    std::atomic<std::size_t> in_flight_count {0};
+    std::atomic<std::uint64_t> next_id {1};
+
+    std::mutex submit_mutex;
+    std::deque<std::unique_ptr<Transfer>> submit_queue;
+    std::vector<std::uint64_t> cancel_queue;
+    std::unordered_map<std::uint64_t, std::unique_ptr<Transfer>> active_transfers;
+
+    std::thread reactor_thread;
+
+    void run();
+
+    void wake() const noexcept;
+
+    void drain_submissions();
+
+    void drain_cancellations();
+
+    void check_completed();
+
+    void finish(std::unique_ptr<Transfer> transfer);
+
+    void abort_all();
+
+    void release_handles() noexcept;
+
+    static int socket_callback(void* easy, int socket, int what, void* userp, void* socketp);
+
+    static int timer_callback(void* multi, long timeout_ms, void* userp);
+};
+
+}// namespace gaincapital
+
+#endif
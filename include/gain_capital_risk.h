@@ -0,0 +1,89 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_RISK_H
+#define GAIN_CAPITAL_RISK_H
+
+#include <chrono>       // for steady_clock
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t, uint8_t
+#include <functional>   // for function
+#include <memory>       // for shared_ptr
+#include <mutex>        // for mutex
+#include <shared_mutex> // for shared_mutex
+#include <string_view>  // for string_view
+#include <unordered_map>// for unordered_map
+#include <vector>       // for vector
+
+#include "gain_capital_position_book.h"// for GCPositionBook
+
+namespace gaincapital
+{
+
+struct GCRiskLimits
+{
+    // Zero Disables a Limit
+    double max_notional {};
+    double max_position {};
+    double max_orders_per_second {};
+    double price_band {};
+};
+
+struct GCRiskOrder
+{
+    std::int64_t market_id {};
+    double signed_quantity {};
+    double price {};
+    double bid_price {};
+    double offer_price {};
+};
+
+enum class GCRiskResult : std::uint8_t
+{
+    Accepted,
+    MaxNotional,
+    MaxPosition,
+    OrderRate,
+    PriceBand,
+    Rule
+};
+
+using GCRiskRule = std::function<bool(GCRiskOrder const&)>;
+
+class GCRiskEngine
+{
+    /*
+     * Pre-trade checks run before an order payload is sent. Every check reads local state only: the limits,
+     * the position book and the quote fetched for the attempt. A check is a fixed number of hash lookups and
+     * comparisons and does not allocate; only configuration calls do.
+     */
+  public:
+    explicit GCRiskEngine(std::shared_ptr<GCPositionBook const> position_book);
+
+    void set_limits(GCRiskLimits const& limits);
+
+    void set_market_limits(std::int64_t const market_id, GCRiskLimits const& limits);
+
+    void add_rule(GCRiskRule rule);
+
+    [[nodiscard]] GCRiskResult check(GCRiskOrder const& order, bool const new_order = true);
+
+    [[nodiscard]] static std::string_view describe(GCRiskResult const result) noexcept;
+
+  private:
+    mutable std::shared_mutex config_mutex;
+    GCRiskLimits default_limits;
+    std::unordered_map<std::int64_t, GCRiskLimits> market_limits;
+    std::vector<GCRiskRule> rules;
+    std::shared_ptr<GCPositionBook const> positions;
+
+    std::mutex rate_mutex;
+    double rate_tokens {};
+    std::chrono::steady_clock::time_point rate_refilled_at {};
+
+    [[nodiscard]] bool take_rate_token(double const max_orders_per_second);
+};
+
+}// namespace gaincapital
+
+#endif
@@ -0,0 +1,59 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_SESSION_H
+#define GAIN_CAPITAL_SESSION_H
+
+#include <atomic> // for atomic
+#include <chrono> // for steady_clock
+#include <cstdint>// for uint64_t
+#include <memory> // for shared_ptr
+#include <mutex>  // for mutex
+#include <string> // for basic_string
+
+#include "cpr/cprtypes.h"// for Header
+
+namespace gaincapital
+{
+
+struct GCSession
+{
+    cpr::Header header;
+    std::string trading_account_id;
+    std::string client_account_id;
+    std::uint64_t generation {};
+    std::chrono::steady_clock::time_point created_at {};
+};
+
+class GCSessionStore
+{
+    /*
+     * RCU-style holder for the authenticated session.
+     * Readers take an immutable snapshot without locking; writers serialize on the writer mutex
+     * and publish a replacement, so in-flight requests keep the credentials they started with.
+     */
+  public:
+    GCSessionStore() = default;
+
+    [[nodiscard]] std::shared_ptr<GCSession const> load() const noexcept;
+
+    void publish(GCSession session);
+
+    [[nodiscard]] std::mutex& writer_mutex() noexcept;
+
+    void mark_validated() noexcept;
+
+    [[nodiscard]] bool recently_validated() const noexcept;
+
+    void set_validation_ttl(std::chrono::milliseconds ttl) noexcept;
+
+  private:
+    std::atomic<std::shared_ptr<GCSession const>> current {std::make_shared<GCSession const>()};
+    std::mutex writer;
+    std::atomic<std::int64_t> validated_at_ns {0};
+    std::atomic<std::int64_t> validation_ttl_ns {0};
+};
+
+}// namespace gaincapital
+
+#endif
@@ -0,0 +1,103 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_SINGLE_FLIGHT_H
+#define GAIN_CAPITAL_SINGLE_FLIGHT_H
+
+#include <algorithm>    // for sort
+#include <atomic>       // for atomic
+#include <cstddef>      // for size_t
+#include <functional>   // for hash
+#include <mutex>        // for mutex
+#include <string>       // for basic_string
+#include <string_view>  // for string_view
+#include <unordered_map>// for unordered_map
+#include <utility>      // for move
+#include <vector>       // for vector
+
+namespace gaincapital
+{
+
+template <typename Callback>
+class GCSingleFlight
+{
+    /*
+     * Coalesces identical in-flight requests. The first caller for a key becomes the leader and issues
+     * the request; later callers are parked until the leader completes and all receive the same result.
+     */
+  public:
+    GCSingleFlight() = default;
+
+    [[nodiscard]] bool join(std::string const& key, Callback callback)
+    {
+        /*
+         * Registers the callback under key.
+         * :return: true when the caller is the leader and must issue the request
+         */
+        std::lock_guard<std::mutex> const lock {mutex};
+        auto [it, inserted] = in_flight.try_emplace(key);
+        it->second.emplace_back(std::move(callback));
+        if (! inserted)
+        {
+            coalesced_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        return inserted;
+    }
+
+    [[nodiscard]] std::vector<Callback> complete(std::string const& key)
+    {
+        /*
+         * Removes key and returns every callback that waited on it, leader first.
+         */
+        std::lock_guard<std::mutex> const lock {mutex};
+        auto node = in_flight.extract(key);
+        return node.empty() ? std::vector<Callback> {} : std::move(node.mapped());
+    }
+
+    [[nodiscard]] std::size_t coalesced() const noexcept { return coalesced_count.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] static std::string request_key(std::string_view type, std::string_view url, std::string_view payload)
+    {
+        /*
+         * Builds (method, canonical URL, payload hash). Query parameters are sorted so that
+         * equivalent URLs built in a different order share a key.
+         */
+        std::string key {type};
+        key += ' ';
+
+        auto const query_start = url.find('?');
+        key += url.substr(0, query_start);
+        if (query_start != std::string_view::npos)
+        {
+            std::vector<std::string_view> params;
+            std::string_view query = url.substr(query_start + 1);
+            while (! query.empty())
+            {
+                auto const amp = query.find('&');
+                params.emplace_back(query.substr(0, amp));
+                query = (amp == std::string_view::npos) ? std::string_view {} : query.substr(amp + 1);
+            }
+            std::sort(params.begin(), params.end());
+
+            char separator = '?';
+            for (auto const& param : params)
+            {
+                key += separator;
+                key += param;
+                separator = '&';
+            }
+        }
+        key += '#';
+        key += std::to_string(std::hash<std::string_view> {}(payload));
+        return key;
+    }
+
+  private:
+    std::mutex mutex;
+    std::unordered_map<std::string, std::vector<Callback>> in_flight;
+    std::atomic<std::size_t> coalesced_count {0};
+};
+
+}// namespace gaincapital
+
+#endif
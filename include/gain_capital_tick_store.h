@@ -0,0 +1,137 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_TICK_STORE_H
+#define GAIN_CAPITAL_TICK_STORE_H
+
+#include <cstddef>   // for size_t
+#include <cstdint>   // for int64_t, uint8_t, uint32_t, uint64_t
+#include <expected>  // for expected
+#include <filesystem>// for path
+#include <fstream>   // for fstream, ifstream
+#include <limits>    // for numeric_limits
+#include <span>      // for span
+#include <string>    // for basic_string
+#include <vector>    // for vector
+
+#include "gain_capital_bar_builder.h"// for GCBarColumns
+#include "gain_capital_exception.h"  // for GCException
+#include "gain_capital_market_data.h"// for GCPriceTick
+#include "gain_capital_price.h"      // for GCPrice
+
+namespace gaincapital
+{
+
+/*
+ * Binary tick file, one per market:
+ *   header   "GCTK", version, price decimals, ticks per block
+ *   blocks   tick count, payload size, the first timestamp and price units as zigzag varints, then per
+ *            further tick the timestamp delta as a varint and the price delta as a zigzag varint
+ *   index    first / last timestamp, file offset and tick count of every block
+ *   trailer  index offset, index entry count, "GCTI"
+ * Fields are little-endian. The index sits at the end so a file can be reopened and appended to; appends
+ * are made to a copy that replaces the file on close.
+ */
+struct GCTickBlockIndex
+{
+    std::int64_t first_ms {};
+    std::int64_t last_ms {};
+    std::uint64_t offset {};
+    std::uint32_t count {};
+};
+
+class GCTickWriter
+{
+    /*
+     * Appends timestamp-ordered ticks to a tick file. Prices are rescaled to the file's decimals; blocks are
+     * written to a temporary copy as they fill, and close writes the index and renames the copy into place,
+     * so the file on disk is always complete. Not thread-safe.
+     */
+  public:
+    static constexpr std::uint32_t DEFAULT_BLOCK_SIZE = 4096;
+
+    [[nodiscard]] static std::expected<GCTickWriter, GCException> open(std::filesystem::path const& path,
+                                                                       std::uint8_t const decimals = GCPrice::DEFAULT_DECIMALS,
+                                                                       std::uint32_t const block_size = DEFAULT_BLOCK_SIZE);
+
+    ~GCTickWriter();
+
+    // Move Only | Owns the File Handle
+    GCTickWriter(GCTickWriter const& obj) = delete;
+
+    GCTickWriter& operator=(GCTickWriter const& obj) = delete;
+
+    GCTickWriter(GCTickWriter&& obj) = default;
+
+    GCTickWriter& operator=(GCTickWriter&& obj) = default;
+
+    [[nodiscard]] std::expected<std::size_t, GCException> append(std::span<GCPriceTick const> ticks);
+
+    [[nodiscard]] std::expected<bool, GCException> close();
+
+    [[nodiscard]] std::uint64_t tick_count() const noexcept;
+
+  private:
+    std::filesystem::path file_path;
+    std::filesystem::path temporary_path;
+    std::fstream file;
+    std::vector<GCTickBlockIndex> index;
+    std::string block_payload;
+    std::uint64_t write_offset {};
+    std::uint64_t total_ticks {};
+    std::uint32_t block_ticks {};
+    std::uint32_t ticks_per_block {};
+    std::int64_t block_first_ms {};
+    std::int64_t previous_ms {std::numeric_limits<std::int64_t>::min()};
+    std::int64_t previous_units {};
+    std::uint8_t price_decimals {};
+
+    GCTickWriter() = default;
+
+    [[nodiscard]] bool flush_block();
+};
+
+class GCTickReader
+{
+    /*
+     * Loads a tick file's index on open; range reads binary search it and decode only the blocks that
+     * overlap the requested window. Not thread-safe; open one reader per thread.
+     */
+  public:
+    [[nodiscard]] static std::expected<GCTickReader, GCException> open(std::filesystem::path const& path);
+
+    [[nodiscard]] std::expected<std::vector<GCPriceTick>, GCException> read(
+        std::int64_t const from_ms = std::numeric_limits<std::int64_t>::min(), std::int64_t const to_ms = std::numeric_limits<std::int64_t>::max());
+
+    [[nodiscard]] std::vector<GCTickBlockIndex> const& blocks() const noexcept;
+
+    [[nodiscard]] std::uint64_t tick_count() const noexcept;
+
+    [[nodiscard]] std::uint8_t decimals() const noexcept;
+
+    [[nodiscard]] std::uint64_t blocks_decoded() const noexcept;
+
+  private:
+    std::ifstream file;
+    std::vector<GCTickBlockIndex> index;
+    std::string block_buffer;
+    std::uint64_t total_ticks {};
+    std::uint64_t decoded_blocks {};
+    std::uint8_t price_decimals {};
+
+    GCTickReader() = default;
+};
+
+/*
+ * Binary bar file, one per downloaded range:
+ *   header   "GCBR", version, price decimals, two reserved bytes, bar count
+ *   columns  timestamp, open, high, low and close, each bar count little-endian int64 values
+ * The file is written beside the target and renamed into place, so it either exists whole or not at all.
+ */
+[[nodiscard]] std::expected<bool, GCException> write_bar_file(std::filesystem::path const& path, GCBarColumns const& bars);
+
+[[nodiscard]] std::expected<GCBarColumns, GCException> read_bar_file(std::filesystem::path const& path);
+
+}// namespace gaincapital
+
+#endif
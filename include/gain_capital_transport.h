@@ -0,0 +1,170 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_TRANSPORT_H
+#define GAIN_CAPITAL_TRANSPORT_H
+
+#include <atomic>            // for atomic
+#include <chrono>            // for steady_clock
+#include <condition_variable>// for condition_variable
+#include <cstddef>           // for size_t
+#include <cstdint>           // for int64_t, uint64_t
+#include <expected>          // for expected
+#include <filesystem>        // for path
+#include <functional>        // for function
+#include <map>               // for multimap
+#include <memory>            // for shared_ptr
+#include <mutex>             // for mutex
+#include <string>            // for basic_string
+#include <thread>            // for thread
+#include <unordered_map>     // for unordered_map
+#include <utility>           // for pair
+#include <vector>            // for vector
+
+#include "cpr/cprtypes.h"          // for Header
+#include "gain_capital_deadline.h" // for GCDeadline, NO_DEADLINE
+#include "gain_capital_exception.h"// for GCException
+
+namespace gaincapital
+{
+
+struct NetworkRequest
+{
+    std::string type;
+    std::string url;
+    cpr::Header header;
+    std::string payload;
+    GCDeadline deadline {NO_DEADLINE};// bounds connect, TLS and transfer together
+};
+
+struct NetworkResponse
+{
+    long status_code {};
+    std::string text;
+    std::string error_message;
+    cpr::Header header;
+    bool deadline_exceeded {};
+    bool circuit_open {};// rejected by the client's circuit breaker without being sent
+};
+
+using NetworkCallback = std::function<void(NetworkResponse&&)>;
+
+class GCTransport
+{
+    /*
+     * Carries the requests beneath make_network_call. submit may be called from any thread; each callback
+     * runs exactly once, on a thread owned by the transport, and must not block. cancel is best effort:
+     * a request still in flight completes early with status 0, and by default requests run to completion.
+     */
+  public:
+    virtual ~GCTransport() = default;
+
+    virtual std::uint64_t submit(NetworkRequest request, NetworkCallback callback) = 0;
+
+    virtual void cancel([[maybe_unused]] std::uint64_t const id) {}
+
+    [[nodiscard]] virtual std::size_t in_flight() const noexcept = 0;
+};
+
+/*
+ * Session log written by GCRecordingTransport and served by GCReplayTransport:
+ *   header   "GCRR", version, three reserved bytes
+ *   records  microseconds from the start of recording to the submit, microseconds until the response,
+ *            status code, then length-prefixed method, URL, payload, body, error message and response headers
+ * Fields are little-endian. Request headers carry the session token and are never written, nor are the logon payload
+ * and response body.
+ */
+class GCRecordingTransport final : public GCTransport
+{
+    /*
+     * Forwards every request to an inner transport and appends the exchange to a session log as it completes.
+     */
+  public:
+    [[nodiscard]] static std::expected<std::shared_ptr<GCRecordingTransport>, GCException> open(std::filesystem::path const& path,
+                                                                                               std::shared_ptr<GCTransport> inner);
+
+    std::uint64_t submit(NetworkRequest request, NetworkCallback callback) override;
+
+    void cancel(std::uint64_t const id) override;
+
+    [[nodiscard]] std::size_t in_flight() const noexcept override;
+
+    [[nodiscard]] std::expected<bool, GCException> flush();
+
+    [[nodiscard]] std::uint64_t records() const noexcept;
+
+  private:
+    struct Log;
+
+    std::shared_ptr<GCTransport> inner;
+    std::shared_ptr<Log> log;
+
+    GCRecordingTransport() = default;
+};
+
+class GCReplayTransport final : public GCTransport
+{
+    /*
+     * Answers requests from a session log without touching the network. A request is matched on method, URL path
+     * and payload, falling back to method and path; repeated requests receive the recorded responses in order and
+     * then start over. Responses are delivered on the replay thread after the recorded latency times speed,
+     * so 1 replays at recorded speed and 0 as fast as possible. Unmatched requests receive a 404, and a response
+     * due after the request's deadline is replaced by a timeout at the deadline.
+     */
+  public:
+    [[nodiscard]] static std::expected<std::shared_ptr<GCReplayTransport>, GCException> open(std::filesystem::path const& path,
+                                                                                            double const speed = 1.0);
+
+    ~GCReplayTransport() override;
+
+    // No Copy or Move | Owns the Replay Thread
+    GCReplayTransport(GCReplayTransport const& obj) = delete;
+
+    GCReplayTransport& operator=(GCReplayTransport const& obj) = delete;
+
+    GCReplayTransport(GCReplayTransport&& obj) = delete;
+
+    GCReplayTransport& operator=(GCReplayTransport&& obj) = delete;
+
+    std::uint64_t submit(NetworkRequest request, NetworkCallback callback) override;
+
+    [[nodiscard]] std::size_t in_flight() const noexcept override;
+
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    [[nodiscard]] std::uint64_t misses() const noexcept;
+
+  private:
+    struct Exchange
+    {
+        std::int64_t latency_us {};
+        NetworkResponse response;
+    };
+
+    struct Responses
+    {
+        std::vector<std::size_t> exchanges;
+        std::size_t cursor {};
+    };
+
+    std::vector<Exchange> exchanges;
+    std::unordered_map<std::string, Responses> exact_matches;
+    std::unordered_map<std::string, Responses> path_matches;
+    double latency_scale {1.0};
+
+    mutable std::mutex mutex;
+    std::condition_variable pending_ready;
+    std::multimap<std::chrono::steady_clock::time_point, std::pair<NetworkResponse, NetworkCallback>> pending;
+    std::atomic<std::uint64_t> next_id {1};
+    std::atomic<std::uint64_t> miss_count {0};
+    bool stopping {false};
+    std::thread replay_thread;
+
+    GCReplayTransport() = default;
+
+    void run();
+};
+
+}// namespace gaincapital
+
+#endif
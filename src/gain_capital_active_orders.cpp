@@ -0,0 +1,126 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_active_orders.h"
+
+#include <algorithm>    // for max, min
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t
+#include <mutex>        // for lock_guard
+#include <optional>     // for optional
+#include <string>       // for basic_string
+#include <unordered_map>// for unordered_map
+#include <utility>      // for move
+
+#include "json/json.hpp"// for json
+
+namespace gaincapital
+{
+
+GCActiveOrderTracker::GCActiveOrderTracker(std::size_t const initial_page_size)
+    : page_size(std::clamp<std::size_t>(initial_page_size, 1, MAX_WINDOW))
+{
+}
+
+void GCActiveOrderTracker::set_page_size(std::size_t const size)
+{
+    std::lock_guard<std::mutex> const lock {mutex};
+    page_size = std::clamp<std::size_t>(size, 1, MAX_WINDOW);
+}
+
+std::size_t GCActiveOrderTracker::window(std::string const& account) const
+{
+    /*
+     * The smallest multiple of the page size above the last count, so a book that grew by less than a page
+     * since the last listing is still returned whole in one request.
+     */
+    std::lock_guard<std::mutex> const lock {mutex};
+    auto const it                = accounts.find(account);
+    std::size_t const last_count = (it == accounts.end()) ? 0 : it->second.last_count;
+    return std::min((last_count / page_size + 1) * page_size, MAX_WINDOW);
+}
+
+void GCActiveOrderTracker::record_count(std::string const& account, std::size_t const count)
+{
+    std::lock_guard<std::mutex> const lock {mutex};
+    accounts[account].last_count = count;
+}
+
+std::optional<GCActiveOrdersDelta> GCActiveOrderTracker::diff(std::string const& account, nlohmann::json const& active_orders)
+{
+    /*
+     * Replaces the account's snapshot and reports what moved since the previous one. The first call for an
+     * account reports every order as added. Entries without an order ID cannot be tracked and are skipped.
+     * :return: nullopt when the response is not an active order list
+     */
+    if (! active_orders.contains("ActiveOrders") || ! active_orders["ActiveOrders"].is_array())
+    {
+        return std::nullopt;
+    }
+
+    GCActiveOrdersDelta delta;
+    std::unordered_map<std::int64_t, nlohmann::json> next;
+    next.reserve(active_orders["ActiveOrders"].size());
+
+    std::lock_guard<std::mutex> const lock {mutex};
+    AccountState& state = accounts[account];
+    for (nlohmann::json const& entry : active_orders["ActiveOrders"])
+    {
+        auto const order_id = read_order_id(entry);
+        if (! order_id || ! next.try_emplace(*order_id, entry).second)
+        {
+            continue;
+        }
+        auto const previous = state.orders.find(*order_id);
+        if (previous == state.orders.end())
+        {
+            delta.added.push_back(entry);
+        }
+        else if (previous->second != entry)
+        {
+            delta.changed.push_back(entry);
+        }
+    }
+    for (auto const& [order_id, entry] : state.orders)
+    {
+        if (! next.contains(order_id))
+        {
+            delta.removed.push_back(order_id);
+        }
+    }
+    state.orders = std::move(next);
+    return delta;
+}
+
+void GCActiveOrderTracker::clear()
+{
+    std::lock_guard<std::mutex> const lock {mutex};
+    accounts.clear();
+}
+
+nlohmann::json const* GCActiveOrderTracker::order_body(nlohmann::json const& entry)
+{
+    /*
+     * Entries wrap the order in either a TradeOrder or a StopLimitOrder object, the other being null.
+     */
+    for (char const* key : {"StopLimitOrder", "TradeOrder"})
+    {
+        if (entry.contains(key) && entry[key].is_object())
+        {
+            return &entry[key];
+        }
+    }
+    return nullptr;
+}
+
+std::optional<std::int64_t> GCActiveOrderTracker::read_order_id(nlohmann::json const& entry)
+{
+    nlohmann::json const* body = order_body(entry);
+    if (body == nullptr || ! body->contains("OrderId") || ! (*body)["OrderId"].is_number_integer())
+    {
+        return std::nullopt;
+    }
+    return (*body)["OrderId"].get<std::int64_t>();
+}
+
+}// namespace gaincapital
@@ -0,0 +1,66 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_arena.h"
+
+#include <bit>            // for bit_ceil
+#include <cstddef>        // for size_t, byte
+#include <memory_resource>// for new_delete_resource
+
+namespace gaincapital
+{
+
+GCArena::GCArena(std::size_t initial_size) : block(initial_size)
+{
+    resource.emplace(block.data(), block.size(), std::pmr::new_delete_resource());
+}
+
+void* GCArena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    ++allocation_count;
+    bytes_requested += bytes + alignment;
+    return resource->allocate(bytes, alignment);
+}
+
+void GCArena::reset()
+{
+    /*
+     * Overflow blocks are returned upstream; if this cycle spilled past the retained block it is
+     * resized so the next cycle of the same size is served entirely from it.
+     */
+    if (bytes_requested > block.size())
+    {
+        resource.reset();
+        block = std::vector<std::byte>(std::bit_ceil(bytes_requested));
+        resource.emplace(block.data(), block.size(), std::pmr::new_delete_resource());
+    }
+    else
+    {
+        resource->release();
+    }
+    allocation_count = 0;
+    bytes_requested  = 0;
+}
+
+std::size_t GCArena::allocations() const noexcept { return allocation_count; }
+
+std::size_t GCArena::capacity() const noexcept { return block.size(); }
+
+GCArena& GCArena::thread_local_arena()
+{
+    thread_local GCArena arena;
+    return arena;
+}
+
+GCArenaScope::GCArenaScope() noexcept { ++GCArena::thread_local_arena().scope_depth; }
+
+GCArenaScope::~GCArenaScope()
+{
+    GCArena& arena = GCArena::thread_local_arena();
+    if (--arena.scope_depth == 0)
+    {
+        arena.reset();
+    }
+}
+
+}// namespace gaincapital
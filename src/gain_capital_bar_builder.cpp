@@ -0,0 +1,371 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_bar_builder.h"
+
+#include <algorithm>      // for find, max, min, transform
+#include <array>          // for array
+#include <cctype>         // for toupper
+#include <chrono>         // for sys_days, year_month_day
+#include <cstddef>        // for size_t
+#include <cstdint>        // for int64_t, uint8_t
+#include <expected>       // for expected
+#include <mutex>          // for unique_lock
+#include <optional>       // for optional
+#include <shared_mutex>   // for shared_lock
+#include <source_location>// for source_location
+#include <span>           // for span
+#include <string>         // for basic_string
+#include <string_view>    // for string_view
+#include <utility>        // for pair
+#include <vector>         // for vector
+
+#include "gain_capital_exception.h"  // for GCException
+#include "gain_capital_market_data.h"// for GCPriceTick, GCPriceBar
+#include "gain_capital_price.h"      // for GCPrice
+
+namespace gaincapital
+{
+
+namespace
+{
+
+constexpr std::int64_t MINUTE_MS = 60'000;
+constexpr std::int64_t HOUR_MS   = 60 * MINUTE_MS;
+constexpr std::int64_t DAY_MS    = 24 * HOUR_MS;
+constexpr std::int64_t WEEK_MS   = 7 * DAY_MS;
+
+/* The epoch fell on a Thursday; shifting by four days aligns weeks to Monday 00:00 UTC */
+constexpr std::int64_t WEEK_OFFSET_MS = 4 * DAY_MS;
+
+constexpr std::array<std::size_t, 7> SPAN_M = {1, 2, 3, 5, 10, 15, 30};
+constexpr std::array<std::size_t, 4> SPAN_H = {1, 2, 4, 8};
+
+constexpr std::size_t HOUR_INDEX  = SPAN_M.size();
+constexpr std::size_t DAY_INDEX   = HOUR_INDEX + SPAN_H.size();
+constexpr std::size_t WEEK_INDEX  = DAY_INDEX + 1;
+constexpr std::size_t MONTH_INDEX = WEEK_INDEX + 1;
+
+static_assert(MONTH_INDEX + 1 == GCBarBuilder::SERIES_COUNT);
+
+/* Fixed bar length per series index; calendar months vary in length and are marked with zero */
+constexpr std::array<std::int64_t, GCBarBuilder::SERIES_COUNT> SERIES_PERIOD_MS = []
+{
+    std::array<std::int64_t, GCBarBuilder::SERIES_COUNT> periods {};
+    for (std::size_t i = 0; i < SPAN_M.size(); ++i)
+    {
+        periods[i] = static_cast<std::int64_t>(SPAN_M[i]) * MINUTE_MS;
+    }
+    for (std::size_t i = 0; i < SPAN_H.size(); ++i)
+    {
+        periods[HOUR_INDEX + i] = static_cast<std::int64_t>(SPAN_H[i]) * HOUR_MS;
+    }
+    periods[DAY_INDEX]  = DAY_MS;
+    periods[WEEK_INDEX] = WEEK_MS;
+    return periods;
+}();
+
+constexpr std::string_view INTERVAL_ERROR =
+    "Interval Error - Provide 'MINUTE' with span 1, 2, 3, 5, 10, 15, 30, 'HOUR' with span 1, 2, 4, 8, or 'DAY', 'WEEK', 'MONTH'";
+
+std::optional<std::size_t> series_index(std::string_view interval, std::size_t const span) noexcept
+{
+    std::array<char, 8> upper {};
+    if (interval.size() > upper.size())
+    {
+        return std::nullopt;
+    }
+    std::transform(interval.begin(), interval.end(), upper.begin(), [](unsigned char const c) { return static_cast<char>(std::toupper(c)); });
+    std::string_view const name {upper.data(), interval.size()};
+
+    if (name == "MINUTE" || name == "HOUR")
+    {
+        auto const spans = (name == "MINUTE") ? std::span<std::size_t const> {SPAN_M} : std::span<std::size_t const> {SPAN_H};
+        auto const found = std::find(spans.begin(), spans.end(), span);
+        if (found == spans.end())
+        {
+            return std::nullopt;
+        }
+        return static_cast<std::size_t>(found - spans.begin()) + ((name == "MINUTE") ? 0 : HOUR_INDEX);
+    }
+    // DAY, WEEK and MONTH ignore the span, as build_ohlc_url does
+    if (name == "DAY")
+    {
+        return DAY_INDEX;
+    }
+    if (name == "WEEK")
+    {
+        return WEEK_INDEX;
+    }
+    if (name == "MONTH")
+    {
+        return MONTH_INDEX;
+    }
+    return std::nullopt;
+}
+
+std::pair<std::int64_t, std::int64_t> bar_bounds(std::int64_t const period_ms, std::int64_t const timestamp_ms)
+{
+    /*
+     * :return: [start, end) of the bar holding timestamp_ms; a zero period selects the calendar month
+     */
+    if (period_ms > 0)
+    {
+        std::int64_t const offset  = (period_ms == WEEK_MS) ? WEEK_OFFSET_MS : 0;
+        std::int64_t const shifted = timestamp_ms - offset;
+        std::int64_t const start   = shifted - (((shifted % period_ms) + period_ms) % period_ms) + offset;
+        return {start, start + period_ms};
+    }
+    using std::chrono::days, std::chrono::milliseconds, std::chrono::months, std::chrono::sys_days, std::chrono::year_month_day;
+    year_month_day const date {std::chrono::floor<days>(std::chrono::sys_time<milliseconds> {milliseconds {timestamp_ms}})};
+    auto const month_start = date.year() / date.month() / 1;
+    return {std::chrono::duration_cast<milliseconds>(sys_days {month_start}.time_since_epoch()).count(),
+            std::chrono::duration_cast<milliseconds>(sys_days {month_start + months {1}}.time_since_epoch()).count()};
+}
+
+}// namespace
+
+GCBarBuilder::GCBarBuilder(std::size_t const history) : history_size(std::max<std::size_t>(history, 1))
+{
+    for (std::size_t i = 0; i < SERIES_COUNT; ++i)
+    {
+        series[i].period_ms = SERIES_PERIOD_MS[i];
+    }
+}
+
+bool GCBarBuilder::add_tick(GCPriceTick const& tick)
+{
+    /*
+     * Ticks must arrive in timestamp order; a tick older than the last one accepted is dropped, since
+     * it could no longer set the close of the bar it belongs to.
+     * :return: false when the tick was dropped
+     */
+    std::unique_lock<std::shared_mutex> const lock {mutex};
+    if (has_ticks && tick.timestamp_ms < last_tick)
+    {
+        return false;
+    }
+    has_ticks = true;
+    last_tick = tick.timestamp_ms;
+
+    for (Series& bar_series : series)
+    {
+        if (bar_series.has_open && tick.timestamp_ms < bar_series.bar_end_ms)
+        {
+            GCPriceBar& bar = bar_series.open_bar;
+            bar.high        = std::max(bar.high, tick.price);
+            bar.low         = std::min(bar.low, tick.price);
+            bar.close       = tick.price;
+        }
+        else
+        {
+            roll(bar_series, tick);
+        }
+    }
+    return true;
+}
+
+std::size_t GCBarBuilder::add_ticks(std::span<GCPriceTick const> ticks)
+{
+    /*
+     * :return: number of ticks accepted
+     */
+    std::size_t accepted = 0;
+    for (GCPriceTick const& tick : ticks)
+    {
+        accepted += add_tick(tick) ? 1U : 0U;
+    }
+    return accepted;
+}
+
+std::optional<GCPriceBar> GCBarBuilder::current(std::string_view interval, std::size_t const span) const
+{
+    /*
+     * The bar still forming for interval / span, or nullopt before the first tick or for an unsupported series.
+     */
+    auto const index = series_index(interval, span);
+    if (! index)
+    {
+        return std::nullopt;
+    }
+    std::shared_lock<std::shared_mutex> const lock {mutex};
+    Series const& bar_series = series[*index];
+    return bar_series.has_open ? std::optional<GCPriceBar> {bar_series.open_bar} : std::nullopt;
+}
+
+std::expected<std::vector<GCPriceBar>, GCException> GCBarBuilder::bars(std::string_view interval, std::size_t const num_bars,
+                                                                       std::size_t const span) const
+{
+    /*
+     * Local counterpart of get_bar_history with the same interval and span rules.
+     * :return: up to num_bars of the most recent completed bars followed by the open bar, oldest first
+     */
+    auto const index = series_index(interval, span);
+    if (! index)
+    {
+        return std::expected<std::vector<GCPriceBar>, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                                    std::string(INTERVAL_ERROR)};
+    }
+    std::shared_lock<std::shared_mutex> const lock {mutex};
+    Series const& bar_series = series[*index];
+
+    std::size_t const open_count = bar_series.has_open ? 1 : 0;
+    std::size_t const available  = bar_series.completed.size() + open_count;
+    std::size_t const count      = std::min(num_bars, available);
+    std::size_t const skip       = bar_series.completed.size() - std::min(bar_series.completed.size(), count - std::min(count, open_count));
+
+    std::vector<GCPriceBar> result;
+    result.reserve(count);
+    for (std::size_t i = skip; i < bar_series.completed.size(); ++i)
+    {
+        result.push_back(bar_series.completed[(bar_series.head + i) % bar_series.completed.size()]);
+    }
+    if (open_count != 0 && count != 0)
+    {
+        result.push_back(bar_series.open_bar);
+    }
+    return result;
+}
+
+std::int64_t GCBarBuilder::last_tick_ms() const
+{
+    std::shared_lock<std::shared_mutex> const lock {mutex};
+    return last_tick;
+}
+
+void GCBarBuilder::clear()
+{
+    std::unique_lock<std::shared_mutex> const lock {mutex};
+    for (Series& bar_series : series)
+    {
+        bar_series.has_open = false;
+        bar_series.completed.clear();
+        bar_series.head = 0;
+    }
+    has_ticks = false;
+    last_tick = 0;
+}
+
+void GCBarBuilder::roll(Series& bar_series, GCPriceTick const& tick) const
+{
+    /*
+     * Closes the open bar into the history ring, overwriting the oldest once full, and opens a new bar on the tick.
+     */
+    if (bar_series.has_open)
+    {
+        if (bar_series.completed.size() < history_size)
+        {
+            bar_series.completed.push_back(bar_series.open_bar);
+        }
+        else
+        {
+            bar_series.completed[bar_series.head] = bar_series.open_bar;
+            bar_series.head                       = (bar_series.head + 1) % history_size;
+        }
+    }
+
+    auto const [bar_start, bar_end] = bar_bounds(bar_series.period_ms, tick.timestamp_ms);
+    bar_series.bar_end_ms           = bar_end;
+    bar_series.open_bar             = {bar_start, tick.price, tick.price, tick.price, tick.price};
+    bar_series.has_open             = true;
+}
+
+// =================================================================================
+// Columnar Bars
+// =================================================================================
+
+GCBarColumns GCBarColumns::from_bars(std::span<GCPriceBar const> bars, std::uint8_t const decimals)
+{
+    GCBarColumns columns;
+    columns.decimals = decimals;
+    columns.reserve(bars.size());
+    for (GCPriceBar const& bar : bars)
+    {
+        columns.timestamp_ms.push_back(bar.timestamp_ms);
+        columns.open.push_back(bar.open.rescale(decimals).units());
+        columns.high.push_back(bar.high.rescale(decimals).units());
+        columns.low.push_back(bar.low.rescale(decimals).units());
+        columns.close.push_back(bar.close.rescale(decimals).units());
+    }
+    return columns;
+}
+
+std::vector<GCPriceBar> GCBarColumns::to_bars() const
+{
+    std::vector<GCPriceBar> bars;
+    bars.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        bars.emplace_back(timestamp_ms[i], GCPrice::from_units(open[i], decimals), GCPrice::from_units(high[i], decimals),
+                          GCPrice::from_units(low[i], decimals), GCPrice::from_units(close[i], decimals));
+    }
+    return bars;
+}
+
+std::size_t GCBarColumns::size() const noexcept { return timestamp_ms.size(); }
+
+void GCBarColumns::reserve(std::size_t const count)
+{
+    timestamp_ms.reserve(count);
+    open.reserve(count);
+    high.reserve(count);
+    low.reserve(count);
+    close.reserve(count);
+}
+
+std::expected<GCBarColumns, GCException> resample_bars(GCBarColumns const& bars, std::string_view from_interval, std::size_t const from_span,
+                                                       std::string_view to_interval, std::size_t const to_span)
+{
+    /*
+     * One forward pass: each target bar is a contiguous run of source bars, whose high and low columns
+     * reduce as plain int64 loops. The target must be a whole multiple of a MINUTE, HOUR or DAY source,
+     * so every source bar falls inside exactly one target bar. Source bars must be oldest first.
+     * :return: target bars, oldest first; the last one is partial when the source ends mid-period
+     */
+    auto const source = series_index(from_interval, from_span);
+    auto const target = series_index(to_interval, to_span);
+    if (! source || ! target)
+    {
+        return std::expected<GCBarColumns, GCException> {std::unexpect, std::source_location::current().function_name(), std::string(INTERVAL_ERROR)};
+    }
+    std::int64_t const source_period = SERIES_PERIOD_MS[*source];
+    std::int64_t const target_period = SERIES_PERIOD_MS[*target];
+    if (*source > DAY_INDEX || (target_period != 0 && (target_period < source_period || target_period % source_period != 0)))
+    {
+        return std::expected<GCBarColumns, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                         "Resample Error - Target Must Be a Whole Multiple of a MINUTE, HOUR or DAY Source"};
+    }
+    // -------------------
+    GCBarColumns result;
+    result.decimals         = bars.decimals;
+    std::size_t const ratio = static_cast<std::size_t>((target_period != 0 ? target_period : 28 * DAY_MS) / source_period);
+    result.reserve(bars.size() / ratio + 1);
+
+    std::size_t const count = bars.size();
+    std::size_t first       = 0;
+    while (first < count)
+    {
+        auto const [start, end] = bar_bounds(target_period, bars.timestamp_ms[first]);
+        std::size_t last        = first + 1;
+        while (last < count && bars.timestamp_ms[last] < end)
+        {
+            ++last;
+        }
+        std::int64_t high = bars.high[first];
+        std::int64_t low  = bars.low[first];
+        for (std::size_t i = first + 1; i < last; ++i)
+        {
+            high = std::max(high, bars.high[i]);
+            low  = std::min(low, bars.low[i]);
+        }
+        result.timestamp_ms.push_back(start);
+        result.open.push_back(bars.open[first]);
+        result.high.push_back(high);
+        result.low.push_back(low);
+        result.close.push_back(bars.close[last - 1]);
+        first = last;
+    }
+    return result;
+}
+
+}// namespace gaincapital
@@ -0,0 +1,240 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_breaker.h"
+
+#include <algorithm>   // for all_of, max
+#include <array>       // for array
+#include <cctype>      // for isdigit
+#include <chrono>      // for steady_clock, milliseconds
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t, uint64_t
+#include <memory>      // for shared_ptr, make_shared
+#include <mutex>       // for mutex, lock_guard
+#include <optional>    // for optional
+#include <shared_mutex>// for shared_lock
+#include <string>      // for basic_string
+#include <string_view> // for string_view
+#include <utility>     // for move
+#include <vector>      // for vector
+
+namespace gaincapital
+{
+
+namespace
+{
+
+constexpr std::size_t BUCKETS = 10;
+
+bool is_failure(NetworkResponse const& response) noexcept
+{
+    /* Client errors other than throttling say nothing about the server's health, nor does the caller's deadline */
+    constexpr long TOO_MANY_REQUESTS = 429;
+    constexpr long SERVER_ERROR      = 500;
+    return (response.status_code == 0 && ! response.deadline_exceeded) || response.status_code == TOO_MANY_REQUESTS ||
+           response.status_code >= SERVER_ERROR;
+}
+
+}// namespace
+
+struct GCCircuitBreaker::Endpoint
+{
+    struct Bucket
+    {
+        std::int64_t epoch {-1};
+        std::uint64_t requests {};
+        std::uint64_t failures {};
+        std::uint64_t slow_calls {};
+    };
+
+    std::mutex mutex;
+    std::array<Bucket, BUCKETS> buckets {};
+    GCBreakerState state {GCBreakerState::Closed};
+    std::chrono::steady_clock::time_point opened_at;
+    std::size_t probes_sent {};
+    std::size_t probes_passed {};
+    std::uint64_t trips {};
+    std::uint64_t rejected {};
+
+    [[nodiscard]] Bucket window(std::int64_t const epoch) const noexcept
+    {
+        Bucket total {};
+        for (Bucket const& bucket : buckets)
+        {
+            if (bucket.epoch > epoch - static_cast<std::int64_t>(BUCKETS))
+            {
+                total.requests += bucket.requests;
+                total.failures += bucket.failures;
+                total.slow_calls += bucket.slow_calls;
+            }
+        }
+        return total;
+    }
+
+    void trip(std::chrono::steady_clock::time_point const now) noexcept
+    {
+        state     = GCBreakerState::Open;
+        opened_at = now;
+        ++trips;
+    }
+};
+
+GCCircuitBreaker::GCCircuitBreaker(GCBreakerPolicy breaker_policy) : policy(std::move(breaker_policy))
+{
+    bucket_width = std::max<std::chrono::steady_clock::duration>(std::chrono::milliseconds {1}, policy.window / BUCKETS);
+}
+
+std::optional<GCCircuitBreaker::Permit> GCCircuitBreaker::acquire(std::string_view type, std::string_view url)
+{
+    /*
+     * :return: a permit to send the request, handed back to record with its response, or nullopt to fail it fast
+     */
+    std::shared_ptr<Endpoint> endpoint = find_or_add(endpoint_key(type, url));
+    auto const now                     = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> const lock {endpoint->mutex};
+    if (endpoint->state == GCBreakerState::Open)
+    {
+        if (now - endpoint->opened_at < policy.open_duration)
+        {
+            ++endpoint->rejected;
+            return std::nullopt;
+        }
+        endpoint->state         = GCBreakerState::HalfOpen;
+        endpoint->probes_sent   = 0;
+        endpoint->probes_passed = 0;
+    }
+    if (endpoint->state == GCBreakerState::HalfOpen)
+    {
+        if (endpoint->probes_sent >= policy.probes)
+        {
+            ++endpoint->rejected;
+            return std::nullopt;
+        }
+        ++endpoint->probes_sent;
+        return Permit {endpoint, now, endpoint->trips, true};
+    }
+    return Permit {endpoint, now, endpoint->trips, false};
+}
+
+void GCCircuitBreaker::record(Permit const& permit, NetworkResponse const& response)
+{
+    auto const now     = std::chrono::steady_clock::now();
+    bool const failed  = is_failure(response);
+    bool const slow    = now - permit.start > policy.slow_call;
+    Endpoint& endpoint = *permit.endpoint;
+    std::lock_guard<std::mutex> const lock {endpoint.mutex};
+    // -------------------
+    // A Deadline That Ran Out Before the Server Was Slow Says Nothing About It, Often the Request Was Never Sent
+    bool const no_verdict = response.deadline_exceeded && ! slow;
+    // -------------------
+    // Probes Decide the Half-Open State; Answers to Probes From an Earlier Trip Are Ignored
+    if (permit.probe)
+    {
+        if (endpoint.state != GCBreakerState::HalfOpen || permit.generation != endpoint.trips)
+        {
+            return;
+        }
+        if (no_verdict)
+        {
+            --endpoint.probes_sent;
+            return;
+        }
+        if (failed || slow)
+        {
+            endpoint.trip(now);
+        }
+        else if (++endpoint.probes_passed >= policy.probes)
+        {
+            endpoint.state   = GCBreakerState::Closed;
+            endpoint.buckets = {};
+        }
+        return;
+    }
+    if (no_verdict)
+    {
+        return;
+    }
+    // -------------------
+    std::int64_t const epoch = now.time_since_epoch() / bucket_width;
+    Endpoint::Bucket& bucket = endpoint.buckets[static_cast<std::size_t>(epoch) % BUCKETS];
+    if (bucket.epoch != epoch)
+    {
+        bucket       = Endpoint::Bucket {};
+        bucket.epoch = epoch;
+    }
+    ++bucket.requests;
+    bucket.failures += failed ? 1 : 0;
+    bucket.slow_calls += slow ? 1 : 0;
+    if (endpoint.state != GCBreakerState::Closed)
+    {
+        return;
+    }
+    Endpoint::Bucket const total = endpoint.window(epoch);
+    if (total.requests >= policy.min_requests &&
+        (static_cast<double>(total.failures) >= policy.failure_ratio * static_cast<double>(total.requests) ||
+         static_cast<double>(total.slow_calls) >= policy.slow_call_ratio * static_cast<double>(total.requests)))
+    {
+        endpoint.trip(now);
+    }
+}
+
+std::vector<GCBreakerStats> GCCircuitBreaker::stats() const
+{
+    std::int64_t const epoch = std::chrono::steady_clock::now().time_since_epoch() / bucket_width;
+    std::vector<GCBreakerStats> stats;
+    std::shared_lock<std::shared_mutex> const lock {mutex};
+    stats.reserve(endpoints.size());
+    for (auto const& [key, endpoint] : endpoints)
+    {
+        std::lock_guard<std::mutex> const endpoint_lock {endpoint->mutex};
+        Endpoint::Bucket const total = endpoint->window(epoch);
+        stats.push_back({key, endpoint->state, total.requests, total.failures, total.slow_calls, endpoint->trips, endpoint->rejected});
+    }
+    return stats;
+}
+
+std::string GCCircuitBreaker::endpoint_key(std::string_view type, std::string_view url)
+{
+    /*
+     * :return: e.g. "GET /market/{id}/tickhistory" for https://ciapi.cityindex.com/TradingAPI/market/401484347/tickhistory?PriceTicks=1
+     */
+    if (std::size_t const scheme = url.find("://"); scheme != std::string_view::npos)
+    {
+        std::size_t const path = url.find('/', scheme + 3);
+        url                    = path == std::string_view::npos ? std::string_view {"/"} : url.substr(path);
+    }
+    url = url.substr(0, url.find('?'));
+
+    std::string key {type};
+    key += ' ';
+    while (! url.empty())
+    {
+        std::size_t const end        = url.find('/', 1);
+        std::string_view const piece = url.substr(0, end);
+        bool const numeric
+            = piece.size() > 1 && std::all_of(piece.begin() + 1, piece.end(), [](unsigned char const c) { return std::isdigit(c) != 0; });
+        key += numeric ? std::string_view {"/{id}"} : piece;
+        url = end == std::string_view::npos ? std::string_view {} : url.substr(end);
+    }
+    return key;
+}
+
+std::shared_ptr<GCCircuitBreaker::Endpoint> GCCircuitBreaker::find_or_add(std::string key)
+{
+    {
+        std::shared_lock<std::shared_mutex> const lock {mutex};
+        if (auto const it = endpoints.find(key); it != endpoints.end())
+        {
+            return it->second;
+        }
+    }
+    std::lock_guard<std::shared_mutex> const lock {mutex};
+    auto& endpoint = endpoints[std::move(key)];
+    if (! endpoint)
+    {
+        endpoint = std::make_shared<Endpoint>();
+    }
+    return endpoint;
+}
+
+}// namespace gaincapital
@@ -0,0 +1,159 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_cache.h"
+
+#include <algorithm>   // for min, find_if
+#include <cctype>      // for tolower
+#include <charconv>    // for from_chars
+#include <chrono>      // for steady_clock
+#include <mutex>       // for unique_lock
+#include <optional>    // for optional
+#include <shared_mutex>// for shared_lock
+#include <string>      // for basic_string
+#include <string_view> // for string_view
+
+#include "cpr/cprtypes.h"// for Header
+#include "json/json.hpp" // for json
+
+namespace gaincapital
+{
+
+GCResponseCache::GCResponseCache(std::size_t capacity) : max_entries(capacity) {}
+
+void GCResponseCache::set_ttl(std::string endpoint, std::chrono::milliseconds ttl)
+{
+    /*
+     * :param endpoint: path fragment matched against the request URL (e.g. /margin/clientAccountMargin)
+     * :param ttl: time to serve the cached response; zero removes the endpoint
+     */
+    std::unique_lock<std::shared_mutex> const lock {mutex};
+    auto it = std::find_if(endpoint_ttls.begin(), endpoint_ttls.end(), [&endpoint](auto const& entry) { return entry.first == endpoint; });
+    if (ttl <= std::chrono::milliseconds::zero())
+    {
+        if (it != endpoint_ttls.end())
+        {
+            endpoint_ttls.erase(it);
+        }
+        return;
+    }
+    if (it != endpoint_ttls.end())
+    {
+        it->second = ttl;
+        return;
+    }
+    endpoint_ttls.emplace_back(std::move(endpoint), ttl);
+}
+
+std::chrono::milliseconds GCResponseCache::ttl_for(std::string_view url) const
+{
+    std::shared_lock<std::shared_mutex> const lock {mutex};
+    std::string_view const path = url.substr(0, url.find('?'));
+    for (auto const& [endpoint, ttl] : endpoint_ttls)
+    {
+        if (path.find(endpoint) != std::string_view::npos)
+        {
+            return ttl;
+        }
+    }
+    return std::chrono::milliseconds::zero();
+}
+
+std::optional<nlohmann::json> GCResponseCache::lookup(std::string const& key) const
+{
+    std::shared_lock<std::shared_mutex> const lock {mutex};
+    auto const it = entries.find(key);
+    if (it == entries.end() || it->second.expires_at <= std::chrono::steady_clock::now())
+    {
+        return std::nullopt;
+    }
+    return it->second.value;
+}
+
+void GCResponseCache::store(std::string const& key, nlohmann::json const& value, std::chrono::milliseconds ttl, cpr::Header const& response_header)
+{
+    if (auto const max_age = server_max_age(response_header))
+    {
+        ttl = std::min(ttl, *max_age);
+    }
+    if (ttl <= std::chrono::milliseconds::zero())
+    {
+        return;
+    }
+    auto const now = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::shared_mutex> const lock {mutex};
+    if (entries.size() >= max_entries && ! entries.contains(key))
+    {
+        std::erase_if(entries, [now](auto const& entry) { return entry.second.expires_at <= now; });
+        if (entries.size() >= max_entries)
+        {
+            entries.erase(entries.begin());
+        }
+    }
+    entries.insert_or_assign(key, Entry {value, now + ttl});
+}
+
+void GCResponseCache::clear()
+{
+    std::unique_lock<std::shared_mutex> const lock {mutex};
+    entries.clear();
+}
+
+std::size_t GCResponseCache::size() const
+{
+    std::shared_lock<std::shared_mutex> const lock {mutex};
+    return entries.size();
+}
+
+std::optional<std::chrono::milliseconds> GCResponseCache::server_max_age(cpr::Header const& response_header)
+{
+    /*
+     * Reads Cache-Control one comma-separated directive at a time, so s-maxage (meant for shared caches) is
+     * not mistaken for max-age. no-store / no-cache map to a zero lifetime, max-age to its value, and
+     * anything else leaves the configured TTL untouched.
+     */
+    auto const it = response_header.find("Cache-Control");
+    if (it == response_header.end())
+    {
+        return std::nullopt;
+    }
+    std::string directives = it->second;
+    std::transform(directives.begin(), directives.end(), directives.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    std::optional<std::chrono::milliseconds> max_age;
+    std::string_view remaining {directives};
+    while (! remaining.empty())
+    {
+        std::size_t const comma = remaining.find(',');
+        std::string_view token  = remaining.substr(0, comma);
+        remaining               = (comma == std::string_view::npos) ? std::string_view {} : remaining.substr(comma + 1);
+
+        // Trim Surrounding Whitespace
+        std::size_t const begin = token.find_first_not_of(" \t");
+        if (begin == std::string_view::npos)
+        {
+            continue;
+        }
+        token = token.substr(begin, token.find_last_not_of(" \t") - begin + 1);
+
+        std::size_t const equals    = token.find('=');
+        std::string_view const name = token.substr(0, equals);
+        if (name == "no-store" || name == "no-cache")
+        {
+            return std::chrono::milliseconds::zero();
+        }
+        if (name == "max-age" && equals != std::string_view::npos)
+        {
+            long long seconds     = 0;
+            auto const [ptr, err] = std::from_chars(token.data() + equals + 1, token.data() + token.size(), seconds);
+            if (err == std::errc {} && ptr == token.data() + token.size() && seconds >= 0)
+            {
+                max_age = std::chrono::seconds {seconds};
+            }
+        }
+    }
+    return max_age;
+}
+
+}// namespace gaincapital
@@ -3,29 +3,151 @@
 
 #include "gain_capital_client.h"
 
-#include <algorithm>       // for transform
-#include <array>           // for array
-#include <cctype>          // for toupper
-#include <chrono>          // for system_clock
-#include <expected>        // for expected
-#include <initializer_list>// for initialize...
-#include <iostream>        // for operator<<
-#include <source_location> // for source_location...
-#include <string>          // for basic_string
-#include <unistd.h>        // for sleep
-#include <unordered_map>   // for unordered_map
-#include <vector>          // for vector
-
-#include "cpr/api.h"     // for Get, Post
-#include "cpr/body.h"    // for Body
-#include "cpr/response.h"// for Response
+#include <algorithm>         // for transform
+#include <array>             // for array
+#include <cctype>            // for toupper
+#include <charconv>          // for from_chars
+#include <chrono>            // for system_clock, steady_clock
+#include <condition_variable>// for condition_variable_any
+#include <expected>          // for expected
+#include <future>            // for promise, future_status
+#include <initializer_list>  // for initialize...
+#include <iostream>          // for operator<<
+#include <latch>             // for latch
+#include <memory>            // for shared_ptr
+#include <mutex>             // for lock_guard
+#include <optional>          // for optional
+#include <semaphore>         // for counting_semaphore
+#include <shared_mutex>      // for shared_lock
+#include <source_location>   // for source_location...
+#include <span>              // for span
+#include <stop_token>        // for stop_token
+#include <string>            // for basic_string
+#include <system_error>      // for errc
+#include <thread>            // for sleep_for
+#include <type_traits>       // for is_same_v
+#include <unordered_map>     // for unordered_map
+#include <utility>           // for pair
+#include <vector>            // for vector
+
+#include "cpr/cprtypes.h"// for Header, Url
 #include "json/json.hpp" // for json_ref
 
-#include "gain_capital_exception.h"// for GCException
+#include "gain_capital_active_orders.h"// for GCActiveOrderTracker
+#include "gain_capital_breaker.h"      // for GCCircuitBreaker, GCBreakerStats
+#include "gain_capital_cache.h"        // for GCResponseCache
+#include "gain_capital_deadline.h"     // for GCDeadline, GCDeadlineScope
+#include "gain_capital_exception.h"    // for GCException, GCErrorCode
+#include "gain_capital_json.h"         // for read_number
+#include "gain_capital_market_data.h"  // for parse_price_ticks, parse_price_bars
+#include "gain_capital_market_spec.h"  // for GCMarketSpec, parse_market_spec
+#include "gain_capital_metrics.h"      // for GCMetricsSnapshot
+#include "gain_capital_order.h"        // for GCOrderTemplate
+#include "gain_capital_order_manager.h"// for GCOrderManager
+#include "gain_capital_position_book.h"// for GCPositionBook
+#include "gain_capital_price.h"        // for GCPrice
+#include "gain_capital_reactor.h"      // for GCReactor
+#include "gain_capital_risk.h"         // for GCRiskEngine
+#include "gain_capital_session.h"      // for GCSessionStore
+#include "gain_capital_single_flight.h"// for GCSingleFlight
+#include "gain_capital_transport.h"    // for GCTransport, NetworkRequest, NetworkResponse
 
 namespace gaincapital
 {
 
+namespace
+{
+
+std::optional<GCPrice> read_price(nlohmann::json const& object, char const* key, std::uint8_t const decimals)
+{
+    /*
+     * Price strings are parsed straight into fixed point; JSON numbers are rounded to the market's decimals.
+     */
+    if (! object.contains(key))
+    {
+        return std::nullopt;
+    }
+    nlohmann::json const& value = object[key];
+    if (value.is_number())
+    {
+        return GCPrice {value.get<double>(), decimals};
+    }
+    if (value.is_string())
+    {
+        return GCPrice::parse(value.get_ref<std::string const&>(), decimals);
+    }
+    return std::nullopt;
+}
+
+std::uint8_t price_decimals(std::optional<GCMarketSpec> const& spec) noexcept
+{
+    return spec ? spec->price_decimals : GCPrice::DEFAULT_DECIMALS;
+}
+
+std::expected<std::int64_t, GCException> to_int_id(std::string const& id, std::source_location const& location)
+{
+    std::int64_t value    = 0;
+    auto const [ptr, err] = std::from_chars(id.data(), id.data() + id.size(), value);
+    if (err != std::errc {} || ptr != id.data() + id.size())
+    {
+        return std::expected<std::int64_t, GCException> {std::unexpect, location.function_name(), "ID Must Be an Integer - ID: " + id};
+    }
+    return std::expected<std::int64_t, GCException> {value};
+}
+
+bool order_accepted(nlohmann::json const& json)
+{
+    // StatusReason 1 is OK; Any Other Reason Means the Server Left the Order Unchanged
+    return json.contains("StatusReason") && json["StatusReason"].is_number_integer() && json["StatusReason"] == 1;
+}
+
+template <typename Order>
+double signed_quantity(Order const& order)
+{
+    return (order.direction == "sell") ? -order.quantity : order.quantity;
+}
+
+template <typename Order>
+std::optional<std::string_view> conform_to_spec(Order& order, std::optional<GCMarketSpec> const& spec)
+{
+    /*
+     * Rescales prices to the market's decimals and checks the quantity; without a cached spec the order is sent as given.
+     */
+    if (! spec)
+    {
+        return std::nullopt;
+    }
+    if constexpr (std::is_same_v<Order, StopLimitOrder>)
+    {
+        auto const rescale  = [&spec](GCPrice const& price) { return price.rescale(spec->price_decimals); };
+        order.trigger_price = rescale(order.trigger_price);
+        order.stop_price    = order.stop_price.transform(rescale);
+        order.limit_price   = order.limit_price.transform(rescale);
+    }
+    return spec->check_quantity(signed_quantity(order));
+}
+
+std::optional<GCPrice> read_tick_price(nlohmann::json const& prices, std::uint8_t const decimals)
+{
+    if (! prices.contains("PriceTicks") || ! prices["PriceTicks"].is_array() || prices["PriceTicks"].empty())
+    {
+        return std::nullopt;
+    }
+    return read_price(prices["PriceTicks"][0], "Price", decimals);
+}
+
+GCException deadline_exceeded(std::source_location const& location)
+{
+    return GCException {location.function_name(), "Deadline Exceeded", GCErrorCode::DeadlineExceeded};
+}
+
+GCException circuit_open(std::source_location const& location)
+{
+    return GCException {location.function_name(), "Circuit Open", GCErrorCode::CircuitOpen};
+}
+
+}// namespace
+
 GCClient::GCClient(std::string const& username, std::string const& password, std::string const& apikey)
 {
     auth_payload = {{"UserName", username}, {"Password", password}, {"AppKey", apikey}};
@@ -40,6 +162,7 @@ std::expected<bool, GCException> GCClient::authenticate_session()
     /*
      * The first authentication of the user.
      * This method MUST run before any other API request.
+     * Concurrent callers are serialized; requests already in flight keep the previous session snapshot.
      */
     auto validation_response = validate_auth_payload();
     if (! validation_response)
@@ -47,10 +170,39 @@ std::expected<bool, GCException> GCClient::authenticate_session()
         return validation_response;
     }
 
+    std::lock_guard<std::mutex> const lock {session_store->writer_mutex()};
+    return log_on(std::source_location::current());
+}
+
+std::expected<bool, GCException> GCClient::reauthenticate_session(std::uint64_t const stale_generation)
+{
+    /*
+     * Logs on again unless another thread has already replaced the session stale_generation refers to.
+     * The generation is checked under the writer mutex, so racing callers produce a single logon.
+     */
+    auto validation_response = validate_auth_payload();
+    if (! validation_response)
+    {
+        return validation_response;
+    }
+
+    std::lock_guard<std::mutex> const lock {session_store->writer_mutex()};
+    if (session_store->load()->generation != stale_generation)
+    {
+        return std::expected<bool, GCException> {true};
+    }
+    return log_on(std::source_location::current());
+}
+
+std::expected<bool, GCException> GCClient::log_on(std::source_location const& location)
+{
+    /*
+     * Runs under the session writer mutex and publishes the new session.
+     */
     cpr::Header const headers {{"Content-Type", "application/json"}};
     cpr::Url const url {rest_url_v2 + "/Session"};
 
-    auto const network_response = make_network_call(headers, url, auth_payload.dump(), "POST");
+    auto const network_response = make_network_call(headers, url, auth_payload.dump(), "POST", location);
 
     if (! network_response)
     {
@@ -61,11 +213,13 @@ std::expected<bool, GCException> GCClient::authenticate_session()
 
     if (! json["statusCode"].is_number_integer() || json["statusCode"] != 0)
     {
-        return std::expected<bool, GCException> {std::unexpect, std::source_location::current().function_name(),
+        return std::expected<bool, GCException> {std::unexpect, location.function_name(),
                                                  "API Response is Valid, but Gain Capital Status Code Error: " + json["statusCode"].dump()};
     }
 
-    session_header = {{"Content-Type", "application/json"}, {"UserName", auth_payload["UserName"]}, {"Session", json["session"].dump()}};
+    session_store->publish(GCSession {
+        {{"Content-Type", "application/json"}, {"UserName", auth_payload["UserName"]}, {"Session", json["session"].dump()}},
+        CLASS_trading_account_id, CLASS_client_account_id, 0, std::chrono::steady_clock::now()});
 
     if (CLASS_client_account_id.empty() || CLASS_trading_account_id.empty())
     {
@@ -83,10 +237,12 @@ std::expected<bool, GCException> GCClient::set_trading_account_id()
 {
     /*
      * Sets the member variables CLASS_trading_account_id & CLASS_client_account_id.
+     * Runs under the session writer mutex and republishes the session with the account IDs.
      */
+    auto const session = session_store->load();
     cpr::Url const url {rest_url_v2 + "/userAccount/ClientAndTradingAccount"};
 
-    auto network_response = make_network_call(session_header, url, "", "GET");
+    auto network_response = make_network_call(session->header, url, "", "GET");
 
     if (! network_response)
     {
@@ -103,6 +259,7 @@ std::expected<bool, GCException> GCClient::set_trading_account_id()
         return std::expected<bool, GCException> {std::unexpect, std::source_location::current().function_name(),
                                                  "JSON Key Error - Response: " + json.dump()};
     }
+    session_store->publish(GCSession {session->header, CLASS_trading_account_id, CLASS_client_account_id, 0, session->created_at});
     return std::expected<bool, GCException> {true};
 }
 
@@ -110,6 +267,8 @@ std::expected<bool, GCException> GCClient::validate_session()
 {
     /*
      * Validates current session and updates if token expired.
+     * If another thread refreshed the session while this check was in flight, its result is reused.
+     * Skipped entirely while the keep-alive thread has validated the session within its interval.
      */
     auto validation_response = validate_session_header();
     if (! validation_response)
@@ -117,13 +276,28 @@ std::expected<bool, GCException> GCClient::validate_session()
         return validation_response;
     }
 
-    nlohmann::json payload = {{"ClientAccountId", CLASS_client_account_id},
-                              {"UserName", session_header["Username"]},
-                              {"Session", session_header["Session"]},
-                              {"TradingAccountId", CLASS_trading_account_id}};
+    if (session_store->recently_validated())
+    {
+        return std::expected<bool, GCException> {true};
+    }
+    return check_session();
+}
+
+std::expected<bool, GCException> GCClient::check_session()
+{
+    /*
+     * The validation round trip itself, re-authenticating when the server reports the token expired.
+     * The keep-alive thread calls it directly, so its refresh never clears the stamp ordinary calls rely on.
+     */
+    auto const session = session_store->load();
+
+    nlohmann::json payload = {{"ClientAccountId", session->client_account_id},
+                              {"UserName", session->header.at("UserName")},
+                              {"Session", session->header.at("Session")},
+                              {"TradingAccountId", session->trading_account_id}};
     cpr::Url const url {rest_url_v2 + "/Session/validate"};
 
-    auto network_response = make_network_call(session_header, url, payload.dump(), "POST");
+    auto network_response = make_network_call(session->header, url, payload.dump(), "POST");
 
     if (! network_response)
     {
@@ -134,15 +308,128 @@ std::expected<bool, GCException> GCClient::validate_session()
 
     if (json["isAuthenticated"].dump() != "true")
     {
-        auto authentication_response = authenticate_session();
+        auto authentication_response = reauthenticate_session(session->generation);
         if (! authentication_response)
         {
             return authentication_response;
         }
     }
+    else
+    {
+        session_store->mark_validated();
+    }
+    return std::expected<bool, GCException> {true};
+}
+
+std::expected<bool, GCException> GCClient::start_session_keep_alive(std::chrono::milliseconds const validate_interval,
+                                                                     std::chrono::milliseconds const max_session_age)
+{
+    /*
+     * Starts a background thread that validates the session every validate_interval and re-authenticates
+     * once the token is older than max_session_age (zero disables the age check).
+     * While it runs, ordinary calls trust its last validation instead of making their own round trip.
+     */
+    auto validation_response = validate_session_header();
+    if (! validation_response)
+    {
+        return validation_response;
+    }
+    if (validate_interval <= std::chrono::milliseconds::zero())
+    {
+        return std::expected<bool, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                 "Keep Alive Interval Must Be Positive"};
+    }
+
+    /* Twice the interval, so the stamp outlives a refresh that wakes late or takes a slow round trip */
+    stop_session_keep_alive();
+    session_store->set_validation_ttl(2 * validate_interval);
+
+    keep_alive_thread = std::jthread(
+        [this, validate_interval, max_session_age](std::stop_token const& stop_token)
+        {
+            std::mutex wait_mutex;
+            std::condition_variable_any wait_signal;
+            while (! stop_token.stop_requested())
+            {
+                {
+                    std::unique_lock<std::mutex> lock {wait_mutex};
+                    if (wait_signal.wait_for(lock, stop_token, validate_interval, [] { return false; }) || stop_token.stop_requested())
+                    {
+                        break;
+                    }
+                }
+                auto const session = session_store->load();
+                if (max_session_age > std::chrono::milliseconds::zero() && std::chrono::steady_clock::now() - session->created_at >= max_session_age)
+                {
+                    [[maybe_unused]] auto const authentication_response = reauthenticate_session(session->generation);
+                    continue;
+                }
+                [[maybe_unused]] auto const refresh_response = check_session();
+            }
+        });
+    // -------------------
+    return std::expected<bool, GCException> {true};
+}
+
+void GCClient::stop_session_keep_alive()
+{
+    if (keep_alive_thread.joinable())
+    {
+        keep_alive_thread.request_stop();
+        keep_alive_thread.join();
+    }
+    session_store->set_validation_ttl(std::chrono::milliseconds::zero());
+}
+
+std::expected<bool, GCException> GCClient::start_position_reconcile(std::chrono::milliseconds const interval)
+{
+    /*
+     * Starts a low-frequency background reconcile of the position book against the open positions endpoint.
+     * Between passes the book is kept current by local fills.
+     */
+    auto validation_response = validate_session_header();
+    if (! validation_response)
+    {
+        return validation_response;
+    }
+    if (interval <= std::chrono::milliseconds::zero())
+    {
+        return std::expected<bool, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                 "Reconcile Interval Must Be Positive"};
+    }
+
+    stop_position_reconcile();
+
+    position_reconcile_thread = std::jthread(
+        [this, interval](std::stop_token const& stop_token)
+        {
+            std::mutex wait_mutex;
+            std::condition_variable_any wait_signal;
+            while (! stop_token.stop_requested())
+            {
+                {
+                    std::unique_lock<std::mutex> lock {wait_mutex};
+                    if (wait_signal.wait_for(lock, stop_token, interval, [] { return false; }) || stop_token.stop_requested())
+                    {
+                        break;
+                    }
+                }
+                [[maybe_unused]] auto const reconcile_response = reconcile_positions();
+            }
+        });
+    // -------------------
     return std::expected<bool, GCException> {true};
 }
 
+void GCClient::stop_position_reconcile()
+{
+    if (position_reconcile_thread.joinable())
+    {
+        position_reconcile_thread.request_stop();
+        position_reconcile_thread.join();
+    }
+}
+
 // =================================================================================================================
 // API CALLS
 // =================================================================================================================
@@ -158,9 +445,10 @@ std::expected<nlohmann::json, GCException> GCClient::get_account_info()
         return validation_response;
     }
 
+    auto const session = session_store->load();
     cpr::Url const url {rest_url_v2 + "/userAccount/ClientAndTradingAccount"};
     // -------------------
-    return make_network_call(session_header, url, "", "GET");
+    return make_network_call(session->header, url, "", "GET");
 }
 
 std::expected<nlohmann::json, GCException> GCClient::get_margin_info()
@@ -175,9 +463,10 @@ std::expected<nlohmann::json, GCException> GCClient::get_margin_info()
         return validation_response;
     }
 
-    cpr::Url const url {rest_url_v2 + "/margin/clientAccountMargin?clientAccountId=" + CLASS_client_account_id};
+    auto const session = session_store->load();
+    cpr::Url const url {rest_url_v2 + "/margin/clientAccountMargin?clientAccountId=" + session->client_account_id};
     // -------------------
-    return make_network_call(session_header, url, "", "GET");
+    return make_network_call(session->header, url, "", "GET");
 }
 
 std::expected<nlohmann::json, GCException> GCClient::get_market_id(std::string const& market_name)
@@ -193,9 +482,10 @@ std::expected<nlohmann::json, GCException> GCClient::get_market_id(std::string c
         return validation_response;
     }
 
+    auto const session = session_store->load();
     cpr::Url const url {rest_url + "/cfd/markets?MarketName=" + market_name};
 
-    auto network_response = make_network_call(session_header, url, "", "GET");
+    auto network_response = make_network_call(session->header, url, "", "GET");
 
     if (! network_response)
     {
@@ -211,7 +501,10 @@ std::expected<nlohmann::json, GCException> GCClient::get_market_id(std::string c
         return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
                                                            "JSON Key Error - Response: " + json.dump()};
     }
-    market_id_map[market_name] = market_id;
+    {
+        std::unique_lock<std::shared_mutex> const lock {*market_id_mutex};
+        market_id_map[market_name] = market_id;
+    }
     // -------------------
     return std::expected<nlohmann::json, GCException> {market_id};
 }
@@ -229,65 +522,122 @@ std::expected<nlohmann::json, GCException> GCClient::get_market_info(std::string
         return validation_response;
     }
 
+    auto const session = session_store->load();
     cpr::Url const url {rest_url + "/cfd/markets?MarketName=" + market_name};
     // -------------------
-    return make_network_call(session_header, url, "", "GET");
+    return make_network_call(session->header, url, "", "GET");
 }
 
-std::expected<nlohmann::json, GCException> GCClient::get_prices(std::string const& market_name, std::size_t const num_ticks,
-                                                                std::size_t const from_ts, std::size_t const to_ts, std::string price_type)
+std::expected<std::size_t, GCException> GCClient::load_market_specs(std::vector<std::string> const& market_names)
 {
     /*
-     * Get prices
-     * :param market_name: market name (e.g. USD/CAD)
-     * :param num_ticks: number of price ticks/data to retrieve
-     * :param from_ts: from timestamp UTC
-     * :param to_ts: to timestamp UTC
-     * :return: price data
+     * Fills the market spec cache for every watched market in two concurrent rounds: the market IDs not yet
+     * cached, then each market's information. Specs that load are published even when others fail.
+     * :market_names: market names (e.g. USD/CAD)
+     * :return: number of specs loaded
      */
     auto validation_response = validate_session_header();
     if (! validation_response)
     {
-        return validation_response;
+        return std::expected<std::size_t, GCException> {std::unexpect, std::move(validation_response.error())};
     }
-    // -------------------
-    std::transform(price_type.begin(), price_type.end(), price_type.begin(), ::toupper);
 
-    if (price_type != "BID" && price_type != "ASK" && price_type != "MID")
+    auto const session              = session_store->load();
+    auto const location             = std::source_location::current();
+    std::size_t const max_in_flight = std::max<std::size_t>(market_names.size(), 1);
+    std::optional<GCException> first_error;
+    auto const record_error = [&first_error](GCException const& error)
     {
-        return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
-                                                           "Price Type Error - Provide one of the following price types: 'ASK', 'BID', 'MID'"};
+        if (! first_error)
+        {
+            first_error = error;
+        }
+    };
+
+    std::vector<std::string> id_lookups;
+    std::vector<std::pair<cpr::Url, std::string>> requests;
+    {
+        std::shared_lock<std::shared_mutex> const lock {*market_id_mutex};
+        for (std::string const& market_name : market_names)
+        {
+            if (! market_id_map.contains(market_name))
+            {
+                id_lookups.push_back(market_name);
+                requests.emplace_back(cpr::Url {rest_url + "/cfd/markets?MarketName=" + market_name}, "");
+            }
+        }
     }
-    // -------------------
-    auto market_id_response = return_market_id(market_name);
-    if (! market_id_response)
+    auto id_responses = make_network_calls(session->header, requests, "GET", max_in_flight, location);
+    for (std::size_t i = 0; i < id_lookups.size(); ++i)
     {
-        return std::expected<nlohmann::json, GCException> {std::unexpect, std::move(market_id_response.error())};
+        nlohmann::json const* market = (id_responses[i] && id_responses[i].value().contains("Markets") &&
+                                        id_responses[i].value()["Markets"].is_array() && ! id_responses[i].value()["Markets"].empty())
+                                           ? &id_responses[i].value()["Markets"][0]
+                                           : nullptr;
+        if (market == nullptr || ! market->contains("MarketId"))
+        {
+            record_error(id_responses[i] ? GCException {location.function_name(), "Failure Fetching Market ID - " + id_lookups[i]}
+                                         : id_responses[i].error());
+            continue;
+        }
+        std::unique_lock<std::shared_mutex> const lock {*market_id_mutex};
+        market_id_map[id_lookups[i]] = (*market)["MarketId"].dump();
     }
-    std::string market_id = market_id_response.value();
-
-    cpr::Url url;
-    if (from_ts != 0 && to_ts != 0)
+    // -------------------
+    std::vector<std::string> spec_lookups;
+    requests.clear();
     {
-        url = cpr::Url {rest_url + "/market/" + market_id + "/tickhistorybetween?fromTimeStampUTC=" + std::to_string(from_ts) +
-                        "&toTimestampUTC=" + std::to_string(to_ts) + "&priceType=" + price_type};
+        std::shared_lock<std::shared_mutex> const lock {*market_id_mutex};
+        for (std::string const& market_name : market_names)
+        {
+            if (auto const it = market_id_map.find(market_name); it != market_id_map.end())
+            {
+                spec_lookups.push_back(market_name);
+                requests.emplace_back(cpr::Url {rest_url + "/market/" + it->second + "/information"}, "");
+            }
+        }
     }
-    else if (to_ts != 0)
+    auto spec_responses = make_network_calls(session->header, requests, "GET", max_in_flight, location);
+
+    std::vector<std::pair<std::string, GCMarketSpec>> specs;
+    for (std::size_t i = 0; i < spec_lookups.size(); ++i)
     {
-        url = cpr::Url {rest_url + "/market/" + market_id + "/tickhistorybefore?maxResults=" + std::to_string(num_ticks) +
-                        "&toTimestampUTC=" + std::to_string(to_ts) + "&priceType=" + price_type};
+        auto spec = spec_responses[i] ? parse_market_spec(spec_responses[i].value()) : std::nullopt;
+        if (! spec)
+        {
+            record_error(spec_responses[i] ? GCException {location.function_name(), "Market Information Malformed - " + spec_lookups[i]}
+                                           : spec_responses[i].error());
+            continue;
+        }
+        specs.emplace_back(spec_lookups[i], *spec);
     }
-    else if (from_ts != 0)
+    market_specs->publish(specs);
+    // -------------------
+    if (first_error)
     {
-        url = cpr::Url {rest_url + "/market/" + market_id + "/tickhistoryafter?maxResults=" + std::to_string(num_ticks) +
-                        "&fromTimestampUTC=" + std::to_string(from_ts) + "&priceType=" + price_type};
+        return std::expected<std::size_t, GCException> {std::unexpect, std::move(*first_error)};
     }
-    else
+    return std::expected<std::size_t, GCException> {specs.size()};
+}
+
+std::expected<nlohmann::json, GCException> GCClient::get_prices(std::string const& market_name, std::size_t const num_ticks,
+                                                                std::size_t const from_ts, std::size_t const to_ts, std::string price_type)
+{
+    /*
+     * Get prices
+     * :param market_name: market name (e.g. USD/CAD)
+     * :param num_ticks: number of price ticks/data to retrieve
+     * :param from_ts: from timestamp UTC
+     * :param to_ts: to timestamp UTC
+     * :return: price data
+     */
+    auto url_response = build_prices_url(market_name, num_ticks, from_ts, to_ts, std::move(price_type), std::source_location::current());
+    if (! url_response)
     {
-        url = cpr::Url {rest_url + "/market/" + market_id + "/tickhistory?PriceTicks=" + std::to_string(num_ticks) + "&priceType=" + price_type};
+        return std::expected<nlohmann::json, GCException> {std::unexpect, std::move(url_response.error())};
     }
     // -------------------
-    return make_network_call(session_header, url, "", "GET");
+    return make_network_call(session_store->load()->header, url_response.value(), "", "GET");
 }
 
 std::expected<nlohmann::json, GCException> GCClient::get_ohlc(std::string const& market_name, std::string interval, std::size_t const num_ticks,
@@ -302,76 +652,57 @@ std::expected<nlohmann::json, GCException> GCClient::get_ohlc(std::string const&
      * :param from_ts: from timestamp UTC :param to_ts: to timestamp UTC
      * :return: ohlc dataframe
      */
-    auto validation_response = validate_session_header();
-    if (! validation_response)
+    auto url_response = build_ohlc_url(market_name, std::move(interval), num_ticks, span, from_ts, to_ts, std::source_location::current());
+    if (! url_response)
     {
-        return validation_response;
+        return std::expected<nlohmann::json, GCException> {std::unexpect, std::move(url_response.error())};
     }
     // -------------------
-    std::transform(interval.begin(), interval.end(), interval.begin(), ::toupper);
-
-    std::array<int, 7> const SPAN_M           = {1, 2, 3, 5, 10, 15, 30};// Span intervals for minutes
-    std::array<int, 4> const SPAN_H           = {1, 2, 4, 8};            // Span intervals for hours
-    std::array<std::string, 5> const INTERVAL = {"HOUR", "MINUTE", "DAY", "WEEK", "MONTH"};
+    return make_network_call(session_store->load()->header, url_response.value(), "", "GET");
+}
 
-    if (std::find(INTERVAL.begin(), INTERVAL.end(), interval) == INTERVAL.end())
-    {
-        return std::expected<nlohmann::json, GCException> {
-            std::unexpect, std::source_location::current().function_name(),
-            "Interval Error - Provide one of the following intervals: 'HOUR', 'MINUTE', 'DAY', 'WEEK', 'MONTH'"};
-    }
-    // -------------------
-    if (interval == "HOUR")
-    {
-        if (std::find(SPAN_H.begin(), SPAN_H.end(), span) == SPAN_H.end())
-        {
-            return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
-                                                               "Span Hour Error - Provide one of the following spans: 1, 2, 4, 8"};
-        }
-    }
-    else if (interval == "MINUTE")
-    {
-        if (std::find(SPAN_M.begin(), SPAN_M.end(), span) == SPAN_M.end())
-        {
-            return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
-                                                               "Span Minute Error - Provide one of the following spans: 1, 2, 3, 5, 10, 15, 30"};
-        }
-    }
-    else
+std::expected<std::vector<GCPriceTick>, GCException> GCClient::get_tick_history(std::string const& market_name, std::size_t const num_ticks,
+                                                                                std::size_t const from_ts, std::size_t const to_ts,
+                                                                                std::string price_type)
+{
+    /*
+     * Typed get_prices. The response is decoded through the calling thread's arena instead of a heap-allocated json tree.
+     * :return: price ticks, oldest first
+     */
+    auto url_response = build_prices_url(market_name, num_ticks, from_ts, to_ts, std::move(price_type), std::source_location::current());
+    if (! url_response)
     {
-        span = 1;
+        return std::expected<std::vector<GCPriceTick>, GCException> {std::unexpect, std::move(url_response.error())};
     }
     // -------------------
-    auto market_id_response = return_market_id(market_name);
-    if (! market_id_response)
+    auto response = make_raw_network_call(session_store->load()->header, url_response.value(), "", "GET");
+    if (! response)
     {
-        return std::expected<nlohmann::json, GCException> {std::unexpect, std::move(market_id_response.error())};
+        return std::expected<std::vector<GCPriceTick>, GCException> {std::unexpect, std::move(response.error())};
     }
-    std::string market_id = market_id_response.value();
+    return parse_price_ticks(response.value().text, price_decimals(market_specs->find(market_name)));
+}
 
-    cpr::Url url;
-    if (from_ts != 0 && to_ts != 0)
-    {
-        url = cpr::Url {rest_url + "/market/" + market_id + "/barhistorybetween?interval=" + interval + "&span=" + std::to_string(span) +
-                        "&fromTimeStampUTC=" + std::to_string(from_ts) + "&toTimestampUTC=" + std::to_string(to_ts)};
-    }
-    else if (to_ts != 0)
-    {
-        url = cpr::Url {rest_url + "/market/" + market_id + "/barhistorybefore?interval=" + interval + "&span=" + std::to_string(span) +
-                        "&maxResults=" + std::to_string(num_ticks) + "&toTimestampUTC=" + std::to_string(to_ts)};
-    }
-    else if (from_ts != 0)
+std::expected<std::vector<GCPriceBar>, GCException> GCClient::get_bar_history(std::string const& market_name, std::string interval,
+                                                                              std::size_t const num_ticks, std::size_t span,
+                                                                              std::size_t const from_ts, std::size_t const to_ts)
+{
+    /*
+     * Typed get_ohlc. The response is decoded through the calling thread's arena instead of a heap-allocated json tree.
+     * :return: completed bars followed by the partial bar when present, oldest first
+     */
+    auto url_response = build_ohlc_url(market_name, std::move(interval), num_ticks, span, from_ts, to_ts, std::source_location::current());
+    if (! url_response)
     {
-        url = cpr::Url {rest_url + "/market/" + market_id + "/barhistoryafter?interval=" + interval + "&span=" + std::to_string(span) +
-                        "&maxResults=" + std::to_string(num_ticks) + "&fromTimestampUTC=" + std::to_string(from_ts)};
+        return std::expected<std::vector<GCPriceBar>, GCException> {std::unexpect, std::move(url_response.error())};
     }
-    else
+    // -------------------
+    auto response = make_raw_network_call(session_store->load()->header, url_response.value(), "", "GET");
+    if (! response)
     {
-        url = cpr::Url {rest_url + "/market/" + market_id + "/barhistory?interval=" + interval + "&span=" + std::to_string(span) +
-                        "&PriceBars=" + std::to_string(num_ticks)};
+        return std::expected<std::vector<GCPriceBar>, GCException> {std::unexpect, std::move(response.error())};
     }
-    // -------------------
-    return make_network_call(session_header, url, "", "GET");
+    return parse_price_bars(response.value().text, price_decimals(market_specs->find(market_name)));
 }
 
 std::expected<nlohmann::json, GCException> GCClient::trade_order(nlohmann::json& trade_map, std::string type, std::string tr_account_id)
@@ -406,7 +737,7 @@ std::expected<nlohmann::json, GCException> GCClient::trade_order(nlohmann::json&
 
     if (tr_account_id.empty())
     {
-        tr_account_id = CLASS_trading_account_id;
+        tr_account_id = session_store->load()->trading_account_id;
     }
     // -------------------
     std::transform(type.begin(), type.end(), type.begin(), ::toupper);
@@ -424,124 +755,201 @@ std::expected<nlohmann::json, GCException> GCClient::trade_order(nlohmann::json&
     {
         return std::expected<nlohmann::json, GCException> {std::unexpect, std::move(market_id_response.error())};
     }
-    std::string market_id = market_id_response.value();
+    std::string market_id    = market_id_response.value();
+    auto const int_market_id = to_int_id(market_id, std::source_location::current());
+    if (! int_market_id)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, int_market_id.error()};
+    }
 
     // Check Trade Map Has Required Fields
-    if (trade_map[market_name]["Direction"].dump() == "null")
+    nlohmann::json const& order_map = trade_map[market_name];
+    auto const direction            = order_map.contains("Direction") && order_map["Direction"].is_string()
+                                          ? std::optional<std::string> {order_map["Direction"].get<std::string>()}
+                                          : std::nullopt;
+    auto const spec                 = market_specs->find(market_name);
+    std::uint8_t const decimals     = price_decimals(spec);
+    auto const quantity             = read_number(order_map, "Quantity");
+    auto const trigger_price        = read_price(order_map, "TriggerPrice", decimals);
+
+    if (! direction)
     {
         return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
                                                            "Direction Required for All Orders"};
     }
-    if (trade_map[market_name]["Quantity"].dump() == "null")
+    if (! quantity)
     {
         return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
                                                            "Quantity Required for All Orders"};
     }
-    if (type == "LIMIT" && trade_map[market_name]["TriggerPrice"].dump() == "null")
+    if (type == "LIMIT" && ! trigger_price)
     {
         return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
                                                            "Trigger Price Required for Limit Orders"};
     }
-    // ---------------------------
-    std::vector<nlohmann::json> if_done;
-    if (type == "LIMIT")
+    // -------------------
+    if (type == "MARKET")
     {
-        if (trade_map[market_name]["StopPrice"].dump() != "null")
-        {
-            std::string const opp_direction = (trade_map[market_name]["Direction"] == "sell") ? "buy" : "sell";
-            if_done.emplace_back(nlohmann::json {{"Stop",
-                                                  {{"TriggerPrice", trade_map[market_name]["StopPrice"].dump()},
-                                                   {"Direction", opp_direction},
-                                                   {"Quantity", trade_map[market_name]["Quantity"].dump()}}}});
-        }
-
-        if (trade_map[market_name]["LimitPrice"].dump() != "null")
+        MarketOrder const order {market_name, *direction, *quantity};
+        if (auto const reason = conform_to_spec(order, spec))
         {
-            std::string const opp_direction = (trade_map[market_name]["Direction"] == "sell") ? "buy" : "sell";
-            if_done.emplace_back(nlohmann::json {{"Limit",
-                                                  {{"TriggerPrice", trade_map[market_name]["LimitPrice"].dump()},
-                                                   {"Direction", opp_direction},
-                                                   {"Quantity", trade_map[market_name]["Quantity"].dump()}}}});
+            return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(), std::string(*reason)};
         }
+        std::uint64_t const client_order_id = order_manager->create(*int_market_id, signed_quantity(order), false);
+        GCOrderTemplate order_template {order, market_id, tr_account_id, order_manager->reference(client_order_id)};
+        return place_order(order_template, market_name, client_order_id, std::source_location::current());
     }
-    // -------------------
-    std::size_t current_time = (std::chrono::system_clock::now().time_since_epoch()).count() * std::chrono::system_clock::period::num /
-                               std::chrono::system_clock::period::den;
-    int const RETRY_SECONDS     = 5;
-    std::size_t const stop_time = current_time + RETRY_SECONDS;
-    while (current_time <= stop_time)
+    StopLimitOrder order {market_name, *direction, *quantity, *trigger_price, read_price(order_map, "StopPrice", decimals),
+                         read_price(order_map, "LimitPrice", decimals)};
+    if (auto const reason = conform_to_spec(order, spec))
     {
-        auto bid_response   = get_prices(market_name, 1, 0, 0, "BID");
-        auto offer_response = get_prices(market_name, 1, 0, 0, "ASK");
-
-        if (! bid_response || ! offer_response)
-        {
-            return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
-                                                               "Failure Fetching Prices"};
-        }
-        nlohmann::json bid_json   = bid_response.value();
-        nlohmann::json offer_json = offer_response.value();
+        return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(), std::string(*reason)};
+    }
+    std::uint64_t const client_order_id = order_manager->create(*int_market_id, signed_quantity(order), true, order.trigger_price.to_double());
+    GCOrderTemplate order_template {order, market_id, tr_account_id, order_manager->reference(client_order_id)};
+    return place_order(order_template, market_name, client_order_id, std::source_location::current());
+}
 
-        std::string bid_price {};
-        std::string offer_price {};
+std::expected<nlohmann::json, GCException> GCClient::trade_order(MarketOrder const& order, std::string tr_account_id)
+{
+    /*
+     * Typed market order; the payload is serialized once and only the prices are refreshed between retries.
+     */
+    auto validation_response = validate_session_header();
+    if (! validation_response)
+    {
+        return validation_response;
+    }
 
-        if (bid_json["PriceTicks"][0]["Price"].dump() != "null" && offer_json["PriceTicks"][0]["Price"].dump() != "null")
-        {
-            bid_price   = bid_json["PriceTicks"][0]["Price"].dump();
-            offer_price = offer_json["PriceTicks"][0]["Price"].dump();
-        }
-        else
-        {
-            return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
-                                                               "JSON Key Error in Fetching Prices - Response: " + bid_json.dump()};
-        }
-        // -------------------
-        nlohmann::json trade_payload = {
-            {"Direction", trade_map[market_name]["Direction"]},
-            // {"AuditId", audit_id},
-            {"MarketId", market_id},
-            {"Quantity", trade_map[market_name]["Quantity"].dump()},
-            {"MarketName", market_name},
-            {"TradingAccountId", tr_account_id},
-            {"OfferPrice", offer_price},
-            {"BidPrice", bid_price},
-        };
-
-        if (type == "LIMIT")
-        {
-            nlohmann::json additional_payload = {{"TriggerPrice", trade_map[market_name]["TriggerPrice"].dump()}, {"IfDone", if_done}};
-            trade_payload.update(additional_payload);
-        }
-        else
-        {
-            nlohmann::json additional_payload = {{"PriceTolerance", "0"}};
-            trade_payload.update(additional_payload);
-        }
-        // -------------------
-        cpr::Url const url = (type == "MARKET") ? cpr::Url {rest_url + "/order/newtradeorder"} : cpr::Url {rest_url + "/order/newstoplimitorder"};
+    if (tr_account_id.empty())
+    {
+        tr_account_id = session_store->load()->trading_account_id;
+    }
+    // -------------------
+    auto market_id_response = return_market_id(order.market_name);
+    if (! market_id_response)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, std::move(market_id_response.error())};
+    }
+    auto const market_id = to_int_id(market_id_response.value(), std::source_location::current());
+    if (! market_id)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, market_id.error()};
+    }
+    if (auto const reason = conform_to_spec(order, market_specs->find(order.market_name)))
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(), std::string(*reason)};
+    }
+    // -------------------
+    std::uint64_t const client_order_id = order_manager->create(*market_id, signed_quantity(order), false);
+    GCOrderTemplate order_template {order, market_id_response.value(), tr_account_id, order_manager->reference(client_order_id)};
+    return place_order(order_template, order.market_name, client_order_id, std::source_location::current());
+}
 
-        auto network_response = make_network_call(session_header, url, trade_payload.dump(), "POST");
+std::expected<nlohmann::json, GCException> GCClient::trade_order(StopLimitOrder const& order, std::string tr_account_id)
+{
+    /*
+     * Typed stop / limit order with optional if-done stop and limit legs.
+     */
+    auto validation_response = validate_session_header();
+    if (! validation_response)
+    {
+        return validation_response;
+    }
 
-        if (! network_response)
-        {
-            return network_response;
-        }
+    if (tr_account_id.empty())
+    {
+        tr_account_id = session_store->load()->trading_account_id;
+    }
+    // -------------------
+    auto market_id_response = return_market_id(order.market_name);
+    if (! market_id_response)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, std::move(market_id_response.error())};
+    }
+    auto const market_id = to_int_id(market_id_response.value(), std::source_location::current());
+    if (! market_id)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, market_id.error()};
+    }
+    StopLimitOrder conformed = order;
+    if (auto const reason = conform_to_spec(conformed, market_specs->find(order.market_name)))
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(), std::string(*reason)};
+    }
+    // -------------------
+    std::uint64_t const client_order_id = order_manager->create(*market_id, signed_quantity(conformed), true, conformed.trigger_price.to_double());
+    GCOrderTemplate order_template {conformed, market_id_response.value(), tr_account_id, order_manager->reference(client_order_id)};
+    return place_order(order_template, order.market_name, client_order_id, std::source_location::current());
+}
 
-        nlohmann::json json = network_response.value();
+std::expected<nlohmann::json, GCException> GCClient::amend_order(std::string const& order_id, StopLimitOrder const& order, std::string tr_account_id)
+{
+    /*
+     * Replaces the trigger price, quantity and IfDone legs of a working stop / limit order in a single request,
+     * instead of a cancel followed by a new order. No quote is fetched; the trigger price stands in for the
+     * bid and offer, which the server only uses for price tolerance on market orders. The amended order passes
+     * the risk checks as a resubmission, so it is not charged against the order rate, and with no quote the
+     * price band is not applied.
+     * :order_id: Order ID of the Order to Amend
+     * :param trading_acc_id: trading account ID
+     * :return JSON response
+     */
+    auto validation_response = validate_session_header();
+    if (! validation_response)
+    {
+        return validation_response;
+    }
 
-        if (json.contains("OrderId") && json["OrderId"].is_number_integer() || json["OrderId"] != 0)
-        {
-            return network_response;
-        }
-        // -----------------------
-        // Pause Before Retry
-        sleep(1);
-        current_time = (std::chrono::system_clock::now().time_since_epoch()).count() * std::chrono::system_clock::period::num /
-                       std::chrono::system_clock::period::den;
+    auto const session = session_store->load();
+    if (tr_account_id.empty())
+    {
+        tr_account_id = session->trading_account_id;
+    }
+    auto const amend_order_id = to_int_id(order_id, std::source_location::current());
+    if (! amend_order_id)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, amend_order_id.error()};
     }
     // -------------------
-    return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
-                                                       "Failed to Place Trade - Time Expired"};
+    auto market_id_response = return_market_id(order.market_name);
+    if (! market_id_response)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, std::move(market_id_response.error())};
+    }
+    auto const market_id = to_int_id(market_id_response.value(), std::source_location::current());
+    if (! market_id)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, market_id.error()};
+    }
+    StopLimitOrder conformed = order;
+    if (auto const reason = conform_to_spec(conformed, market_specs->find(order.market_name)))
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(), std::string(*reason)};
+    }
+    // -------------------
+    GCRiskResult const risk = risk_engine->check({*market_id, signed_quantity(conformed), conformed.trigger_price.to_double(), 0, 0}, false);
+    if (risk != GCRiskResult::Accepted)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                           "Risk Check Failed - " + std::string(GCRiskEngine::describe(risk))};
+    }
+    GCOrderTemplate order_template = GCOrderTemplate::amend(conformed, market_id_response.value(), tr_account_id, *amend_order_id);
+    cpr::Url const url {rest_url + std::string(order_template.endpoint())};
+
+    auto network_response =
+        make_network_call(session->header, url, order_template.render(conformed.trigger_price, conformed.trigger_price), "POST");
+    if (! network_response)
+    {
+        return network_response;
+    }
+    if (! order_accepted(network_response.value()))
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                           "Amend Not Accepted - Response: " + network_response.value().dump()};
+    }
+    order_manager->amend(*amend_order_id, signed_quantity(conformed), conformed.trigger_price.to_double());
+    return network_response;
 }
 
 std::expected<nlohmann::json, GCException> GCClient::list_open_positions(std::string tr_account_id)
@@ -557,20 +965,24 @@ std::expected<nlohmann::json, GCException> GCClient::list_open_positions(std::st
         return validate_response;
     }
 
+    auto const session = session_store->load();
     if (tr_account_id.empty())
     {
-        tr_account_id = CLASS_trading_account_id;
+        tr_account_id = session->trading_account_id;
     }
 
     cpr::Url const url {rest_url + "/order/openpositions?TradingAccountId=" + tr_account_id};
     // -------------------
-    return make_network_call(session_header, url, "", "GET");// ["OpenPositions"]
+    return make_network_call(session->header, url, "", "GET");// ["OpenPositions"]
 }
 
 std::expected<nlohmann::json, GCException> GCClient::list_active_orders(std::string tr_account_id)
 {
     /*
      * List of Active Order in the trading account.
+     * The endpoint only takes a MaxResults window, so the window starts one page above the last listing's size
+     * and doubles whenever a response fills it, until the whole book fits. A book that still fills the largest
+     * window is reported as an error rather than returned truncated.
      * :param trading_acc_id: trading account ID
      * :return JSON response
      */
@@ -580,15 +992,69 @@ std::expected<nlohmann::json, GCException> GCClient::list_active_orders(std::str
         return validate_response;
     }
 
+    auto const session = session_store->load();
     if (tr_account_id.empty())
     {
-        tr_account_id = CLASS_trading_account_id;
+        tr_account_id = session->trading_account_id;
     }
 
     cpr::Url const url {rest_url + "/order/activeorders"};
-    nlohmann::json active_order_payload = {{"TradingAccountId", tr_account_id}, {"MaxResults", "100"}};
-    // -------------------
-    return make_network_call(session_header, url, active_order_payload.dump(), "POST");// ["ActiveOrders"]
+    std::size_t window = active_orders->window(tr_account_id);
+    while (true)
+    {
+        nlohmann::json active_order_payload = {{"TradingAccountId", tr_account_id}, {"MaxResults", std::to_string(window)}};
+        // -------------------
+        auto network_response = make_network_call(session->header, url, active_order_payload.dump(), "POST");// ["ActiveOrders"]
+        if (! network_response)
+        {
+            return network_response;
+        }
+        nlohmann::json const& json = network_response.value();
+        if (! json.contains("ActiveOrders") || ! json["ActiveOrders"].is_array())
+        {
+            return network_response;
+        }
+        std::size_t const count = json["ActiveOrders"].size();
+        if (count < window)
+        {
+            active_orders->record_count(tr_account_id, count);
+            return network_response;
+        }
+        if (window >= GCActiveOrderTracker::MAX_WINDOW)
+        {
+            active_orders->record_count(tr_account_id, count);
+            return std::expected<nlohmann::json, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                               "Active Orders Truncated at " + std::to_string(window) + " Orders"};
+        }
+        window = std::min(window * 2, GCActiveOrderTracker::MAX_WINDOW);
+    }
+}
+
+std::expected<GCActiveOrdersDelta, GCException> GCClient::list_active_orders_delta(std::string tr_account_id)
+{
+    /*
+     * Active orders that were added, changed or removed since the previous delta call for the trading account.
+     * The first call reports every active order as added.
+     * :param trading_acc_id: trading account ID
+     * :return: delta against the previous snapshot
+     */
+    if (tr_account_id.empty())
+    {
+        tr_account_id = session_store->load()->trading_account_id;
+    }
+
+    auto active_orders_response = list_active_orders(tr_account_id);
+    if (! active_orders_response)
+    {
+        return std::expected<GCActiveOrdersDelta, GCException> {std::unexpect, std::move(active_orders_response.error())};
+    }
+    auto delta = active_orders->diff(tr_account_id, active_orders_response.value());
+    if (! delta)
+    {
+        std::string const error_message = "Active Orders Response Malformed - Response: " + active_orders_response.value().dump();
+        return std::expected<GCActiveOrdersDelta, GCException> {std::unexpect, std::source_location::current().function_name(), error_message};
+    }
+    return std::expected<GCActiveOrdersDelta, GCException> {std::move(delta.value())};
 }
 
 std::expected<nlohmann::json, GCException> GCClient::cancel_order(std::string const& order_id, std::string tr_account_id)
@@ -605,15 +1071,222 @@ std::expected<nlohmann::json, GCException> GCClient::cancel_order(std::string co
         return validate_response;
     }
 
+    auto const session = session_store->load();
     if (tr_account_id.empty())
     {
-        tr_account_id = CLASS_trading_account_id;
+        tr_account_id = session->trading_account_id;
+    }
+
+    auto const cancel_order_id = to_int_id(order_id, std::source_location::current());
+    if (! cancel_order_id)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, cancel_order_id.error()};
     }
 
     cpr::Url const url {rest_url + "/order/cancel"};
     nlohmann::json cancel_order_payload = {{"TradingAccountId", tr_account_id}, {"OrderId", order_id}};
     // -------------------
-    return make_network_call(session_header, url, cancel_order_payload.dump(), "POST");
+    order_manager->request_cancel(*cancel_order_id);
+    auto network_response = make_network_call(session->header, url, cancel_order_payload.dump(), "POST");
+    if (! network_response)
+    {
+        order_manager->withdraw_cancel(*cancel_order_id);
+    }
+    return network_response;
+}
+
+std::expected<std::vector<GCCancelResult>, GCException> GCClient::cancel_orders(std::span<std::string const> order_ids, std::string tr_account_id,
+                                                                                std::size_t const max_in_flight)
+{
+    /*
+     * Cancels several Active Orders, validating the session once and keeping at most max_in_flight cancels on the wire.
+     * :order_ids: Order IDs of the Orders to Cancel
+     * :param trading_acc_id: trading account ID
+     * :return: one result per order ID, in the order given
+     */
+    auto validate_response = validate_session();
+    if (! validate_response)
+    {
+        return std::expected<std::vector<GCCancelResult>, GCException> {std::unexpect, std::move(validate_response.error())};
+    }
+
+    auto const session = session_store->load();
+    if (tr_account_id.empty())
+    {
+        tr_account_id = session->trading_account_id;
+    }
+    // -------------------
+    return dispatch_cancels(session, order_ids, tr_account_id, max_in_flight, std::source_location::current());
+}
+
+std::expected<std::vector<GCCancelResult>, GCException> GCClient::cancel_all(std::string const& market_name, std::string tr_account_id,
+                                                                             std::size_t const max_in_flight)
+{
+    /*
+     * Cancels every Active Order, or only those in market_name when given.
+     * :param trading_acc_id: trading account ID
+     * :return: one result per cancelled order
+     */
+    std::int64_t market_id = 0;
+    if (! market_name.empty())
+    {
+        auto market_id_response = return_market_id(market_name);
+        if (! market_id_response)
+        {
+            return std::expected<std::vector<GCCancelResult>, GCException> {std::unexpect, std::move(market_id_response.error())};
+        }
+        auto const int_market_id = to_int_id(market_id_response.value(), std::source_location::current());
+        if (! int_market_id)
+        {
+            return std::expected<std::vector<GCCancelResult>, GCException> {std::unexpect, int_market_id.error()};
+        }
+        market_id = *int_market_id;
+    }
+
+    auto active_orders_response = list_active_orders(tr_account_id);
+    if (! active_orders_response)
+    {
+        return std::expected<std::vector<GCCancelResult>, GCException> {std::unexpect, std::move(active_orders_response.error())};
+    }
+    nlohmann::json const& json = active_orders_response.value();
+    if (! json.contains("ActiveOrders") || ! json["ActiveOrders"].is_array())
+    {
+        std::string const error_message = "Active Orders Response Malformed - Response: " + json.dump();
+        return std::expected<std::vector<GCCancelResult>, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                                        error_message};
+    }
+
+    // Market IDs Are Compared as Integers | A Numeric String Is Read the Same Way
+    auto const in_market = [market_id](nlohmann::json const& body)
+    {
+        if (! body.contains("MarketId"))
+        {
+            return false;
+        }
+        nlohmann::json const& value = body["MarketId"];
+        if (value.is_number_integer())
+        {
+            return value.get<std::int64_t>() == market_id;
+        }
+        if (value.is_string())
+        {
+            auto const entry_market_id = to_int_id(value.get_ref<std::string const&>(), std::source_location::current());
+            return entry_market_id && *entry_market_id == market_id;
+        }
+        return false;
+    };
+
+    std::vector<std::string> order_ids;
+    order_ids.reserve(json["ActiveOrders"].size());
+    for (nlohmann::json const& entry : json["ActiveOrders"])
+    {
+        auto const order_id        = GCActiveOrderTracker::read_order_id(entry);
+        nlohmann::json const* body = GCActiveOrderTracker::order_body(entry);
+        if (! order_id || (market_id != 0 && ! in_market(*body)))
+        {
+            continue;
+        }
+        order_ids.push_back(std::to_string(*order_id));
+    }
+
+    auto const session = session_store->load();
+    if (tr_account_id.empty())
+    {
+        tr_account_id = session->trading_account_id;
+    }
+    // -------------------
+    return dispatch_cancels(session, order_ids, tr_account_id, max_in_flight, std::source_location::current());
+}
+
+std::expected<std::size_t, GCException> GCClient::reconcile_positions(std::string tr_account_id)
+{
+    /*
+     * Corrects the position book from the open positions endpoint, touching only markets that differ.
+     * A market filled locally while the request was in flight is skipped and picked up by a later reconcile.
+     * :return: number of markets corrected
+     */
+    std::uint64_t const fill_stamp = position_book->fill_sequence();
+    auto open_positions_response   = list_open_positions(std::move(tr_account_id));
+    if (! open_positions_response)
+    {
+        return std::expected<std::size_t, GCException> {std::unexpect, std::move(open_positions_response.error())};
+    }
+    auto const corrections = position_book->reconcile(open_positions_response.value(), fill_stamp);
+    if (! corrections)
+    {
+        return std::expected<std::size_t, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                        "Open Positions Response Malformed - Response: " + open_positions_response.value().dump()};
+    }
+    return std::expected<std::size_t, GCException> {*corrections};
+}
+
+std::expected<bool, GCException> GCClient::reconcile_orders(std::string tr_account_id)
+{
+    /*
+     * Brings the local order table in line with the server's active orders, reconciling positions as well
+     * when an order left the list without a cancel.
+     * :return: true once applied
+     */
+    auto active_orders_response = list_active_orders(tr_account_id);
+    if (! active_orders_response)
+    {
+        return std::expected<bool, GCException> {std::unexpect, std::move(active_orders_response.error())};
+    }
+    auto const closed = order_manager->reconcile(active_orders_response.value());
+    if (! closed)
+    {
+        return std::expected<bool, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                 "Active Orders Response Malformed - Response: " + active_orders_response.value().dump()};
+    }
+    // -------------------
+    /* Orders that left the list are only booked as fills once the open positions show them */
+    if (*closed > 0)
+    {
+        auto reconcile_response = reconcile_positions(std::move(tr_account_id));
+        if (! reconcile_response)
+        {
+            return std::expected<bool, GCException> {std::unexpect, std::move(reconcile_response.error())};
+        }
+    }
+    return std::expected<bool, GCException> {true};
+}
+
+// =================================================================================================================
+// ASYNC API CALLS
+// =================================================================================================================
+
+void GCClient::get_prices_async(GCCallback callback, std::string const& market_name, std::size_t const num_ticks, std::size_t const from_ts,
+                                std::size_t const to_ts, std::string price_type)
+{
+    /*
+     * Non-blocking get_prices; the callback runs on the transport thread once the response arrives.
+     * An uncached market ID is still resolved on the calling thread.
+     */
+    auto url_response = build_prices_url(market_name, num_ticks, from_ts, to_ts, std::move(price_type), std::source_location::current());
+    if (! url_response)
+    {
+        callback(std::expected<nlohmann::json, GCException> {std::unexpect, std::move(url_response.error())});
+        return;
+    }
+    // -------------------
+    make_network_call_async(session_store->load()->header, url_response.value(), "", "GET", std::move(callback));
+}
+
+void GCClient::get_ohlc_async(GCCallback callback, std::string const& market_name, std::string interval, std::size_t const num_ticks,
+                              std::size_t span, std::size_t const from_ts, std::size_t const to_ts)
+{
+    /*
+     * Non-blocking get_ohlc; the callback runs on the transport thread once the response arrives.
+     * An uncached market ID is still resolved on the calling thread.
+     */
+    auto url_response = build_ohlc_url(market_name, std::move(interval), num_ticks, span, from_ts, to_ts, std::source_location::current());
+    if (! url_response)
+    {
+        callback(std::expected<nlohmann::json, GCException> {std::unexpect, std::move(url_response.error())});
+        return;
+    }
+    // -------------------
+    make_network_call_async(session_store->load()->header, url_response.value(), "", "GET", std::move(callback));
 }
 
 // =================================================================================================================
@@ -623,17 +1296,391 @@ std::expected<nlohmann::json, GCException> GCClient::cancel_order(std::string co
 std::expected<nlohmann::json, GCException> GCClient::make_network_call(cpr::Header const& header, cpr::Url const& url, std::string const& payload,
                                                                        std::string const& type, std::source_location const& location)
 {
+    /*
+     * Returns by the call's deadline; a response still in flight at the deadline is discarded when it lands.
+     */
+    GCDeadline const deadline = request_deadline();
+    auto promise              = std::make_shared<std::promise<std::expected<nlohmann::json, GCException>>>();
+    auto future               = promise->get_future();
+
+    make_network_call_async(
+        header, url, payload, type, [promise](std::expected<nlohmann::json, GCException> response) { promise->set_value(std::move(response)); },
+        location);
+    // -------------------
+    if (deadline != NO_DEADLINE && future.wait_until(deadline) == std::future_status::timeout)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, deadline_exceeded(location)};
+    }
+    return future.get();
+}
+
+std::expected<NetworkResponse, GCException> GCClient::make_raw_network_call(cpr::Header const& header, cpr::Url const& url,
+                                                                           std::string const& payload, std::string const& type,
+                                                                           std::source_location const& location)
+{
+    /*
+     * Returns the undecoded body of a successful response for callers that parse it themselves.
+     * Bypasses the response cache and request coalescing, which both operate on decoded json.
+     */
+    GCDeadline const deadline = request_deadline();
+    auto promise              = std::make_shared<std::promise<NetworkResponse>>();
+    auto future               = promise->get_future();
+
+    metrics->record_request();
+    submit_request(NetworkRequest {type, url.str(), header, payload, deadline},
+                   [promise](NetworkResponse&& resp) { promise->set_value(std::move(resp)); });
+    if (deadline != NO_DEADLINE && future.wait_until(deadline) == std::future_status::timeout)
+    {
+        metrics->record_failure();
+        return std::expected<NetworkResponse, GCException> {std::unexpect, deadline_exceeded(location)};
+    }
+    NetworkResponse resp = future.get();
+    // -------------------
     int OK = 200;
-    cpr::Response resp;
-    if (type == "POST")
+    if (resp.status_code != OK)
+    {
+        metrics->record_failure();
+        return std::expected<NetworkResponse, GCException> {std::unexpect, std::move(parse_network_response(resp, location).error())};
+    }
+    return resp;
+}
+
+void GCClient::make_network_call_async(cpr::Header const& header, cpr::Url const& url, std::string const& payload, std::string const& type,
+                                       GCCallback callback, std::source_location const& location)
+{
+    /*
+     * GETs on endpoints with a configured TTL are answered from the response cache while fresh.
+     * Identical concurrent GETs are coalesced: only the first is sent and every caller receives its result.
+     * A GET whose GCDeadlineScope is tighter than the request timeout is sent on its own, so its deadline
+     * never cuts short another caller's request.
+     */
+    std::chrono::milliseconds const timeout = request_timeout.load(std::memory_order_relaxed);
+    GCDeadline const scope_deadline         = GCDeadlineScope::current();
+    GCDeadline const timeout_deadline
+        = (timeout > std::chrono::milliseconds::zero()) ? std::chrono::steady_clock::now() + timeout : NO_DEADLINE;
+    NetworkRequest request {type, url.str(), header, payload, std::min(scope_deadline, timeout_deadline)};
+
+    if (type != "GET")
+    {
+        metrics->record_request();
+        submit_request(std::move(request),
+                       [callback = std::move(callback), metrics = metrics, location](NetworkResponse&& resp)
+                       {
+                           auto response = parse_network_response(resp, location);
+                           if (! response)
+                           {
+                               metrics->record_failure();
+                           }
+                           callback(std::move(response));
+                       });
+        return;
+    }
+
+    std::string key                     = GCSingleFlight<GCCallback>::request_key(type, request.url, payload);
+    std::chrono::milliseconds const ttl = response_cache->ttl_for(request.url);
+    if (ttl > std::chrono::milliseconds::zero())
+    {
+        if (auto cached = response_cache->lookup(key))
+        {
+            metrics->record_cache_hit();
+            callback(std::expected<nlohmann::json, GCException> {std::move(*cached)});
+            return;
+        }
+        metrics->record_cache_miss();
+    }
+    // -------------------
+    auto on_response = [metrics = metrics, response_cache = response_cache, key, ttl, location](NetworkResponse const& resp)
+    {
+        auto response = parse_network_response(resp, location);
+        if (! response)
+        {
+            metrics->record_failure();
+        }
+        else if (ttl > std::chrono::milliseconds::zero())
+        {
+            response_cache->store(key, response.value(), ttl, resp.header);
+        }
+        return response;
+    };
+
+    if (! coalesce_requests.load(std::memory_order_relaxed) || scope_deadline < timeout_deadline)
+    {
+        metrics->record_request();
+        submit_request(std::move(request), [callback = std::move(callback), on_response = std::move(on_response)](NetworkResponse&& resp)
+                       { callback(on_response(resp)); });
+        return;
+    }
+
+    if (! single_flight->join(key, std::move(callback)))
+    {
+        return;
+    }
+
+    metrics->record_request();
+    submit_request(std::move(request),
+                   [single_flight = single_flight, key = std::move(key), on_response = std::move(on_response)](NetworkResponse&& resp)
+                   {
+                       auto response = on_response(resp);
+                       auto waiters  = single_flight->complete(key);
+                       for (std::size_t i = 0; i < waiters.size(); ++i)
+                       {
+                           (i + 1 == waiters.size()) ? waiters[i](std::move(response)) : waiters[i](response);
+                       }
+                   });
+}
+
+GCDeadline GCClient::request_deadline() const noexcept
+{
+    /*
+     * The thread's deadline scope, shortened to the client's request timeout from now.
+     */
+    std::chrono::milliseconds const timeout = request_timeout.load(std::memory_order_relaxed);
+    GCDeadline const deadline               = GCDeadlineScope::current();
+    if (timeout <= std::chrono::milliseconds::zero())
+    {
+        return deadline;
+    }
+    return std::min(deadline, std::chrono::steady_clock::now() + timeout);
+}
+
+void GCClient::submit_request(NetworkRequest request, NetworkCallback callback)
+{
+    /*
+     * Sends through the hedger while hedging is on, which passes anything it does not hedge straight on.
+     * An open circuit breaker answers on the calling thread instead; a hedged read counts once toward its breaker.
+     */
+    if (std::shared_ptr<GCCircuitBreaker> const current_breaker = breaker.load(std::memory_order_acquire))
+    {
+        auto permit = current_breaker->acquire(request.type, request.url);
+        if (! permit)
+        {
+            NetworkResponse rejected;
+            rejected.error_message = "Circuit Open";
+            rejected.circuit_open  = true;
+            callback(std::move(rejected));
+            return;
+        }
+        callback = [current_breaker, permit = std::move(*permit), callback = std::move(callback)](NetworkResponse&& resp)
+        {
+            current_breaker->record(permit, resp);
+            callback(std::move(resp));
+        };
+    }
+    std::shared_ptr<GCTransport> const current_transport = transport.load(std::memory_order_acquire);
+    if (std::shared_ptr<GCHedger> const current_hedger = hedger.load(std::memory_order_acquire))
+    {
+        current_hedger->submit(current_transport, std::move(request), std::move(callback));
+        return;
+    }
+    current_transport->submit(std::move(request), std::move(callback));
+}
+
+std::vector<std::expected<nlohmann::json, GCException>> GCClient::make_network_calls(cpr::Header const& header,
+                                                                                    std::vector<std::pair<cpr::Url, std::string>> const& requests,
+                                                                                    std::string const& type, std::size_t const max_in_flight,
+                                                                                    std::source_location const& location)
+{
+    /*
+     * Submits the requests through the reactor, which reuses its pooled connections, blocking for a free slot
+     * whenever max_in_flight are outstanding. Callbacks run on the reactor thread and only fill their own slot.
+     * :return: one response per request, in the order given
+     */
+    std::vector<std::expected<nlohmann::json, GCException>> responses(requests.size(), nlohmann::json {});
+    if (requests.empty())
     {
-        resp = cpr::Post(url, header, cpr::Body {payload});
+        return responses;
     }
-    else if (type == "GET")
+
+    std::counting_semaphore<> slots {static_cast<std::ptrdiff_t>(std::max<std::size_t>(max_in_flight, 1))};
+    std::latch remaining {static_cast<std::ptrdiff_t>(requests.size())};
+
+    for (std::size_t i = 0; i < requests.size(); ++i)
     {
-        resp = cpr::Get(url, header);
+        slots.acquire();
+        make_network_call_async(
+            header, requests[i].first, requests[i].second, type,
+            [&response = responses[i], &slots, &remaining](std::expected<nlohmann::json, GCException> network_response)
+            {
+                response = std::move(network_response);
+                slots.release();
+                remaining.count_down();
+            },
+            location);
     }
     // -------------------
+    remaining.wait();
+    return responses;
+}
+
+std::vector<GCCancelResult> GCClient::dispatch_cancels(std::shared_ptr<GCSession const> const& session, std::span<std::string const> order_ids,
+                                                       std::string const& tr_account_id, std::size_t const max_in_flight,
+                                                       std::source_location const& location)
+{
+    /*
+     * An order ID that is not an integer fails in its own result and is never sent.
+     */
+    cpr::Url const url {rest_url + "/order/cancel"};
+    std::vector<GCCancelResult> results;
+    std::vector<std::pair<cpr::Url, std::string>> requests;
+    std::vector<std::pair<std::size_t, std::int64_t>> sent;// result index, order ID
+    results.reserve(order_ids.size());
+    requests.reserve(order_ids.size());
+    sent.reserve(order_ids.size());
+    for (std::string const& order_id : order_ids)
+    {
+        auto cancel_order_id = to_int_id(order_id, location);
+        if (! cancel_order_id)
+        {
+            results.emplace_back(order_id, std::expected<nlohmann::json, GCException> {std::unexpect, std::move(cancel_order_id.error())});
+            continue;
+        }
+        sent.emplace_back(results.size(), *cancel_order_id);
+        results.emplace_back(order_id, nlohmann::json {});
+        requests.emplace_back(url, nlohmann::json {{"TradingAccountId", tr_account_id}, {"OrderId", order_id}}.dump());
+        order_manager->request_cancel(*cancel_order_id);
+    }
+    auto responses = make_network_calls(session->header, requests, "POST", max_in_flight, location);
+
+    for (std::size_t i = 0; i < sent.size(); ++i)
+    {
+        auto const [result_index, cancel_order_id] = sent[i];
+        if (! responses[i])
+        {
+            order_manager->withdraw_cancel(cancel_order_id);
+        }
+        results[result_index].response = std::move(responses[i]);
+    }
+    return results;
+}
+
+std::expected<nlohmann::json, GCException> GCClient::place_order(GCOrderTemplate& order_template, std::string const& market_name,
+                                                                 std::uint64_t const client_order_id, std::source_location const& location)
+{
+    /*
+     * Retries for up to five seconds, refreshing bid / offer each attempt until the server returns an order ID.
+     * Every attempt carries the same client Reference. When a resting order's submission fails in transit,
+     * the active order list is checked for that Reference before resending, so a lost response never
+     * produces a duplicate order. Each attempt passes the pre-trade risk checks against its quote before sending.
+     * A caller's deadline shorter than five seconds ends the retries early with a deadline error.
+     * An order that fails before it is sent is rejected; one sent without a usable reply is marked unknown.
+     */
+    cpr::Url const url {rest_url + std::string(order_template.endpoint())};
+    GCOrderRecord const record  = *order_manager->find(client_order_id);
+    bool const resting          = record.resting;
+    std::uint8_t const decimals = price_decimals(market_specs->find(market_name));
+    bool new_order              = true;
+
+    GCDeadline const caller_deadline = GCDeadlineScope::current();
+    GCDeadline const deadline        = std::min(caller_deadline, std::chrono::steady_clock::now() + std::chrono::seconds {5});
+    while (std::chrono::steady_clock::now() <= deadline)
+    {
+        auto bid_response   = get_prices(market_name, 1, 0, 0, "BID");
+        auto offer_response = get_prices(market_name, 1, 0, 0, "ASK");
+
+        if (! bid_response || ! offer_response)
+        {
+            order_manager->reject(client_order_id);
+            GCErrorCode const code = (bid_response ? offer_response : bid_response).error().code();
+            return std::expected<nlohmann::json, GCException> {std::unexpect, location.function_name(), "Failure Fetching Prices", code};
+        }
+        auto const bid_price   = read_tick_price(bid_response.value(), decimals);
+        auto const offer_price = read_tick_price(offer_response.value(), decimals);
+
+        if (! bid_price || ! offer_price)
+        {
+            order_manager->reject(client_order_id);
+            return std::expected<nlohmann::json, GCException> {std::unexpect, location.function_name(),
+                                                               "JSON Key Error in Fetching Prices - Response: " + bid_response.value().dump()};
+        }
+        // -------------------
+        /* Risk and the order book account in doubles; the quote stays fixed point up to the wire */
+        double const bid         = bid_price->to_double();
+        double const offer       = offer_price->to_double();
+        double const order_price = resting ? record.price : (record.signed_quantity < 0) ? bid : offer;
+        GCRiskResult const risk  = risk_engine->check({record.market_id, record.signed_quantity, order_price, bid, offer}, new_order);
+        new_order                = false;
+        if (risk != GCRiskResult::Accepted)
+        {
+            order_manager->reject(client_order_id);
+            return std::expected<nlohmann::json, GCException> {std::unexpect, location.function_name(),
+                                                               "Risk Check Failed - " + std::string(GCRiskEngine::describe(risk))};
+        }
+        order_manager->record_attempt(client_order_id, bid, offer);
+        auto network_response = make_network_call(session_store->load()->header, url, order_template.render(*bid_price, *offer_price), "POST");
+
+        if (! network_response)
+        {
+            // A Request the Circuit Breaker Rejected Never Reached the Server
+            if (network_response.error().code() == GCErrorCode::CircuitOpen)
+            {
+                order_manager->reject(client_order_id);
+                return network_response;
+            }
+            // A Market Order Never Shows in the Active Orders, so Only the Open Positions Can Settle It
+            if (! resting)
+            {
+                order_manager->mark_unknown(client_order_id);
+                return network_response;
+            }
+            auto active_orders_response = list_active_orders();
+            if (! active_orders_response)
+            {
+                order_manager->mark_unknown(client_order_id);
+                return network_response;
+            }
+            if (auto const order_id = order_manager->find_on_server(active_orders_response.value(), client_order_id))
+            {
+                order_manager->acknowledge(client_order_id, *order_id);
+                return std::expected<nlohmann::json, GCException> {nlohmann::json {{"OrderId", *order_id}}};
+            }
+        }
+        else
+        {
+            nlohmann::json json = network_response.value();
+
+            if (json.contains("OrderId") && json["OrderId"].is_number_integer() && json["OrderId"] != 0)
+            {
+                order_manager->acknowledge(client_order_id, json["OrderId"].get<std::int64_t>());
+                return network_response;
+            }
+        }
+        // -----------------------
+        // Pause Before Retry | Safe to Resend, the Server Has No Order With This Reference
+        std::this_thread::sleep_until(std::min(deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds {100}));
+    }
+    // -------------------
+    order_manager->reject(client_order_id);
+    if (deadline == caller_deadline)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, deadline_exceeded(location)};
+    }
+    return std::expected<nlohmann::json, GCException> {std::unexpect, location.function_name(), "Failed to Place Trade - Time Expired"};
+}
+
+std::shared_ptr<GCOrderManager> GCClient::make_order_manager(std::shared_ptr<GCPositionBook> const& position_book)
+{
+    /*
+     * Only an accepted market order is booked locally, at the side of the quote it crossed. Resting orders are
+     * booked when a position reconcile shows their fill, which in turn confirms them filled in the order table.
+     * The book holds the manager weakly so the two listeners do not keep each other alive.
+     */
+    auto order_manager = std::make_shared<GCOrderManager>();
+    order_manager->set_fill_listener([position_book](GCOrderRecord const& record)
+                                     { position_book->apply_fill(record.market_id, record.signed_quantity, record.price); });
+    position_book->set_correction_listener(
+        [weak_manager = std::weak_ptr<GCOrderManager> {order_manager}](std::int64_t const market_id, double const quantity_change)
+        {
+            if (auto const manager = weak_manager.lock())
+            {
+                [[maybe_unused]] auto const confirmed = manager->confirm_fills(market_id, quantity_change);
+            }
+        });
+    return order_manager;
+}
+
+std::expected<nlohmann::json, GCException> GCClient::parse_network_response(NetworkResponse const& resp, std::source_location const& location)
+{
+    int OK = 200;
     if (resp.status_code == OK)
     {
         nlohmann::json response;
@@ -648,6 +1695,14 @@ std::expected<nlohmann::json, GCException> GCClient::make_network_call(cpr::Head
         // -------------------
         return std::expected<nlohmann::json, GCException> {response};
     }
+    else if (resp.deadline_exceeded)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, deadline_exceeded(location)};
+    }
+    else if (resp.circuit_open)
+    {
+        return std::expected<nlohmann::json, GCException> {std::unexpect, circuit_open(location)};
+    }
     else if (! resp.status_code)
     {
         return std::expected<bool, GCException> {std::unexpect, location.function_name(),
@@ -660,23 +1715,144 @@ std::expected<nlohmann::json, GCException> GCClient::make_network_call(cpr::Head
     }
 }
 
-std::expected<std::string, GCException> GCClient::return_market_id(std::string const& market_name) 
+std::expected<cpr::Url, GCException> GCClient::build_prices_url(std::string const& market_name, std::size_t const num_ticks,
+                                                               std::size_t const from_ts, std::size_t const to_ts, std::string price_type,
+                                                               std::source_location const& location)
+{
+    auto validation_response = validate_session_header();
+    if (! validation_response)
+    {
+        return std::expected<cpr::Url, GCException> {std::unexpect, std::move(validation_response.error())};
+    }
+    // -------------------
+    std::transform(price_type.begin(), price_type.end(), price_type.begin(), ::toupper);
+
+    if (price_type != "BID" && price_type != "ASK" && price_type != "MID")
+    {
+        return std::expected<cpr::Url, GCException> {std::unexpect, location.function_name(),
+                                                     "Price Type Error - Provide one of the following price types: 'ASK', 'BID', 'MID'"};
+    }
+    // -------------------
+    auto market_id_response = return_market_id(market_name);
+    if (! market_id_response)
+    {
+        return std::expected<cpr::Url, GCException> {std::unexpect, std::move(market_id_response.error())};
+    }
+    std::string market_id = market_id_response.value();
+
+    if (from_ts != 0 && to_ts != 0)
+    {
+        return cpr::Url {rest_url + "/market/" + market_id + "/tickhistorybetween?fromTimeStampUTC=" + std::to_string(from_ts) +
+                         "&toTimestampUTC=" + std::to_string(to_ts) + "&priceType=" + price_type};
+    }
+    else if (to_ts != 0)
+    {
+        return cpr::Url {rest_url + "/market/" + market_id + "/tickhistorybefore?maxResults=" + std::to_string(num_ticks) +
+                         "&toTimestampUTC=" + std::to_string(to_ts) + "&priceType=" + price_type};
+    }
+    else if (from_ts != 0)
+    {
+        return cpr::Url {rest_url + "/market/" + market_id + "/tickhistoryafter?maxResults=" + std::to_string(num_ticks) +
+                         "&fromTimestampUTC=" + std::to_string(from_ts) + "&priceType=" + price_type};
+    }
+    return cpr::Url {rest_url + "/market/" + market_id + "/tickhistory?PriceTicks=" + std::to_string(num_ticks) + "&priceType=" + price_type};
+}
+
+std::expected<cpr::Url, GCException> GCClient::build_ohlc_url(std::string const& market_name, std::string interval, std::size_t const num_ticks,
+                                                             std::size_t span, std::size_t const from_ts, std::size_t const to_ts,
+                                                             std::source_location const& location)
 {
-    if (market_id_map.contains(market_name))
+    auto validation_response = validate_session_header();
+    if (! validation_response)
+    {
+        return std::expected<cpr::Url, GCException> {std::unexpect, std::move(validation_response.error())};
+    }
+    // -------------------
+    std::transform(interval.begin(), interval.end(), interval.begin(), ::toupper);
+
+    std::array<int, 7> const SPAN_M           = {1, 2, 3, 5, 10, 15, 30};// Span intervals for minutes
+    std::array<int, 4> const SPAN_H           = {1, 2, 4, 8};            // Span intervals for hours
+    std::array<std::string, 5> const INTERVAL = {"HOUR", "MINUTE", "DAY", "WEEK", "MONTH"};
+
+    if (std::find(INTERVAL.begin(), INTERVAL.end(), interval) == INTERVAL.end())
+    {
+        return std::expected<cpr::Url, GCException> {
+            std::unexpect, location.function_name(),
+            "Interval Error - Provide one of the following intervals: 'HOUR', 'MINUTE', 'DAY', 'WEEK', 'MONTH'"};
+    }
+    // -------------------
+    if (interval == "HOUR")
+    {
+        if (std::find(SPAN_H.begin(), SPAN_H.end(), span) == SPAN_H.end())
+        {
+            return std::expected<cpr::Url, GCException> {std::unexpect, location.function_name(),
+                                                         "Span Hour Error - Provide one of the following spans: 1, 2, 4, 8"};
+        }
+    }
+    else if (interval == "MINUTE")
+    {
+        if (std::find(SPAN_M.begin(), SPAN_M.end(), span) == SPAN_M.end())
+        {
+            return std::expected<cpr::Url, GCException> {std::unexpect, location.function_name(),
+                                                         "Span Minute Error - Provide one of the following spans: 1, 2, 3, 5, 10, 15, 30"};
+        }
+    }
+    else
+    {
+        span = 1;
+    }
+    // -------------------
+    auto market_id_response = return_market_id(market_name);
+    if (! market_id_response)
     {
-        return std::expected<std::string, GCException> {market_id_map[market_name]};
+        return std::expected<cpr::Url, GCException> {std::unexpect, std::move(market_id_response.error())};
+    }
+    std::string market_id = market_id_response.value();
+
+    if (from_ts != 0 && to_ts != 0)
+    {
+        return cpr::Url {rest_url + "/market/" + market_id + "/barhistorybetween?interval=" + interval + "&span=" + std::to_string(span) +
+                         "&fromTimeStampUTC=" + std::to_string(from_ts) + "&toTimestampUTC=" + std::to_string(to_ts)};
+    }
+    else if (to_ts != 0)
+    {
+        return cpr::Url {rest_url + "/market/" + market_id + "/barhistorybefore?interval=" + interval + "&span=" + std::to_string(span) +
+                         "&maxResults=" + std::to_string(num_ticks) + "&toTimestampUTC=" + std::to_string(to_ts)};
+    }
+    else if (from_ts != 0)
+    {
+        return cpr::Url {rest_url + "/market/" + market_id + "/barhistoryafter?interval=" + interval + "&span=" + std::to_string(span) +
+                         "&maxResults=" + std::to_string(num_ticks) + "&fromTimestampUTC=" + std::to_string(from_ts)};
+    }
+    return cpr::Url {rest_url + "/market/" + market_id + "/barhistory?interval=" + interval + "&span=" + std::to_string(span) +
+                     "&PriceBars=" + std::to_string(num_ticks)};
+}
+
+std::expected<std::string, GCException> GCClient::return_market_id(std::string const& market_name)
+{
+    {
+        std::shared_lock<std::shared_mutex> const lock {*market_id_mutex};
+        if (auto const it = market_id_map.find(market_name); it != market_id_map.end())
+        {
+            return std::expected<std::string, GCException> {it->second};
+        }
     }
     auto response = get_market_id(market_name);
-    if (market_id_map.contains(market_name))
     {
-        return std::expected<std::string, GCException> {market_id_map[market_name]};
+        std::shared_lock<std::shared_mutex> const lock {*market_id_mutex};
+        if (auto const it = market_id_map.find(market_name); it != market_id_map.end())
+        {
+            return std::expected<std::string, GCException> {it->second};
+        }
     }
-    return std::expected<std::string, GCException> {std::unexpect, std::source_location::current().function_name(), "Failure Fetching Market ID"};
+    GCErrorCode const code = response ? GCErrorCode::Unspecified : response.error().code();
+    return std::expected<std::string, GCException> {std::unexpect, std::source_location::current().function_name(), "Failure Fetching Market ID",
+                                                    code};
 }
 
 std::expected<bool, GCException> GCClient::validate_session_header() const
 {
-    if (session_header.empty())
+    if (session_store->load()->header.empty())
     {
         return std::expected<bool, GCException> {std::unexpect, std::source_location::current().function_name(),
                                                  "Session Not Authenticated, Run 'authenticate_session' Command"};
@@ -694,6 +1870,118 @@ std::expected<bool, GCException> GCClient::validate_auth_payload() const
     return std::expected<bool, GCException> {true};
 }
 
+std::shared_ptr<GCSession const> GCClient::get_session() const { return session_store->load(); }
+
+void GCClient::set_request_coalescing(bool const enabled) { coalesce_requests.store(enabled, std::memory_order_relaxed); }
+
+void GCClient::set_hedging(bool const enabled, GCHedgePolicy policy)
+{
+    /*
+     * Hedges GETs on the policy's endpoints, by default tick history, bar history and market lookups.
+     * Safe while requests run: each request holds the hedger it started with, so reads in flight finish
+     * under the previous setting.
+     */
+    hedger.store(enabled ? std::make_shared<GCHedger>(std::move(policy)) : nullptr, std::memory_order_release);
+}
+
+void GCClient::set_request_timeout(std::chrono::milliseconds const timeout)
+{
+    /*
+     * Bounds each request that has no shorter deadline from a GCDeadlineScope; zero leaves them unbounded.
+     * Safe while requests run; requests already sent keep the timeout they started with.
+     */
+    request_timeout.store(timeout, std::memory_order_relaxed);
+}
+
+void GCClient::set_circuit_breaker(bool const enabled, GCBreakerPolicy policy)
+{
+    /*
+     * Fails requests fast with GCErrorCode::CircuitOpen while their endpoint's breaker is open.
+     * Safe while requests run: each request records into the breaker it acquired its permit from.
+     */
+    breaker.store(enabled ? std::make_shared<GCCircuitBreaker>(std::move(policy)) : nullptr, std::memory_order_release);
+}
+
+std::vector<GCBreakerStats> GCClient::get_circuit_breaker_stats() const
+{
+    std::shared_ptr<GCCircuitBreaker> const current_breaker = breaker.load(std::memory_order_acquire);
+    return current_breaker ? current_breaker->stats() : std::vector<GCBreakerStats> {};
+}
+
+void GCClient::set_cache_ttl(std::string const& endpoint, std::chrono::milliseconds const ttl)
+{
+    /*
+     * Enables response caching for GETs whose path contains endpoint; a zero TTL disables it again.
+     * The server's Cache-Control header (no-store, no-cache, max-age) can only shorten the TTL.
+     */
+    response_cache->set_ttl(endpoint, ttl);
+}
+
+void GCClient::clear_response_cache() { response_cache->clear(); }
+
+void GCClient::set_active_orders_page_size(std::size_t const page_size) { active_orders->set_page_size(page_size); }
+
+void GCClient::set_risk_limits(GCRiskLimits const& limits) { risk_engine->set_limits(limits); }
+
+std::expected<bool, GCException> GCClient::set_market_risk_limits(std::string const& market_name, GCRiskLimits const& limits)
+{
+    auto market_id_response = return_market_id(market_name);
+    if (! market_id_response)
+    {
+        return std::expected<bool, GCException> {std::unexpect, std::move(market_id_response.error())};
+    }
+    auto const market_id = to_int_id(market_id_response.value(), std::source_location::current());
+    if (! market_id)
+    {
+        return std::expected<bool, GCException> {std::unexpect, market_id.error()};
+    }
+    risk_engine->set_market_limits(*market_id, limits);
+    return std::expected<bool, GCException> {true};
+}
+
+void GCClient::add_risk_rule(GCRiskRule rule) { risk_engine->add_rule(std::move(rule)); }
+
+std::optional<GCMarketSpec> GCClient::get_market_spec(std::string const& market_name) const { return market_specs->find(market_name); }
+
+GCOrderManager const& GCClient::get_order_manager() const { return *order_manager; }
+
+GCPositionBook const& GCClient::get_position_book() const { return *position_book; }
+
+GCMetricsSnapshot GCClient::get_metrics() const
+{
+    GCMetricsSnapshot snapshot  = metrics->snapshot();
+    snapshot.requests_coalesced = single_flight->coalesced();
+    if (std::shared_ptr<GCHedger> const current_hedger = hedger.load(std::memory_order_acquire))
+    {
+        GCHedgeStats const hedge_stats = current_hedger->stats();
+        snapshot.hedgeable_reads       = hedge_stats.hedgeable_reads;
+        snapshot.hedges_sent           = hedge_stats.hedges_sent;
+        snapshot.hedge_wins            = hedge_stats.hedge_wins;
+        snapshot.hedged_read_p99_us    = hedge_stats.hedged_read_p99_us;
+        snapshot.unhedged_read_p99_us  = hedge_stats.unhedged_read_p99_us;
+    }
+    if (std::shared_ptr<GCCircuitBreaker> const current_breaker = breaker.load(std::memory_order_acquire))
+    {
+        for (GCBreakerStats const& breaker_stats : current_breaker->stats())
+        {
+            snapshot.circuit_trips += breaker_stats.trips;
+            snapshot.circuit_rejections += breaker_stats.rejected;
+        }
+    }
+    return snapshot;
+}
+
+void GCClient::set_transport(std::shared_ptr<GCTransport> new_transport)
+{
+    /*
+     * Replaces the transport beneath every request, e.g. with a GCRecordingTransport wrapping get_transport()
+     * or a GCReplayTransport. Safe while requests run; requests in flight complete on the old transport.
+     */
+    transport.store(std::move(new_transport), std::memory_order_release);
+}
+
+std::shared_ptr<GCTransport> GCClient::get_transport() const { return transport.load(std::memory_order_acquire); }
+
 void GCClient::set_testing_rest_urls(std::string const& url) { rest_url = rest_url_v2 = url; }
 
 }// namespace gaincapital
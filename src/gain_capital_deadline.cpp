@@ -0,0 +1,27 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_deadline.h"
+
+#include <algorithm>// for min
+#include <chrono>   // for steady_clock, milliseconds
+
+namespace gaincapital
+{
+
+namespace
+{
+
+thread_local GCDeadline thread_deadline = NO_DEADLINE;
+
+}// namespace
+
+GCDeadlineScope::GCDeadlineScope(std::chrono::milliseconds const budget) : GCDeadlineScope(std::chrono::steady_clock::now() + budget) {}
+
+GCDeadlineScope::GCDeadlineScope(GCDeadline const deadline) : enclosing(thread_deadline) { thread_deadline = std::min(enclosing, deadline); }
+
+GCDeadlineScope::~GCDeadlineScope() { thread_deadline = enclosing; }
+
+GCDeadline GCDeadlineScope::current() noexcept { return thread_deadline; }
+
+}// namespace gaincapital
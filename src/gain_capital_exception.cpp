@@ -9,8 +9,8 @@
 namespace gaincapital
 {
 
-GCException::GCException(std::string func_name, std::string const& message)
-    : std::runtime_error {message}, func_name(std::move(func_name)), message(message)
+GCException::GCException(std::string func_name, std::string const& message, GCErrorCode const code)
+    : std::runtime_error {message}, func_name(std::move(func_name)), message(message), error_code(code)
 {
 }
 
@@ -18,4 +18,6 @@ char const* GCException::what() const noexcept { return message.c_str(); }
 
 char const* GCException::where() const noexcept { return func_name.c_str(); }
 
+GCErrorCode GCException::code() const noexcept { return error_code; }
+
 }// namespace gaincapital
@@ -0,0 +1,290 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_hedge.h"
+
+#include <algorithm>// for clamp, min, nth_element
+#include <array>    // for array
+#include <chrono>   // for steady_clock, microseconds, duration_cast
+#include <cmath>    // for llround
+#include <cstddef>  // for size_t
+#include <cstdint>  // for int64_t, uint64_t
+#include <memory>   // for shared_ptr, make_shared
+#include <mutex>    // for mutex, lock_guard, unique_lock
+#include <string>   // for basic_string
+#include <utility>  // for move
+#include <vector>   // for vector
+
+namespace gaincapital
+{
+
+namespace
+{
+
+constexpr std::size_t MIN_SAMPLES   = 32;
+constexpr std::size_t REFRESH_EVERY = 32;
+
+class LatencyWindow
+{
+    /* The most recent latencies in microseconds, overwritten oldest first */
+  public:
+    void record(std::int64_t const latency_us) noexcept { samples[count++ % CAPACITY] = latency_us; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return std::min(count, CAPACITY); }
+
+    [[nodiscard]] double percentile(double const q) const
+    {
+        std::size_t const n = size();
+        if (n == 0)
+        {
+            return 0;
+        }
+        std::vector<std::int64_t> sorted(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(n));
+        auto const nth = sorted.begin() + static_cast<std::ptrdiff_t>(std::min(n - 1, static_cast<std::size_t>(q * static_cast<double>(n))));
+        std::nth_element(sorted.begin(), nth, sorted.end());
+        return static_cast<double>(*nth);
+    }
+
+  private:
+    static constexpr std::size_t CAPACITY = 1024;
+
+    std::array<std::int64_t, CAPACITY> samples {};
+    std::size_t count {};
+};
+
+}// namespace
+
+struct GCHedger::Statistics
+{
+    GCHedgePolicy policy;
+    std::uint64_t holdout_every {};
+
+    std::mutex mutex;
+    LatencyWindow reads;
+    LatencyWindow hedged_reads;
+    LatencyWindow holdout_reads;
+    std::chrono::microseconds delay {};
+    std::size_t since_refresh {};
+    std::uint64_t hedgeable_reads {};
+    std::uint64_t hedges_sent {};
+    std::uint64_t hedge_wins {};
+};
+
+struct GCHedger::Race
+{
+    std::shared_ptr<Statistics> statistics;
+    std::shared_ptr<GCTransport> transport;
+    NetworkRequest request;
+    NetworkCallback callback;
+    std::chrono::steady_clock::time_point start;
+    bool holdout {};
+
+    std::mutex mutex;
+    std::uint64_t primary_id {};
+    std::uint64_t hedge_id {};
+    std::size_t outstanding {1};
+    bool hedged {};
+    bool hedge_answered {};
+    bool done {};
+};
+
+GCHedger::GCHedger(GCHedgePolicy policy) : statistics(std::make_shared<Statistics>())
+{
+    double const holdout      = policy.holdout_fraction;
+    statistics->holdout_every = holdout > 0 ? static_cast<std::uint64_t>(std::max(1LL, std::llround(1.0 / holdout))) : 0;
+    statistics->delay         = policy.max_delay;
+    statistics->policy        = std::move(policy);
+    timer_thread              = std::thread(&GCHedger::run, this);
+}
+
+GCHedger::~GCHedger()
+{
+    /*
+     * Pending hedge timers are dropped; their first attempts still complete and reach their callers.
+     */
+    {
+        std::lock_guard<std::mutex> const lock {timer_mutex};
+        stopping = true;
+    }
+    timer_ready.notify_one();
+    if (timer_thread.joinable())
+    {
+        timer_thread.join();
+    }
+}
+
+bool GCHedger::hedges(NetworkRequest const& request) const noexcept
+{
+    if (request.type != "GET")
+    {
+        return false;
+    }
+    for (std::string const& endpoint : statistics->policy.endpoints)
+    {
+        if (request.url.find(endpoint) != std::string::npos)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GCHedger::submit(std::shared_ptr<GCTransport> const& transport, NetworkRequest request, NetworkCallback callback)
+{
+    /*
+     * Sends the first attempt and arms its hedge timer. Reads on other endpoints, and holdout reads, go straight through.
+     */
+    if (! hedges(request))
+    {
+        transport->submit(std::move(request), std::move(callback));
+        return;
+    }
+    auto race        = std::make_shared<Race>();
+    race->statistics = statistics;
+    race->transport  = transport;
+    race->callback   = std::move(callback);
+    std::chrono::microseconds delay {};
+    {
+        std::lock_guard<std::mutex> const lock {statistics->mutex};
+        ++statistics->hedgeable_reads;
+        race->holdout = statistics->holdout_every != 0 && statistics->hedgeable_reads % statistics->holdout_every == 0;
+        delay         = statistics->delay;
+    }
+    if (! race->holdout)
+    {
+        race->request = request;
+    }
+    race->start            = std::chrono::steady_clock::now();
+    std::uint64_t const id =
+        transport->submit(std::move(request), [race](NetworkResponse&& response) { complete(race, false, std::move(response)); });
+    {
+        std::lock_guard<std::mutex> const lock {race->mutex};
+        race->primary_id = id;
+        if (race->done || race->holdout)
+        {
+            return;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> const lock {timer_mutex};
+        timers.emplace(race->start + delay, race);
+    }
+    timer_ready.notify_one();
+}
+
+std::chrono::microseconds GCHedger::hedge_delay() const
+{
+    std::lock_guard<std::mutex> const lock {statistics->mutex};
+    return statistics->delay;
+}
+
+GCHedgeStats GCHedger::stats() const
+{
+    std::lock_guard<std::mutex> const lock {statistics->mutex};
+    GCHedgeStats stats {};
+    stats.hedgeable_reads      = statistics->hedgeable_reads;
+    stats.hedges_sent          = statistics->hedges_sent;
+    stats.hedge_wins           = statistics->hedge_wins;
+    stats.hedged_read_p99_us   = statistics->hedged_reads.percentile(0.99);
+    stats.unhedged_read_p99_us = statistics->holdout_reads.percentile(0.99);
+    return stats;
+}
+
+void GCHedger::run()
+{
+    std::unique_lock<std::mutex> lock {timer_mutex};
+    while (! stopping)
+    {
+        if (timers.empty())
+        {
+            timer_ready.wait(lock);
+            continue;
+        }
+        auto const due = timers.begin()->first;
+        if (due > std::chrono::steady_clock::now())
+        {
+            timer_ready.wait_until(lock, due);
+            continue;
+        }
+        auto node = timers.extract(timers.begin());
+        lock.unlock();
+        send_hedge(node.mapped());
+        lock.lock();
+    }
+}
+
+void GCHedger::send_hedge(std::shared_ptr<Race> const& race)
+{
+    {
+        std::lock_guard<std::mutex> const lock {race->mutex};
+        if (race->done)
+        {
+            return;
+        }
+        Statistics& statistics = *race->statistics;
+        {
+            std::lock_guard<std::mutex> const statistics_lock {statistics.mutex};
+            if (static_cast<double>(statistics.hedges_sent) > statistics.policy.max_hedge_fraction * static_cast<double>(statistics.hedgeable_reads))
+            {
+                return;
+            }
+            ++statistics.hedges_sent;
+        }
+        race->hedged = true;
+        ++race->outstanding;
+    }
+    std::uint64_t const id =
+        race->transport->submit(NetworkRequest {race->request}, [race](NetworkResponse&& response) { complete(race, true, std::move(response)); });
+    // -------------------
+    // The First Attempt May Have Won Before the Hedge Had an ID to Cancel
+    bool finished = false;
+    {
+        std::lock_guard<std::mutex> const lock {race->mutex};
+        race->hedge_id = id;
+        finished       = race->done && ! race->hedge_answered;
+    }
+    if (finished)
+    {
+        race->transport->cancel(id);
+    }
+}
+
+void GCHedger::complete(std::shared_ptr<Race> const& race, bool const from_hedge, NetworkResponse&& response)
+{
+    NetworkCallback callback;
+    std::uint64_t loser = 0;
+    {
+        std::lock_guard<std::mutex> const lock {race->mutex};
+        --race->outstanding;
+        race->hedge_answered = race->hedge_answered || from_hedge;
+        if (race->done || (response.status_code == 0 && race->outstanding > 0))
+        {
+            return;
+        }
+        race->done = true;
+        callback   = std::move(race->callback);
+        loser      = from_hedge ? race->primary_id : (race->hedged ? race->hedge_id : 0);
+    }
+    if (loser != 0)
+    {
+        race->transport->cancel(loser);
+    }
+    // -------------------
+    auto const latency_us  = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - race->start).count();
+    Statistics& statistics = *race->statistics;
+    {
+        std::lock_guard<std::mutex> const lock {statistics.mutex};
+        statistics.reads.record(latency_us);
+        (race->holdout ? statistics.holdout_reads : statistics.hedged_reads).record(latency_us);
+        statistics.hedge_wins += from_hedge ? 1 : 0;
+        if (++statistics.since_refresh >= REFRESH_EVERY && statistics.reads.size() >= MIN_SAMPLES)
+        {
+            statistics.since_refresh = 0;
+            std::chrono::microseconds const observed {std::llround(statistics.reads.percentile(statistics.policy.percentile))};
+            statistics.delay = std::clamp<std::chrono::microseconds>(observed, statistics.policy.min_delay, statistics.policy.max_delay);
+        }
+    }
+    callback(std::move(response));
+}
+
+}// namespace gaincapital
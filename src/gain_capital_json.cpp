@@ -0,0 +1,44 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_json.h"
+
+#include <charconv>    // for from_chars
+#include <optional>    // for optional
+#include <string>      // for basic_string
+#include <system_error>// for errc
+
+#include "json/json.hpp"// for json
+
+namespace gaincapital
+{
+
+std::optional<double> read_number(nlohmann::json const& object, char const* key)
+{
+    /*
+     * Order and position fields may arrive as json numbers or numeric strings.
+     * :return: nullopt when the key is missing or its value is not a number
+     */
+    if (! object.contains(key))
+    {
+        return std::nullopt;
+    }
+    nlohmann::json const& value = object[key];
+    if (value.is_number())
+    {
+        return value.get<double>();
+    }
+    if (value.is_string())
+    {
+        std::string const& text = value.get_ref<std::string const&>();
+        double number           = 0;
+        auto const [ptr, err]   = std::from_chars(text.data(), text.data() + text.size(), number);
+        if (err == std::errc {} && ptr == text.data() + text.size())
+        {
+            return number;
+        }
+    }
+    return std::nullopt;
+}
+
+}// namespace gaincapital
@@ -0,0 +1,123 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_market_data.h"
+
+#include <charconv>       // for from_chars
+#include <cstdint>        // for int64_t, uint8_t
+#include <expected>       // for expected
+#include <source_location>// for source_location
+#include <string>         // for basic_string
+#include <string_view>    // for string_view
+#include <system_error>   // for errc
+#include <vector>         // for vector
+
+#include "json/json.hpp"// for json
+
+#include "gain_capital_arena.h"    // for GCArenaJson, GCArenaScope
+#include "gain_capital_exception.h"// for GCException
+#include "gain_capital_price.h"    // for GCPrice
+
+namespace gaincapital
+{
+
+std::expected<std::vector<GCPriceTick>, GCException> parse_price_ticks(std::string_view text, std::uint8_t const decimals,
+                                                                     std::source_location const& location)
+{
+    GCArenaScope const scope;
+    std::vector<GCPriceTick> ticks;
+    try
+    {
+        GCArenaJson const response       = GCArenaJson::parse(text);
+        GCArenaJson const& price_ticks = response.at("PriceTicks");
+        ticks.reserve(price_ticks.size());
+
+        for (GCArenaJson const& tick : price_ticks)
+        {
+            auto timestamp_response = parse_wcf_date(tick.at("TickDate").get_ref<GCArenaString const&>(), location);
+            if (! timestamp_response)
+            {
+                return std::expected<std::vector<GCPriceTick>, GCException> {std::unexpect, std::move(timestamp_response.error())};
+            }
+            ticks.emplace_back(timestamp_response.value(), GCPrice {tick.at("Price").get<double>(), decimals});
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        return std::expected<std::vector<GCPriceTick>, GCException> {std::unexpect, location.function_name(), e.what()};
+    }
+    // -------------------
+    return ticks;
+}
+
+std::expected<std::vector<GCPriceBar>, GCException> parse_price_bars(std::string_view text, std::uint8_t const decimals,
+                                                                   std::source_location const& location)
+{
+    GCArenaScope const scope;
+    std::vector<GCPriceBar> bars;
+    try
+    {
+        GCArenaJson const response    = GCArenaJson::parse(text);
+        GCArenaJson const& price_bars = response.at("PriceBars");
+        bars.reserve(price_bars.size() + 1);
+
+        auto const append_bar = [&bars, decimals, &location](GCArenaJson const& bar) -> std::expected<bool, GCException>
+        {
+            auto timestamp_response = parse_wcf_date(bar.at("BarDate").get_ref<GCArenaString const&>(), location);
+            if (! timestamp_response)
+            {
+                return std::expected<bool, GCException> {std::unexpect, std::move(timestamp_response.error())};
+            }
+            bars.emplace_back(timestamp_response.value(), GCPrice {bar.at("Open").get<double>(), decimals},
+                              GCPrice {bar.at("High").get<double>(), decimals}, GCPrice {bar.at("Low").get<double>(), decimals},
+                              GCPrice {bar.at("Close").get<double>(), decimals});
+            return std::expected<bool, GCException> {true};
+        };
+
+        for (GCArenaJson const& bar : price_bars)
+        {
+            auto bar_response = append_bar(bar);
+            if (! bar_response)
+            {
+                return std::expected<std::vector<GCPriceBar>, GCException> {std::unexpect, std::move(bar_response.error())};
+            }
+        }
+        /* The still-forming bar is reported separately from the completed history */
+        if (response.contains("PartialPriceBar") && ! response["PartialPriceBar"].is_null())
+        {
+            auto bar_response = append_bar(response["PartialPriceBar"]);
+            if (! bar_response)
+            {
+                return std::expected<std::vector<GCPriceBar>, GCException> {std::unexpect, std::move(bar_response.error())};
+            }
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        return std::expected<std::vector<GCPriceBar>, GCException> {std::unexpect, location.function_name(), e.what()};
+    }
+    // -------------------
+    return bars;
+}
+
+std::expected<std::int64_t, GCException> parse_wcf_date(std::string_view date, std::source_location const& location)
+{
+    /*
+     * Gain Capital encodes timestamps as WCF dates: "/Date(1414422604000)/", optionally with a "+0100" offset.
+     * The millisecond count is already UTC, so any offset is ignored.
+     */
+    auto const open = date.find('(');
+    if (open == std::string_view::npos)
+    {
+        return std::expected<std::int64_t, GCException> {std::unexpect, location.function_name(), "Date Format Error - " + std::string(date)};
+    }
+    std::int64_t timestamp_ms = 0;
+    auto const [ptr, err]     = std::from_chars(date.data() + open + 1, date.data() + date.size(), timestamp_ms);
+    if (err != std::errc {})
+    {
+        return std::expected<std::int64_t, GCException> {std::unexpect, location.function_name(), "Date Format Error - " + std::string(date)};
+    }
+    return timestamp_ms;
+}
+
+}// namespace gaincapital
@@ -0,0 +1,136 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_market_spec.h"
+
+#include <algorithm>    // for clamp
+#include <array>        // for array
+#include <atomic>       // for memory_order
+#include <cmath>        // for abs, fmod, round
+#include <cstdint>      // for int64_t, uint8_t
+#include <cstdlib>      // for strtod
+#include <memory>       // for make_shared
+#include <mutex>        // for lock_guard
+#include <optional>     // for optional
+#include <string>       // for basic_string
+#include <string_view>  // for string_view
+#include <unordered_map>// for unordered_map
+#include <utility>      // for pair
+#include <vector>       // for vector
+
+#include "json/json.hpp"// for json
+
+namespace gaincapital
+{
+
+namespace
+{
+
+constexpr std::array<double, 11> POWERS_OF_TEN {1, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10};
+constexpr double QUANTITY_EPSILON = 1e-9;
+
+double read_double(nlohmann::json const& object, char const* key)
+{
+    if (! object.contains(key))
+    {
+        return 0;
+    }
+    nlohmann::json const& value = object[key];
+    if (value.is_number())
+    {
+        return value.get<double>();
+    }
+    return value.is_string() ? std::strtod(value.get_ref<std::string const&>().c_str(), nullptr) : 0;
+}
+
+}// namespace
+
+double GCMarketSpec::round_price(double const price) const noexcept
+{
+    double const scale = POWERS_OF_TEN[std::min<std::size_t>(price_decimals, POWERS_OF_TEN.size() - 1)];
+    return std::round(price * scale) / scale;
+}
+
+std::optional<std::string_view> GCMarketSpec::check_quantity(double const signed_quantity) const noexcept
+{
+    /*
+     * :return: the reason the quantity is not tradable, or nullopt when it is
+     */
+    double const quantity = std::abs(signed_quantity);
+    if (min_quantity > 0 && quantity < min_quantity)
+    {
+        return "Quantity Below Market Minimum";
+    }
+    if (signed_quantity > 0 && max_long_quantity > 0 && quantity > max_long_quantity)
+    {
+        return "Quantity Above Market Maximum";
+    }
+    if (signed_quantity < 0 && max_short_quantity > 0 && quantity > max_short_quantity)
+    {
+        return "Quantity Above Market Maximum";
+    }
+    if (quantity_increment > 0)
+    {
+        double const remainder = std::fmod(quantity, quantity_increment);
+        if (remainder > QUANTITY_EPSILON && quantity_increment - remainder > QUANTITY_EPSILON)
+        {
+            return "Quantity Not a Multiple of the Market Increment";
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<GCMarketSpec> parse_market_spec(nlohmann::json const& market_information)
+{
+    if (! market_information.contains("MarketInformation") || ! market_information["MarketInformation"].is_object())
+    {
+        return std::nullopt;
+    }
+    nlohmann::json const& info = market_information["MarketInformation"];
+    if (! info.contains("MarketId") || ! info.contains("PriceDecimalPlaces"))
+    {
+        return std::nullopt;
+    }
+
+    GCMarketSpec spec;
+    spec.market_id          = static_cast<std::int64_t>(read_double(info, "MarketId"));
+    spec.price_decimals     = static_cast<std::uint8_t>(std::clamp(read_double(info, "PriceDecimalPlaces"), 0.0, 10.0));
+    spec.min_quantity       = read_double(info, "WebMinSize");
+    spec.max_long_quantity  = read_double(info, "MaxLongSize");
+    spec.max_short_quantity = read_double(info, "MaxShortSize");
+    spec.quantity_increment = read_double(info, "IncrementSize");
+    spec.bet_per            = read_double(info, "BetPer");
+    spec.margin_factor      = read_double(info, "MarginFactor");
+    return spec;
+}
+
+std::optional<GCMarketSpec> GCMarketSpecStore::find(std::string_view market_name) const
+{
+    std::shared_ptr<Snapshot const> const snapshot = current.load(std::memory_order_acquire);
+    auto const it                                  = snapshot->by_name.find(market_name);
+    return (it == snapshot->by_name.end()) ? std::nullopt : std::optional<GCMarketSpec> {it->second};
+}
+
+std::optional<GCMarketSpec> GCMarketSpecStore::find(std::int64_t const market_id) const
+{
+    std::shared_ptr<Snapshot const> const snapshot = current.load(std::memory_order_acquire);
+    auto const it                                  = snapshot->by_id.find(market_id);
+    return (it == snapshot->by_id.end()) ? std::nullopt : std::optional<GCMarketSpec> {it->second};
+}
+
+void GCMarketSpecStore::publish(std::vector<std::pair<std::string, GCMarketSpec>> const& specs)
+{
+    /*
+     * Specs are filled once per market, so the copy made here is off every hot path.
+     */
+    std::lock_guard<std::mutex> const lock {writer};
+    auto next = std::make_shared<Snapshot>(*current.load(std::memory_order_relaxed));
+    for (auto const& [market_name, spec] : specs)
+    {
+        next->by_name.insert_or_assign(market_name, spec);
+        next->by_id.insert_or_assign(spec.market_id, spec);
+    }
+    current.store(std::move(next), std::memory_order_release);
+}
+
+}// namespace gaincapital
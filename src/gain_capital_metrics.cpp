@@ -0,0 +1,47 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_metrics.h"
+
+#include <atomic> // for memory_order
+#include <cstdint>// for uint64_t
+
+namespace gaincapital
+{
+
+double GCMetricsSnapshot::cache_hit_rate() const noexcept
+{
+    std::uint64_t const lookups = cache_hits + cache_misses;
+    return (lookups == 0) ? 0.0 : static_cast<double>(cache_hits) / static_cast<double>(lookups);
+}
+
+double GCMetricsSnapshot::hedge_rate() const noexcept
+{
+    return (hedgeable_reads == 0) ? 0.0 : static_cast<double>(hedges_sent) / static_cast<double>(hedgeable_reads);
+}
+
+double GCMetricsSnapshot::hedge_p99_improvement_us() const noexcept
+{
+    /* Zero until both the hedged reads and the holdout reads have latencies */
+    return (hedged_read_p99_us <= 0 || unhedged_read_p99_us <= 0) ? 0.0 : unhedged_read_p99_us - hedged_read_p99_us;
+}
+
+void GCMetrics::record_request() noexcept { requests_sent.fetch_add(1, std::memory_order_relaxed); }
+
+void GCMetrics::record_failure() noexcept { requests_failed.fetch_add(1, std::memory_order_relaxed); }
+
+void GCMetrics::record_cache_hit() noexcept { cache_hits.fetch_add(1, std::memory_order_relaxed); }
+
+void GCMetrics::record_cache_miss() noexcept { cache_misses.fetch_add(1, std::memory_order_relaxed); }
+
+GCMetricsSnapshot GCMetrics::snapshot() const noexcept
+{
+    GCMetricsSnapshot snapshot {};
+    snapshot.requests_sent   = requests_sent.load(std::memory_order_relaxed);
+    snapshot.requests_failed = requests_failed.load(std::memory_order_relaxed);
+    snapshot.cache_hits      = cache_hits.load(std::memory_order_relaxed);
+    snapshot.cache_misses    = cache_misses.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+}// namespace gaincapital
@@ -0,0 +1,191 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_order.h"
+
+#include <array>       // for array
+#include <charconv>    // for to_chars
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t
+#include <optional>    // for optional
+#include <string>      // for basic_string
+#include <string_view> // for string_view
+#include <system_error>// for errc
+#include <utility>     // for move
+
+#include "json/json.hpp"// for json
+
+#include "gain_capital_price.h"// for GCPrice
+
+namespace gaincapital
+{
+
+namespace
+{
+
+/* Placeholders are serialized as ordinary json strings, then cut out together with their quotes */
+constexpr std::array<std::string_view, 3> SLOT_MARKERS {"\"@@BidPrice@@\"", "\"@@OfferPrice@@\"", "\"@@Quantity@@\""};
+
+void append_quoted(std::string& buffer, double const value)
+{
+    std::array<char, 32> digits {};
+    auto const [ptr, err] = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+    buffer += '"';
+    buffer.append(digits.data(), (err == std::errc {}) ? ptr : digits.data());
+    buffer += '"';
+}
+
+void append_quoted(std::string& buffer, GCPrice const value)
+{
+    buffer += '"';
+    value.append_to(buffer);
+    buffer += '"';
+}
+
+nlohmann::json stop_limit_payload(StopLimitOrder const& order, std::string const& market_id, std::string const& trading_account_id)
+{
+    std::string const opp_direction = (order.direction == "sell") ? "buy" : "sell";
+
+    nlohmann::json if_done = nlohmann::json::array();
+    if (order.stop_price)
+    {
+        if_done.push_back(
+            {{"Stop", {{"TriggerPrice", order.stop_price->to_string()}, {"Direction", opp_direction}, {"Quantity", "@@Quantity@@"}}}});
+    }
+    if (order.limit_price)
+    {
+        if_done.push_back(
+            {{"Limit", {{"TriggerPrice", order.limit_price->to_string()}, {"Direction", opp_direction}, {"Quantity", "@@Quantity@@"}}}});
+    }
+
+    return {
+        {"Direction", order.direction},
+        {"MarketId", market_id},
+        {"Quantity", "@@Quantity@@"},
+        {"MarketName", order.market_name},
+        {"TradingAccountId", trading_account_id},
+        {"OfferPrice", "@@OfferPrice@@"},
+        {"BidPrice", "@@BidPrice@@"},
+        {"TriggerPrice", order.trigger_price.to_string()},
+        {"IfDone", if_done},
+    };
+}
+
+}// namespace
+
+GCOrderTemplate::GCOrderTemplate(std::string_view const endpoint_path, double const quantity) : path(endpoint_path), default_quantity(quantity) {}
+
+StopLimitOrder::StopLimitOrder(std::string market, std::string side, double const order_quantity, GCPrice const trigger,
+                               std::optional<GCPrice> const stop, std::optional<GCPrice> const limit)
+    : market_name(std::move(market)), direction(std::move(side)), quantity(order_quantity), trigger_price(trigger), stop_price(stop),
+      limit_price(limit)
+{
+}
+
+StopLimitOrder::StopLimitOrder(std::string market, std::string side, double const order_quantity, double const trigger,
+                               std::optional<double> const stop, std::optional<double> const limit)
+    : StopLimitOrder(std::move(market), std::move(side), order_quantity, GCPrice {trigger},
+                     stop.transform([](double const price) { return GCPrice {price}; }),
+                     limit.transform([](double const price) { return GCPrice {price}; }))
+{
+}
+
+GCOrderTemplate::GCOrderTemplate(MarketOrder const& order, std::string const& market_id, std::string const& trading_account_id,
+                                 std::string const& reference)
+    : path("/order/newtradeorder"), default_quantity(order.quantity)
+{
+    nlohmann::json payload = {
+        {"Direction", order.direction},
+        {"MarketId", market_id},
+        {"Quantity", "@@Quantity@@"},
+        {"MarketName", order.market_name},
+        {"TradingAccountId", trading_account_id},
+        {"OfferPrice", "@@OfferPrice@@"},
+        {"BidPrice", "@@BidPrice@@"},
+        {"PriceTolerance", "0"},
+    };
+    compile(std::move(payload), reference);
+}
+
+GCOrderTemplate::GCOrderTemplate(StopLimitOrder const& order, std::string const& market_id, std::string const& trading_account_id,
+                                 std::string const& reference)
+    : path("/order/newstoplimitorder"), default_quantity(order.quantity)
+{
+    compile(stop_limit_payload(order, market_id, trading_account_id), reference);
+}
+
+GCOrderTemplate GCOrderTemplate::amend(StopLimitOrder const& order, std::string const& market_id, std::string const& trading_account_id,
+                                       std::int64_t const order_id)
+{
+    /*
+     * Replaces a working stop/limit order, IfDone legs included, in one request under its existing OrderId.
+     */
+    GCOrderTemplate order_template("/order/updatestoplimitorder", order.quantity);
+    nlohmann::json payload = stop_limit_payload(order, market_id, trading_account_id);
+    payload["OrderId"]     = std::to_string(order_id);
+    order_template.compile(std::move(payload), "");
+    return order_template;
+}
+
+std::string const& GCOrderTemplate::render(GCPrice const bid_price, GCPrice const offer_price)
+{
+    return render(bid_price, offer_price, default_quantity);
+}
+
+std::string const& GCOrderTemplate::render(GCPrice const bid_price, GCPrice const offer_price, double const quantity)
+{
+    /*
+     * The buffer keeps its capacity between attempts, so rendering does not allocate after the first call.
+     */
+    buffer.clear();
+    for (auto const& [prefix, slot] : segments)
+    {
+        buffer += prefix;
+        if (slot == Slot::Quantity)
+        {
+            append_quoted(buffer, quantity);
+        }
+        else
+        {
+            append_quoted(buffer, (slot == Slot::BidPrice) ? bid_price : offer_price);
+        }
+    }
+    buffer += tail;
+    return buffer;
+}
+
+std::string_view GCOrderTemplate::endpoint() const noexcept { return path; }
+
+void GCOrderTemplate::compile(nlohmann::json payload, std::string const& reference)
+{
+    if (! reference.empty())
+    {
+        payload["Reference"] = reference;
+    }
+    std::string const serialized = payload.dump();
+    std::size_t position          = 0;
+    while (true)
+    {
+        std::size_t next = std::string::npos;
+        std::size_t slot = 0;
+        for (std::size_t i = 0; i < SLOT_MARKERS.size(); ++i)
+        {
+            std::size_t const found = serialized.find(SLOT_MARKERS[i], position);
+            if (found < next)
+            {
+                next = found;
+                slot = i;
+            }
+        }
+        if (next == std::string::npos)
+        {
+            break;
+        }
+        segments.emplace_back(serialized.substr(position, next - position), static_cast<Slot>(slot));
+        position = next + SLOT_MARKERS[slot].size();
+    }
+    tail = serialized.substr(position);
+    buffer.reserve(serialized.size() + segments.size() * 32);
+}
+
+}// namespace gaincapital
@@ -0,0 +1,377 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_order_manager.h"
+
+#include <atomic>      // for atomic
+#include <charconv>    // for from_chars, to_chars
+#include <cmath>       // for abs
+#include <chrono>      // for system_clock, steady_clock
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t, int64_t
+#include <mutex>       // for lock_guard
+#include <optional>    // for optional
+#include <string>      // for basic_string
+#include <string_view> // for string_view
+#include <system_error>// for errc
+#include <unordered_set>// for unordered_set
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "json/json.hpp"// for json
+
+#include "gain_capital_active_orders.h"// for GCActiveOrderTracker
+
+namespace gaincapital
+{
+
+GCOrderManager::GCOrderManager(std::string reference_prefix) : prefix(std::move(reference_prefix)) {}
+
+std::uint64_t GCOrderManager::create(std::int64_t const market_id, double const signed_quantity, bool const resting, double const price)
+{
+    std::lock_guard<std::mutex> const lock {mutex};
+    GCOrderRecord& record  = records.emplace_back();
+    record.client_order_id = records.size();
+    record.market_id       = market_id;
+    record.signed_quantity = signed_quantity;
+    record.price           = price;
+    record.resting         = resting;
+    record.updated_at      = std::chrono::steady_clock::now();
+    open_records.push_back(records.size() - 1);
+    return record.client_order_id;
+}
+
+std::string GCOrderManager::reference(std::uint64_t const client_order_id) const { return prefix + "-" + std::to_string(client_order_id); }
+
+std::optional<std::uint64_t> GCOrderManager::parse_reference(std::string_view reference) const
+{
+    if (reference.size() <= prefix.size() + 1 || ! reference.starts_with(prefix) || reference[prefix.size()] != '-')
+    {
+        return std::nullopt;
+    }
+    std::uint64_t client_order_id = 0;
+    auto const [ptr, err]         = std::from_chars(reference.data() + prefix.size() + 1, reference.data() + reference.size(), client_order_id);
+    if (err != std::errc {} || ptr != reference.data() + reference.size())
+    {
+        return std::nullopt;
+    }
+    return client_order_id;
+}
+
+void GCOrderManager::record_attempt(std::uint64_t const client_order_id, double const bid_price, double const offer_price)
+{
+    /*
+     * Market orders are expected to fill at the side of the quote they cross.
+     */
+    std::lock_guard<std::mutex> const lock {mutex};
+    if (GCOrderRecord* record = lookup(client_order_id))
+    {
+        ++record->attempts;
+        record->updated_at = std::chrono::steady_clock::now();
+        if (! record->resting)
+        {
+            record->price = (record->signed_quantity < 0) ? bid_price : offer_price;
+        }
+    }
+}
+
+void GCOrderManager::acknowledge(std::uint64_t const client_order_id, std::int64_t const order_id)
+{
+    /*
+     * Market orders are complete once accepted; resting orders wait for reconcile to see them working.
+     */
+    std::lock_guard<std::mutex> const lock {mutex};
+    if (GCOrderRecord* record = lookup(client_order_id))
+    {
+        record->order_id   = order_id;
+        record->state      = record->resting ? GCOrderState::Acked : GCOrderState::Filled;
+        record->updated_at = std::chrono::steady_clock::now();
+        order_index.insert_or_assign(order_id, client_order_id - 1);
+        if (record->state == GCOrderState::Filled && fill_listener)
+        {
+            fill_listener(*record);
+        }
+    }
+}
+
+void GCOrderManager::reject(std::uint64_t const client_order_id)
+{
+    std::lock_guard<std::mutex> const lock {mutex};
+    if (GCOrderRecord* record = lookup(client_order_id))
+    {
+        record->state      = GCOrderState::Rejected;
+        record->updated_at = std::chrono::steady_clock::now();
+    }
+}
+
+void GCOrderManager::mark_unknown(std::uint64_t const client_order_id)
+{
+    /*
+     * The order may or may not exist on the server. A resting order becomes working once the active orders list
+     * it; a market order is only settled when a position correction accounts for it.
+     */
+    std::lock_guard<std::mutex> const lock {mutex};
+    if (GCOrderRecord* record = lookup(client_order_id))
+    {
+        record->state      = GCOrderState::Unknown;
+        record->updated_at = std::chrono::steady_clock::now();
+    }
+}
+
+void GCOrderManager::request_cancel(std::int64_t const order_id)
+{
+    /*
+     * Marked before the cancel is sent, so a reconcile that runs while it is in flight already knows why the order went away.
+     */
+    std::lock_guard<std::mutex> const lock {mutex};
+    auto const it = order_index.find(order_id);
+    if (it != order_index.end())
+    {
+        records[it->second].cancel_requested = true;
+    }
+}
+
+void GCOrderManager::withdraw_cancel(std::int64_t const order_id)
+{
+    std::lock_guard<std::mutex> const lock {mutex};
+    auto const it = order_index.find(order_id);
+    if (it != order_index.end())
+    {
+        records[it->second].cancel_requested = false;
+    }
+}
+
+void GCOrderManager::amend(std::int64_t const order_id, double const signed_quantity, double const price)
+{
+    /*
+     * An accepted amend keeps the order's ID and state; only the quantity and trigger price change.
+     */
+    std::lock_guard<std::mutex> const lock {mutex};
+    auto const it = order_index.find(order_id);
+    if (it != order_index.end())
+    {
+        GCOrderRecord& record  = records[it->second];
+        record.signed_quantity = signed_quantity;
+        record.price           = price;
+        record.updated_at      = std::chrono::steady_clock::now();
+    }
+}
+
+std::optional<std::size_t> GCOrderManager::reconcile(nlohmann::json const& active_orders)
+{
+    /*
+     * Applies a list_active_orders response. Orders seen on the server become working; working orders that
+     * disappeared are cancelled if a cancel was requested and closed otherwise. Absence alone does not prove a
+     * fill, the order may have expired or been cancelled elsewhere, so closed orders never reach the fill listener.
+     * Acked orders not yet visible are left alone, since the server may not list them immediately.
+     * :return: number of orders closed by this pass, or nullopt when the response is not an active order list
+     */
+    auto const server_orders = read_active_orders(active_orders);
+    if (! server_orders)
+    {
+        return std::nullopt;
+    }
+
+    std::lock_guard<std::mutex> const lock {mutex};
+    prune_open_records();
+    auto const now = std::chrono::steady_clock::now();
+    std::unordered_set<std::size_t> seen;
+    seen.reserve(server_orders->size());
+    std::size_t closed = 0;
+
+    for (ActiveOrder const& server_order : *server_orders)
+    {
+        std::optional<std::size_t> index;
+        if (auto const client_order_id = parse_reference(server_order.reference); client_order_id && lookup(*client_order_id))
+        {
+            index = *client_order_id - 1;
+        }
+        else if (auto const it = order_index.find(server_order.order_id); it != order_index.end())
+        {
+            index = it->second;
+        }
+        if (! index)
+        {
+            continue;
+        }
+        GCOrderRecord& record = records[*index];
+        seen.insert(*index);
+        if (record.order_id == 0 && server_order.order_id != 0)
+        {
+            record.order_id = server_order.order_id;
+            order_index.insert_or_assign(server_order.order_id, *index);
+        }
+        if (record.state == GCOrderState::Pending || record.state == GCOrderState::Acked || record.state == GCOrderState::Unknown)
+        {
+            record.state      = GCOrderState::Working;
+            record.updated_at = now;
+        }
+    }
+    // -------------------
+    for (std::size_t const index : open_records)
+    {
+        GCOrderRecord& record = records[index];
+        if (seen.contains(index))
+        {
+            continue;
+        }
+        if (record.state == GCOrderState::Working || (record.state == GCOrderState::Acked && record.cancel_requested))
+        {
+            record.state      = record.cancel_requested ? GCOrderState::Cancelled : GCOrderState::Closed;
+            record.updated_at = now;
+            closed += (record.state == GCOrderState::Closed) ? 1U : 0U;
+        }
+    }
+    return closed;
+}
+
+std::size_t GCOrderManager::confirm_fills(std::int64_t const market_id, double const quantity_change)
+{
+    /*
+     * Settles closed orders, and market orders whose reply was lost, against a change in the server's net position
+     * for their market. Oldest first, each one whose quantity fits within the unexplained change, in the same
+     * direction, is marked filled.
+     * The position book already holds the server's quantity, so confirmed fills do not reach the fill listener.
+     * :return: number of orders confirmed filled
+     */
+    constexpr double QUANTITY_EPSILON = 1e-9;
+    std::lock_guard<std::mutex> const lock {mutex};
+    prune_open_records();
+    auto const now        = std::chrono::steady_clock::now();
+    double remaining      = quantity_change;
+    std::size_t confirmed = 0;
+    for (std::size_t const index : open_records)
+    {
+        GCOrderRecord& record = records[index];
+        bool const unsettled  = record.state == GCOrderState::Closed || (record.state == GCOrderState::Unknown && ! record.resting);
+        if (! unsettled || record.market_id != market_id || record.signed_quantity * remaining <= 0 ||
+            std::abs(record.signed_quantity) > std::abs(remaining) + QUANTITY_EPSILON)
+        {
+            continue;
+        }
+        record.state      = GCOrderState::Filled;
+        record.updated_at = now;
+        remaining -= record.signed_quantity;
+        ++confirmed;
+    }
+    return confirmed;
+}
+
+std::optional<std::int64_t> GCOrderManager::find_on_server(nlohmann::json const& active_orders, std::uint64_t const client_order_id) const
+{
+    /*
+     * Looks for an order by its Reference; used to settle a submission whose response was lost.
+     */
+    auto const server_orders = read_active_orders(active_orders);
+    if (! server_orders)
+    {
+        return std::nullopt;
+    }
+    std::string const order_reference = reference(client_order_id);
+    for (ActiveOrder const& server_order : *server_orders)
+    {
+        if (server_order.reference == order_reference)
+        {
+            return server_order.order_id;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<GCOrderRecord> GCOrderManager::find(std::uint64_t const client_order_id) const
+{
+    std::lock_guard<std::mutex> const lock {mutex};
+    if (client_order_id == 0 || client_order_id > records.size())
+    {
+        return std::nullopt;
+    }
+    return records[client_order_id - 1];
+}
+
+std::optional<GCOrderRecord> GCOrderManager::find_by_order_id(std::int64_t const order_id) const
+{
+    std::lock_guard<std::mutex> const lock {mutex};
+    auto const it = order_index.find(order_id);
+    if (it == order_index.end())
+    {
+        return std::nullopt;
+    }
+    return records[it->second];
+}
+
+std::vector<GCOrderRecord> GCOrderManager::snapshot() const
+{
+    std::lock_guard<std::mutex> const lock {mutex};
+    return records;
+}
+
+void GCOrderManager::set_fill_listener(GCFillListener listener)
+{
+    /*
+     * Called under the manager's lock whenever an order is marked filled; it must not call back into the manager.
+     */
+    std::lock_guard<std::mutex> const lock {mutex};
+    fill_listener = std::move(listener);
+}
+
+std::string GCOrderManager::default_prefix()
+{
+    /*
+     * Unique per process start so references from an earlier run are never mistaken for this run's orders,
+     * and suffixed with an instance count so managers created within the same millisecond do not collide.
+     */
+    static std::atomic<std::uint64_t> instance_count {0};
+    auto const start_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    char digits[16] {};
+    auto const [ptr, err] = std::to_chars(digits, digits + sizeof(digits), start_ms, 36);
+    std::string const instance = std::to_string(instance_count.fetch_add(1, std::memory_order_relaxed));
+    return "GC" + std::string(digits, (err == std::errc {}) ? ptr : digits) + "I" + instance;
+}
+
+GCOrderRecord* GCOrderManager::lookup(std::uint64_t const client_order_id)
+{
+    return (client_order_id == 0 || client_order_id > records.size()) ? nullptr : &records[client_order_id - 1];
+}
+
+void GCOrderManager::prune_open_records()
+{
+    /*
+     * Filled, cancelled and rejected records never change again; dropping them keeps each pass proportional to live orders.
+     */
+    std::erase_if(open_records,
+                  [this](std::size_t const index)
+                  {
+                      GCOrderState const state = records[index].state;
+                      return state == GCOrderState::Filled || state == GCOrderState::Cancelled || state == GCOrderState::Rejected;
+                  });
+}
+
+std::optional<std::vector<GCOrderManager::ActiveOrder>> GCOrderManager::read_active_orders(nlohmann::json const& active_orders)
+{
+    /*
+     * Entries without a TradeOrder or StopLimitOrder body are skipped, as they are by the active order tracker.
+     */
+    if (! active_orders.contains("ActiveOrders") || ! active_orders["ActiveOrders"].is_array())
+    {
+        return std::nullopt;
+    }
+    std::vector<ActiveOrder> server_orders;
+    server_orders.reserve(active_orders["ActiveOrders"].size());
+    for (nlohmann::json const& entry : active_orders["ActiveOrders"])
+    {
+        nlohmann::json const* body = GCActiveOrderTracker::order_body(entry);
+        if (body == nullptr)
+        {
+            continue;
+        }
+        ActiveOrder& server_order = server_orders.emplace_back();
+        server_order.order_id     = GCActiveOrderTracker::read_order_id(entry).value_or(0);
+        if (body->contains("Reference") && (*body)["Reference"].is_string())
+        {
+            server_order.reference = (*body)["Reference"].get<std::string>();
+        }
+    }
+    return server_orders;
+}
+
+}// namespace gaincapital
@@ -0,0 +1,197 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_position_book.h"
+
+#include <cmath>        // for abs
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int64_t, uint64_t
+#include <mutex>        // for unique_lock
+#include <optional>     // for optional
+#include <shared_mutex> // for shared_lock
+#include <string>       // for basic_string
+#include <unordered_map>// for unordered_map
+#include <utility>      // for move, pair
+#include <vector>       // for vector
+
+#include "json/json.hpp"// for json
+
+#include "gain_capital_json.h"// for read_number
+
+namespace gaincapital
+{
+
+namespace
+{
+
+constexpr double QUANTITY_EPSILON = 1e-9;
+
+}// namespace
+
+void GCPositionBook::apply_fill(std::int64_t const market_id, double const signed_quantity, double const price)
+{
+    /*
+     * Fills that extend a position move the average price; fills that reduce it leave the average unchanged,
+     * and a fill through flat opens the remainder at the fill price.
+     */
+    std::unique_lock<std::shared_mutex> const lock {mutex};
+    last_fill[market_id]  = ++fills;
+    GCPosition& position  = positions[market_id];
+    position.market_id    = market_id;
+    double const previous = position.net_quantity;
+    double const next     = previous + signed_quantity;
+
+    if (std::abs(next) < QUANTITY_EPSILON)
+    {
+        positions.erase(market_id);
+        return;
+    }
+    if (previous * signed_quantity >= 0)
+    {
+        position.average_price = (position.average_price * std::abs(previous) + price * std::abs(signed_quantity)) / std::abs(next);
+    }
+    else if (previous * next < 0)
+    {
+        position.average_price = price;
+    }
+    position.net_quantity = next;
+}
+
+double GCPositionBook::exposure(std::int64_t const market_id) const
+{
+    std::shared_lock<std::shared_mutex> const lock {mutex};
+    auto const it = positions.find(market_id);
+    return (it == positions.end()) ? 0 : it->second.net_quantity;
+}
+
+std::optional<GCPosition> GCPositionBook::position(std::int64_t const market_id) const
+{
+    std::shared_lock<std::shared_mutex> const lock {mutex};
+    auto const it = positions.find(market_id);
+    return (it == positions.end()) ? std::nullopt : std::optional<GCPosition> {it->second};
+}
+
+std::vector<GCPosition> GCPositionBook::snapshot() const
+{
+    std::shared_lock<std::shared_mutex> const lock {mutex};
+    std::vector<GCPosition> book;
+    book.reserve(positions.size());
+    for (auto const& [market_id, position] : positions)
+    {
+        book.push_back(position);
+    }
+    return book;
+}
+
+std::uint64_t GCPositionBook::fill_sequence() const
+{
+    std::shared_lock<std::shared_mutex> const lock {mutex};
+    return fills;
+}
+
+std::optional<std::size_t> GCPositionBook::reconcile(nlohmann::json const& open_positions, std::optional<std::uint64_t> const fill_stamp)
+{
+    /*
+     * Nets the server's open positions per market and overwrites only the markets that disagree with the book,
+     * reporting each correction to the correction listener. fill_stamp is the fill_sequence taken before the
+     * positions were requested; a market filled locally since then may be missing that fill in the snapshot,
+     * so it is left alone until a later reconcile.
+     * :return: number of markets corrected, or nullopt when the response is not a position list
+     */
+    if (! open_positions.contains("OpenPositions") || ! open_positions["OpenPositions"].is_array())
+    {
+        return std::nullopt;
+    }
+
+    /* Hedged accounts can hold several positions per market; the average price is weighted by size across all of them */
+    std::unordered_map<std::int64_t, GCPosition> server_book;
+    std::unordered_map<std::int64_t, double> gross_quantity;
+    for (nlohmann::json const& entry : open_positions["OpenPositions"])
+    {
+        auto const market_id = read_number(entry, "MarketId");
+        auto const quantity  = read_number(entry, "Quantity");
+        if (! market_id || ! quantity)
+        {
+            return std::nullopt;
+        }
+        bool const sell = entry.contains("Direction") && entry["Direction"] == "sell";
+
+        GCPosition& position = server_book[static_cast<std::int64_t>(*market_id)];
+        position.market_id   = static_cast<std::int64_t>(*market_id);
+        position.net_quantity += sell ? -*quantity : *quantity;
+        position.average_price += read_number(entry, "Price").value_or(0) * *quantity;
+        gross_quantity[position.market_id] += *quantity;
+    }
+    for (auto& [market_id, position] : server_book)
+    {
+        position.average_price = (gross_quantity[market_id] > 0) ? position.average_price / gross_quantity[market_id] : 0;
+    }
+    // -------------------
+    /* The listener runs after the lock is released, so it may take locks that are held around apply_fill */
+    std::vector<std::pair<std::int64_t, double>> changes;
+    GCCorrectionListener listener;
+    {
+        std::unique_lock<std::shared_mutex> const lock {mutex};
+        auto const filled_since_stamp = [this, fill_stamp](std::int64_t const market_id)
+        {
+            auto const it = last_fill.find(market_id);
+            return fill_stamp && it != last_fill.end() && it->second > *fill_stamp;
+        };
+        for (auto it = positions.begin(); it != positions.end();)
+        {
+            if (! server_book.contains(it->first) && ! filled_since_stamp(it->first))
+            {
+                changes.emplace_back(it->first, -it->second.net_quantity);
+                it = positions.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        for (auto const& [market_id, server_position] : server_book)
+        {
+            if (filled_since_stamp(market_id))
+            {
+                continue;
+            }
+            auto const it        = positions.find(market_id);
+            double const current = (it == positions.end()) ? 0 : it->second.net_quantity;
+            if (std::abs(server_position.net_quantity) < QUANTITY_EPSILON)
+            {
+                if (it != positions.end())
+                {
+                    changes.emplace_back(market_id, -current);
+                    positions.erase(it);
+                }
+                continue;
+            }
+            if (it == positions.end() || std::abs(current - server_position.net_quantity) >= QUANTITY_EPSILON)
+            {
+                changes.emplace_back(market_id, server_position.net_quantity - current);
+                positions.insert_or_assign(market_id, server_position);
+            }
+        }
+        listener = correction_listener;
+    }
+    if (listener)
+    {
+        for (auto const& [market_id, quantity_change] : changes)
+        {
+            listener(market_id, quantity_change);
+        }
+    }
+    std::size_t const corrections = changes.size();
+    return corrections;
+}
+
+void GCPositionBook::set_correction_listener(GCCorrectionListener listener)
+{
+    /*
+     * Called once per corrected market with the quantity the server's position moved the book by.
+     */
+    std::unique_lock<std::shared_mutex> const lock {mutex};
+    correction_listener = std::move(listener);
+}
+
+}// namespace gaincapital
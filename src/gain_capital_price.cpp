@@ -0,0 +1,211 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_price.h"
+
+#include <algorithm>   // for max, min
+#include <array>       // for array
+#include <charconv>    // for from_chars, to_chars
+#include <cmath>       // for llround
+#include <compare>     // for strong_ordering
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int64_t, uint64_t, uint8_t
+#include <optional>    // for optional
+#include <string>      // for basic_string
+#include <string_view> // for string_view
+#include <system_error>// for errc
+
+namespace gaincapital
+{
+
+namespace
+{
+
+constexpr std::array<std::int64_t, GCPrice::MAX_DECIMALS + 1> POW10 = []
+{
+    std::array<std::int64_t, GCPrice::MAX_DECIMALS + 1> powers {1};
+    for (std::size_t i = 1; i < powers.size(); ++i)
+    {
+        powers[i] = powers[i - 1] * 10;
+    }
+    return powers;
+}();
+
+/* Units at 18 decimals overflow 64 bits; GCC and Clang both provide a 128-bit integer */
+__extension__ typedef __int128 wide_units;
+
+wide_units aligned_units(GCPrice const& price, std::uint8_t const decimals) noexcept
+{
+    return static_cast<wide_units>(price.units()) * POW10[decimals - price.decimals()];
+}
+
+}// namespace
+
+GCPrice::GCPrice(double const value, std::uint8_t const decimals) noexcept
+    : price_units(std::llround(value * static_cast<double>(POW10[std::min(decimals, MAX_DECIMALS)]))),
+      price_decimals(std::min(decimals, MAX_DECIMALS))
+{
+}
+
+GCPrice GCPrice::from_units(std::int64_t const units, std::uint8_t const decimals) noexcept
+{
+    GCPrice price;
+    price.price_units    = units;
+    price.price_decimals = std::min(decimals, MAX_DECIMALS);
+    return price;
+}
+
+std::optional<GCPrice> GCPrice::parse(std::string_view text, std::uint8_t decimals) noexcept
+{
+    /*
+     * Reads a plain decimal string ("-1.23450") straight into units without going through a double.
+     * Digits past the requested decimals are rounded half away from zero; exponent notation falls back to from_chars.
+     */
+    decimals = std::min(decimals, MAX_DECIMALS);
+    if (text.find_first_of("eE") != std::string_view::npos)
+    {
+        double value          = 0;
+        auto const [ptr, err] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (err != std::errc {} || ptr != text.data() + text.size())
+        {
+            return std::nullopt;
+        }
+        return GCPrice {value, decimals};
+    }
+
+    bool const negative = ! text.empty() && text.front() == '-';
+    if (! text.empty() && (text.front() == '-' || text.front() == '+'))
+    {
+        text.remove_prefix(1);
+    }
+    std::int64_t units    = 0;
+    std::size_t digits    = 0;
+    std::uint8_t fraction = 0;
+    bool point            = false;
+    bool truncated        = false;
+    bool round_away       = false;
+    for (char const c : text)
+    {
+        if (c == '.' && ! point)
+        {
+            point = true;
+            continue;
+        }
+        if (c < '0' || c > '9')
+        {
+            return std::nullopt;
+        }
+        ++digits;
+        if (point && fraction == decimals)
+        {
+            round_away = truncated ? round_away : c >= '5';
+            truncated  = true;
+            continue;
+        }
+        if (__builtin_mul_overflow(units, 10, &units) || __builtin_add_overflow(units, c - '0', &units))
+        {
+            return std::nullopt;
+        }
+        if (point)
+        {
+            ++fraction;
+        }
+    }
+    if (digits == 0 || __builtin_mul_overflow(units, POW10[decimals - fraction], &units) ||
+        __builtin_add_overflow(units, round_away ? 1 : 0, &units))
+    {
+        return std::nullopt;
+    }
+    return from_units(negative ? -units : units, decimals);
+}
+
+GCPrice GCPrice::rescale(std::uint8_t decimals) const noexcept
+{
+    /*
+     * Widening is exact; narrowing rounds half away from zero, matching how the server rounds quoted prices.
+     */
+    decimals = std::min(decimals, MAX_DECIMALS);
+    if (decimals >= price_decimals)
+    {
+        return from_units(price_units * POW10[decimals - price_decimals], decimals);
+    }
+    std::int64_t const divisor = POW10[price_decimals - decimals];
+    std::int64_t const half    = divisor / 2;
+    std::int64_t const rounded = (price_units >= 0) ? (price_units + half) / divisor : (price_units - half) / divisor;
+    return from_units(rounded, decimals);
+}
+
+double GCPrice::to_double() const noexcept { return static_cast<double>(price_units) / static_cast<double>(POW10[price_decimals]); }
+
+void GCPrice::append_to(std::string& buffer) const
+{
+    /*
+     * Writes the shortest exact decimal: trailing fractional zeros and a bare point are dropped ("1.5", "2").
+     */
+    std::uint64_t const magnitude = (price_units < 0) ? 0 - static_cast<std::uint64_t>(price_units) : static_cast<std::uint64_t>(price_units);
+    std::uint64_t const scale     = static_cast<std::uint64_t>(POW10[price_decimals]);
+    if (price_units < 0)
+    {
+        buffer += '-';
+    }
+    std::array<char, 24> whole {};
+    auto const [ptr, err] = std::to_chars(whole.data(), whole.data() + whole.size(), magnitude / scale);
+    buffer.append(whole.data(), ptr);
+
+    std::uint64_t remainder = magnitude % scale;
+    if (remainder == 0)
+    {
+        return;
+    }
+    std::array<char, MAX_DECIMALS> fraction {};
+    for (std::size_t i = price_decimals; i > 0; --i)
+    {
+        fraction[i - 1] = static_cast<char>('0' + remainder % 10);
+        remainder /= 10;
+    }
+    std::size_t width = price_decimals;
+    while (fraction[width - 1] == '0')
+    {
+        --width;
+    }
+    buffer += '.';
+    buffer.append(fraction.data(), width);
+}
+
+std::string GCPrice::to_string() const
+{
+    std::string text;
+    append_to(text);
+    return text;
+}
+
+GCPrice GCPrice::operator+(GCPrice const& other) const noexcept
+{
+    std::uint8_t const decimals = std::max(price_decimals, other.price_decimals);
+    return from_units(rescale(decimals).price_units + other.rescale(decimals).price_units, decimals);
+}
+
+GCPrice GCPrice::operator-(GCPrice const& other) const noexcept
+{
+    std::uint8_t const decimals = std::max(price_decimals, other.price_decimals);
+    return from_units(rescale(decimals).price_units - other.rescale(decimals).price_units, decimals);
+}
+
+GCPrice GCPrice::operator*(std::int64_t const factor) const noexcept { return from_units(price_units * factor, price_decimals); }
+
+GCPrice& GCPrice::operator+=(GCPrice const& other) noexcept { return *this = *this + other; }
+
+GCPrice& GCPrice::operator-=(GCPrice const& other) noexcept { return *this = *this - other; }
+
+bool GCPrice::operator==(GCPrice const& other) const noexcept { return (*this <=> other) == std::strong_ordering::equal; }
+
+std::strong_ordering GCPrice::operator<=>(GCPrice const& other) const noexcept
+{
+    /*
+     * Prices at different decimals compare by value, so 1.5 at two decimals equals 1.5 at six.
+     */
+    std::uint8_t const decimals = std::max(price_decimals, other.price_decimals);
+    return aligned_units(*this, decimals) <=> aligned_units(other, decimals);
+}
+
+}// namespace gaincapital
@@ -0,0 +1,465 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_reactor.h"
+
+#include <algorithm>       // for max
+#include <array>           // for array
+#include <cerrno>          // for errno
+#include <chrono>          // for steady_clock, ceil, milliseconds
+#include <cstddef>         // for size_t
+#include <cstdint>         // for uint64_t
+#include <cstring>         // for strerror
+#include <initializer_list>// for initializer_list
+#include <memory>          // for unique_ptr
+#include <mutex>           // for mutex, call_once
+#include <source_location> // for source_location
+#include <string>          // for basic_string
+#include <sys/epoll.h>     // for epoll_wait
+#include <sys/eventfd.h>   // for eventfd
+#include <unistd.h>        // for close, read, write
+#include <vector>          // for vector
+
+#include "cpr/cprtypes.h"// for Header
+#include "curl/curl.h"   // for curl_multi_socket_action
+
+#include "gain_capital_exception.h"// for GCException
+
+namespace gaincapital
+{
+
+namespace
+{
+
+long long steady_now_ms() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::size_t write_body(char* data, std::size_t size, std::size_t count, void* userp)
+{
+    static_cast<std::string*>(userp)->append(data, size * count);
+    return size * count;
+}
+
+std::size_t write_header(char* data, std::size_t size, std::size_t count, void* userp)
+{
+    std::string_view line {data, size * count};
+    auto const colon = line.find(':');
+    if (colon != std::string_view::npos)
+    {
+        std::string_view value = line.substr(colon + 1);
+        while (! value.empty() && (value.front() == ' ' || value.front() == '\t'))
+        {
+            value.remove_prefix(1);
+        }
+        while (! value.empty() && (value.back() == '\r' || value.back() == '\n' || value.back() == ' '))
+        {
+            value.remove_suffix(1);
+        }
+        (*static_cast<cpr::Header*>(userp))[std::string {line.substr(0, colon)}] = std::string {value};
+    }
+    return size * count;
+}
+
+}// namespace
+
+struct GCReactor::Transfer
+{
+    std::uint64_t id {};
+    CURL* easy {};
+    curl_slist* header_list {};
+    NetworkRequest request;
+    NetworkResponse response;
+    NetworkCallback callback;
+    std::array<char, CURL_ERROR_SIZE> error_buffer {};
+
+    ~Transfer()
+    {
+        if (easy != nullptr)
+        {
+            curl_easy_cleanup(easy);
+        }
+        if (header_list != nullptr)
+        {
+            curl_slist_free_all(header_list);
+        }
+    }
+};
+
+GCReactor::GCReactor()
+{
+    /*
+     * Anything acquired before a failed step is released before the exception leaves the constructor.
+     */
+    static std::once_flag curl_init_flag;
+    std::call_once(curl_init_flag, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+    std::source_location const location = std::source_location::current();
+    auto const fail                     = [this, &location](std::string const& error_message)
+    {
+        release_handles();
+        throw GCException {location.function_name(), error_message};
+    };
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0)
+    {
+        fail("Failed to Create Epoll Instance - " + std::string(std::strerror(errno)));
+    }
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd < 0)
+    {
+        fail("Failed to Create Wake Eventfd - " + std::string(std::strerror(errno)));
+    }
+    epoll_event event {};
+    event.events  = EPOLLIN;
+    event.data.fd = wake_fd;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event) != 0)
+    {
+        fail("Failed to Register Wake Eventfd - " + std::string(std::strerror(errno)));
+    }
+    multi_handle = curl_multi_init();
+    if (multi_handle == nullptr)
+    {
+        fail("Failed to Initialize Curl Multi Handle");
+    }
+
+    curl_multi_setopt(multi_handle, CURLMOPT_SOCKETFUNCTION, &GCReactor::socket_callback);
+    curl_multi_setopt(multi_handle, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt(multi_handle, CURLMOPT_TIMERFUNCTION, &GCReactor::timer_callback);
+    curl_multi_setopt(multi_handle, CURLMOPT_TIMERDATA, this);
+
+    reactor_thread = std::thread(&GCReactor::run, this);
+}
+
+GCReactor::~GCReactor()
+{
+    stopping.store(true, std::memory_order_release);
+    wake();
+    if (reactor_thread.joinable())
+    {
+        reactor_thread.join();
+    }
+    release_handles();
+}
+
+void GCReactor::release_handles() noexcept
+{
+    if (multi_handle != nullptr)
+    {
+        curl_multi_cleanup(multi_handle);
+        multi_handle = nullptr;
+    }
+    for (int* fd : {&wake_fd, &epoll_fd})
+    {
+        if (*fd >= 0)
+        {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+std::uint64_t GCReactor::submit(NetworkRequest request, NetworkCallback callback)
+{
+    /*
+     * Queues a request for the reactor thread. The callback receives the response,
+     * or status code 0 with an error message on transport failure.
+     */
+    auto transfer      = std::make_unique<Transfer>();
+    transfer->id       = next_id.fetch_add(1, std::memory_order_relaxed);
+    transfer->request  = std::move(request);
+    transfer->callback = std::move(callback);
+    std::uint64_t const id = transfer->id;
+
+    in_flight_count.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> const lock {submit_mutex};
+        submit_queue.emplace_back(std::move(transfer));
+    }
+    wake();
+    return id;
+}
+
+void GCReactor::cancel(std::uint64_t const id)
+{
+    /*
+     * Queued like a submission, so a cancel always reaches the reactor after the request it names.
+     */
+    {
+        std::lock_guard<std::mutex> const lock {submit_mutex};
+        cancel_queue.push_back(id);
+    }
+    wake();
+}
+
+std::size_t GCReactor::in_flight() const noexcept { return in_flight_count.load(std::memory_order_relaxed); }
+
+void GCReactor::run()
+{
+    std::array<epoll_event, 64> events {};
+    int running_handles = 0;
+
+    while (! stopping.load(std::memory_order_acquire))
+    {
+        int wait_ms = -1;
+        if (timer_deadline_ms >= 0)
+        {
+            wait_ms = static_cast<int>(std::max(0LL, timer_deadline_ms - steady_now_ms()));
+        }
+
+        int const ready = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), wait_ms);
+
+        for (std::size_t i = 0; i < static_cast<std::size_t>(std::max(ready, 0)); ++i)
+        {
+            if (events[i].data.fd == wake_fd)
+            {
+                std::uint64_t count = 0;
+                [[maybe_unused]] ssize_t const bytes = read(wake_fd, &count, sizeof(count));
+                drain_submissions();
+                drain_cancellations();
+                continue;
+            }
+            int flags = 0;
+            if (events[i].events & EPOLLIN)
+            {
+                flags |= CURL_CSELECT_IN;
+            }
+            if (events[i].events & EPOLLOUT)
+            {
+                flags |= CURL_CSELECT_OUT;
+            }
+            if (events[i].events & (EPOLLERR | EPOLLHUP))
+            {
+                flags |= CURL_CSELECT_ERR;
+            }
+            curl_multi_socket_action(multi_handle, events[i].data.fd, flags, &running_handles);
+        }
+
+        if (timer_deadline_ms >= 0 && steady_now_ms() >= timer_deadline_ms)
+        {
+            timer_deadline_ms = -1;
+            curl_multi_socket_action(multi_handle, CURL_SOCKET_TIMEOUT, 0, &running_handles);
+        }
+        check_completed();
+    }
+    abort_all();
+}
+
+void GCReactor::wake() const noexcept
+{
+    std::uint64_t const one = 1;
+    [[maybe_unused]] ssize_t const bytes = write(wake_fd, &one, sizeof(one));
+}
+
+void GCReactor::drain_submissions()
+{
+    std::deque<std::unique_ptr<Transfer>> pending;
+    {
+        std::lock_guard<std::mutex> const lock {submit_mutex};
+        pending.swap(submit_queue);
+    }
+
+    auto const now = std::chrono::steady_clock::now();
+    for (auto& transfer : pending)
+    {
+        long budget_ms = 0;
+        if (transfer->request.deadline != NO_DEADLINE)
+        {
+            budget_ms = std::chrono::ceil<std::chrono::milliseconds>(transfer->request.deadline - now).count();
+            if (budget_ms <= 0)
+            {
+                transfer->response.error_message     = "Deadline Exceeded";
+                transfer->response.deadline_exceeded = true;
+                finish(std::move(transfer));
+                continue;
+            }
+        }
+        transfer->easy = curl_easy_init();
+        if (transfer->easy == nullptr)
+        {
+            transfer->response.error_message = "Failed to Initialize Transfer";
+            finish(std::move(transfer));
+            continue;
+        }
+        CURL* easy = transfer->easy;
+
+        for (auto const& [key, value] : transfer->request.header)
+        {
+            transfer->header_list = curl_slist_append(transfer->header_list, (key + ": " + value).c_str());
+        }
+
+        curl_easy_setopt(easy, CURLOPT_URL, transfer->request.url.c_str());
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->header_list);
+        curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, &write_body);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer->response.text);
+        curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, &write_header);
+        curl_easy_setopt(easy, CURLOPT_HEADERDATA, &transfer->response.header);
+        curl_easy_setopt(easy, CURLOPT_ERRORBUFFER, transfer->error_buffer.data());
+        curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer.get());
+        if (budget_ms > 0)
+        {
+            // Connect Covers DNS, TCP and the TLS Handshake; Timeout Covers the Whole Transfer
+            curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, budget_ms);
+            curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT_MS, budget_ms);
+        }
+
+        if (transfer->request.type == "POST")
+        {
+            curl_easy_setopt(easy, CURLOPT_POST, 1L);
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDS, transfer->request.payload.c_str());
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(transfer->request.payload.size()));
+        }
+        else
+        {
+            curl_easy_setopt(easy, CURLOPT_HTTPGET, 1L);
+        }
+
+        std::uint64_t const id = transfer->id;
+        active_transfers.emplace(id, std::move(transfer));
+        if (curl_multi_add_handle(multi_handle, easy) != CURLM_OK)
+        {
+            auto node = active_transfers.extract(id);
+            node.mapped()->response.error_message = "Failed to Register Transfer";
+            finish(std::move(node.mapped()));
+        }
+    }
+}
+
+void GCReactor::drain_cancellations()
+{
+    /*
+     * Removing the handle closes its connection mid-transfer. Requests that already finished are skipped.
+     */
+    std::vector<std::uint64_t> pending;
+    {
+        std::lock_guard<std::mutex> const lock {submit_mutex};
+        pending.swap(cancel_queue);
+    }
+    for (std::uint64_t const id : pending)
+    {
+        auto node = active_transfers.extract(id);
+        if (node.empty())
+        {
+            continue;
+        }
+        curl_multi_remove_handle(multi_handle, node.mapped()->easy);
+        node.mapped()->response.status_code   = 0;
+        node.mapped()->response.error_message = "Request Cancelled";
+        finish(std::move(node.mapped()));
+    }
+}
+
+void GCReactor::check_completed()
+{
+    int messages_left = 0;
+    while (CURLMsg* message = curl_multi_info_read(multi_handle, &messages_left))
+    {
+        if (message->msg != CURLMSG_DONE)
+        {
+            continue;
+        }
+        Transfer* raw_transfer = nullptr;
+        curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &raw_transfer);
+        CURLcode const result = message->data.result;
+
+        curl_multi_remove_handle(multi_handle, message->easy_handle);
+
+        auto node = active_transfers.extract(raw_transfer->id);
+        if (node.empty())
+        {
+            continue;
+        }
+        auto transfer = std::move(node.mapped());
+        if (result == CURLE_OK)
+        {
+            curl_easy_getinfo(transfer->easy, CURLINFO_RESPONSE_CODE, &transfer->response.status_code);
+        }
+        else
+        {
+            transfer->response.status_code = 0;
+            if (result == CURLE_OPERATION_TIMEDOUT && transfer->request.deadline != NO_DEADLINE)
+            {
+                transfer->response.error_message     = "Deadline Exceeded";
+                transfer->response.deadline_exceeded = true;
+            }
+            else
+            {
+                transfer->response.error_message = transfer->error_buffer[0] != '\0' ? transfer->error_buffer.data() : curl_easy_strerror(result);
+            }
+        }
+        finish(std::move(transfer));
+    }
+}
+
+void GCReactor::finish(std::unique_ptr<Transfer> transfer)
+{
+    in_flight_count.fetch_sub(1, std::memory_order_relaxed);
+    if (transfer->callback)
+    {
+        transfer->callback(std::move(transfer->response));
+    }
+}
+
+void GCReactor::abort_all()
+{
+    /*
+     * Fails every queued and in-flight transfer so no caller waits forever on shutdown.
+     */
+    for (auto& [id, transfer] : active_transfers)
+    {
+        curl_multi_remove_handle(multi_handle, transfer->easy);
+        transfer->response.status_code   = 0;
+        transfer->response.error_message = "Reactor Shutdown";
+        finish(std::move(transfer));
+    }
+    active_transfers.clear();
+
+    std::deque<std::unique_ptr<Transfer>> pending;
+    {
+        std::lock_guard<std::mutex> const lock {submit_mutex};
+        pending.swap(submit_queue);
+    }
+    for (auto& transfer : pending)
+    {
+        transfer->response.error_message = "Reactor Shutdown";
+        finish(std::move(transfer));
+    }
+}
+
+int GCReactor::socket_callback(void* /*easy*/, int socket, int what, void* userp, void* /*socketp*/)
+{
+    auto* reactor = static_cast<GCReactor*>(userp);
+    if (what == CURL_POLL_REMOVE)
+    {
+        epoll_ctl(reactor->epoll_fd, EPOLL_CTL_DEL, socket, nullptr);
+        return 0;
+    }
+
+    epoll_event event {};
+    event.data.fd = socket;
+    if (what & CURL_POLL_IN)
+    {
+        event.events |= EPOLLIN;
+    }
+    if (what & CURL_POLL_OUT)
+    {
+        event.events |= EPOLLOUT;
+    }
+    if (epoll_ctl(reactor->epoll_fd, EPOLL_CTL_MOD, socket, &event) != 0)
+    {
+        epoll_ctl(reactor->epoll_fd, EPOLL_CTL_ADD, socket, &event);
+    }
+    return 0;
+}
+
+int GCReactor::timer_callback(void* /*multi*/, long timeout_ms, void* userp)
+{
+    auto* reactor              = static_cast<GCReactor*>(userp);
+    reactor->timer_deadline_ms = (timeout_ms < 0) ? -1 : steady_now_ms() + timeout_ms;
+    return 0;
+}
+
+}// namespace gaincapital
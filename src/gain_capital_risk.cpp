@@ -0,0 +1,125 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_risk.h"
+
+#include <algorithm>    // for min
+#include <chrono>       // for steady_clock
+#include <cmath>        // for abs
+#include <cstdint>      // for int64_t
+#include <memory>       // for shared_ptr
+#include <mutex>        // for lock_guard, unique_lock
+#include <shared_mutex> // for shared_lock
+#include <string_view>  // for string_view
+#include <utility>      // for move
+
+namespace gaincapital
+{
+
+GCRiskEngine::GCRiskEngine(std::shared_ptr<GCPositionBook const> position_book) : positions(std::move(position_book)) {}
+
+void GCRiskEngine::set_limits(GCRiskLimits const& limits)
+{
+    std::unique_lock<std::shared_mutex> const lock {config_mutex};
+    default_limits = limits;
+}
+
+void GCRiskEngine::set_market_limits(std::int64_t const market_id, GCRiskLimits const& limits)
+{
+    /*
+     * Replaces the default limits for one market.
+     */
+    std::unique_lock<std::shared_mutex> const lock {config_mutex};
+    market_limits.insert_or_assign(market_id, limits);
+}
+
+void GCRiskEngine::add_rule(GCRiskRule rule)
+{
+    std::unique_lock<std::shared_mutex> const lock {config_mutex};
+    rules.push_back(std::move(rule));
+}
+
+GCRiskResult GCRiskEngine::check(GCRiskOrder const& order, bool const new_order)
+{
+    /*
+     * The order rate is only charged for a new order that passed every other check; resubmissions of the
+     * same order re-run the price checks against the fresh quote without counting against the rate.
+     */
+    std::shared_lock<std::shared_mutex> const lock {config_mutex};
+    auto const it              = market_limits.find(order.market_id);
+    GCRiskLimits const& limits = (it == market_limits.end()) ? default_limits : it->second;
+
+    double const quantity = std::abs(order.signed_quantity);
+    if (limits.max_notional > 0 && quantity * order.price > limits.max_notional)
+    {
+        return GCRiskResult::MaxNotional;
+    }
+    if (limits.max_position > 0 && std::abs(positions->exposure(order.market_id) + order.signed_quantity) > limits.max_position)
+    {
+        return GCRiskResult::MaxPosition;
+    }
+    double const mid_price = (order.bid_price + order.offer_price) / 2;
+    if (limits.price_band > 0 && mid_price > 0 && std::abs(order.price - mid_price) > limits.price_band * mid_price)
+    {
+        return GCRiskResult::PriceBand;
+    }
+    for (GCRiskRule const& rule : rules)
+    {
+        if (! rule(order))
+        {
+            return GCRiskResult::Rule;
+        }
+    }
+    if (new_order && limits.max_orders_per_second > 0 && ! take_rate_token(limits.max_orders_per_second))
+    {
+        return GCRiskResult::OrderRate;
+    }
+    return GCRiskResult::Accepted;
+}
+
+std::string_view GCRiskEngine::describe(GCRiskResult const result) noexcept
+{
+    switch (result)
+    {
+        case GCRiskResult::Accepted:
+            return "Accepted";
+        case GCRiskResult::MaxNotional:
+            return "Max Notional Exceeded";
+        case GCRiskResult::MaxPosition:
+            return "Max Position Exceeded";
+        case GCRiskResult::OrderRate:
+            return "Order Rate Exceeded";
+        case GCRiskResult::PriceBand:
+            return "Price Outside Band";
+        case GCRiskResult::Rule:
+            return "Custom Rule Failed";
+    }
+    return "Unknown";
+}
+
+bool GCRiskEngine::take_rate_token(double const max_orders_per_second)
+{
+    /*
+     * Token bucket holding up to one second of orders, refilled continuously. Shared across markets.
+     */
+    std::lock_guard<std::mutex> const lock {rate_mutex};
+    auto const now = std::chrono::steady_clock::now();
+    if (rate_refilled_at == std::chrono::steady_clock::time_point {})
+    {
+        rate_tokens = max_orders_per_second;
+    }
+    else
+    {
+        double const elapsed = std::chrono::duration<double>(now - rate_refilled_at).count();
+        rate_tokens          = std::min(max_orders_per_second, rate_tokens + elapsed * max_orders_per_second);
+    }
+    rate_refilled_at = now;
+    if (rate_tokens < 1)
+    {
+        return false;
+    }
+    rate_tokens -= 1;
+    return true;
+}
+
+}// namespace gaincapital
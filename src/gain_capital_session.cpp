@@ -0,0 +1,54 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_session.h"
+
+#include <atomic>// for memory_order
+#include <chrono>// for steady_clock
+#include <memory>// for shared_ptr
+#include <mutex> // for mutex
+
+namespace gaincapital
+{
+
+namespace
+{
+
+std::int64_t steady_now_ns() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}// namespace
+
+std::shared_ptr<GCSession const> GCSessionStore::load() const noexcept { return current.load(std::memory_order_acquire); }
+
+void GCSessionStore::publish(GCSession session)
+{
+    /*
+     * Callers must hold the writer mutex; the generation is bumped so waiters can detect a completed refresh.
+     */
+    session.generation = current.load(std::memory_order_relaxed)->generation + 1;
+    current.store(std::make_shared<GCSession const>(std::move(session)), std::memory_order_release);
+    mark_validated();
+}
+
+std::mutex& GCSessionStore::writer_mutex() noexcept { return writer; }
+
+void GCSessionStore::mark_validated() noexcept { validated_at_ns.store(steady_now_ns(), std::memory_order_release); }
+
+bool GCSessionStore::recently_validated() const noexcept
+{
+    /*
+     * True while a background refresher vouches for the session, letting callers skip the inline validation round trip.
+     */
+    std::int64_t const ttl = validation_ttl_ns.load(std::memory_order_relaxed);
+    return ttl > 0 && steady_now_ns() - validated_at_ns.load(std::memory_order_acquire) < ttl;
+}
+
+void GCSessionStore::set_validation_ttl(std::chrono::milliseconds ttl) noexcept
+{
+    validation_ttl_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(ttl).count(), std::memory_order_relaxed);
+}
+
+}// namespace gaincapital
@@ -0,0 +1,540 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_tick_store.h"
+
+#include <algorithm>       // for max, min, partition_point
+#include <array>           // for array
+#include <bit>             // for endian
+#include <cstddef>         // for size_t
+#include <cstdint>         // for int64_t, uint8_t, uint16_t, uint32_t, uint64_t
+#include <cstring>         // for memcpy
+#include <expected>        // for expected
+#include <filesystem>      // for path, copy_file, file_size, resize_file, rename
+#include <fstream>         // for fstream, ifstream, ofstream
+#include <initializer_list>// for initializer_list
+#include <ios>             // for ios_base, streamsize
+#include <source_location> // for source_location
+#include <span>            // for span
+#include <string>          // for basic_string
+#include <string_view>     // for string_view
+#include <system_error>    // for error_code
+#include <utility>         // for move
+#include <vector>          // for vector
+
+#include "gain_capital_bar_builder.h"// for GCBarColumns
+#include "gain_capital_exception.h"  // for GCException
+#include "gain_capital_market_data.h"// for GCPriceTick
+#include "gain_capital_price.h"      // for GCPrice
+
+namespace gaincapital
+{
+
+namespace
+{
+
+static_assert(std::endian::native == std::endian::little, "Tick files are written in host byte order, which must be little-endian");
+
+constexpr std::string_view FILE_MAGIC    = "GCTK";
+constexpr std::string_view TRAILER_MAGIC = "GCTI";
+constexpr std::string_view BAR_MAGIC     = "GCBR";
+constexpr std::uint8_t FORMAT_VERSION    = 1;
+
+constexpr std::size_t HEADER_SIZE       = 16;
+constexpr std::size_t BLOCK_HEADER_SIZE = 8;
+constexpr std::size_t INDEX_ENTRY_SIZE  = 32;
+constexpr std::size_t TRAILER_SIZE      = 16;
+
+struct FileHeader
+{
+    std::uint8_t decimals {};
+    std::uint32_t block_size {};
+};
+
+template <typename T>
+void put(std::string& out, T const value)
+{
+    std::array<char, sizeof(T)> bytes {};
+    std::memcpy(bytes.data(), &value, sizeof(T));
+    out.append(bytes.data(), bytes.size());
+}
+
+template <typename T>
+T get(char const* data) noexcept
+{
+    T value {};
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+std::uint64_t zigzag(std::int64_t const value) noexcept { return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63); }
+
+std::int64_t unzigzag(std::uint64_t const value) noexcept { return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1); }
+
+void put_varint(std::string& out, std::uint64_t value)
+{
+    std::array<char, 10> bytes {};
+    std::size_t length = 0;
+    while (value >= 0x80)
+    {
+        bytes[length++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    bytes[length++] = static_cast<char>(value);
+    out.append(bytes.data(), length);
+}
+
+bool get_varint(char const*& data, char const* end, std::uint64_t& value) noexcept
+{
+    value = 0;
+    for (unsigned shift = 0; data < end && shift < 64; shift += 7)
+    {
+        auto const byte = static_cast<std::uint8_t>(*data++);
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (byte < 0x80)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+std::expected<T, GCException> file_error(std::string_view reason, std::filesystem::path const& path,
+                                         std::source_location const& location = std::source_location::current())
+{
+    return std::expected<T, GCException> {std::unexpect, location.function_name(),
+                                          "Tick File Error - " + std::string(reason) + " - " + path.string()};
+}
+
+template <typename T>
+std::expected<T, GCException> bar_file_error(std::string_view reason, std::filesystem::path const& path,
+                                             std::source_location const& location = std::source_location::current())
+{
+    return std::expected<T, GCException> {std::unexpect, location.function_name(),
+                                          "Bar File Error - " + std::string(reason) + " - " + path.string()};
+}
+
+std::expected<FileHeader, GCException> read_layout(std::istream& file, std::filesystem::path const& path, std::vector<GCTickBlockIndex>& index)
+{
+    /*
+     * Validates header and trailer and loads the block index, which lies between the last block and the trailer.
+     */
+    std::error_code error;
+    std::uint64_t const size = std::filesystem::file_size(path, error);
+    if (error || size < HEADER_SIZE + TRAILER_SIZE)
+    {
+        return file_error<FileHeader>("Truncated File", path);
+    }
+    std::array<char, HEADER_SIZE> header {};
+    std::array<char, TRAILER_SIZE> trailer {};
+    file.seekg(0);
+    file.read(header.data(), header.size());
+    file.seekg(static_cast<std::streamoff>(size - TRAILER_SIZE));
+    file.read(trailer.data(), trailer.size());
+    if (! file || std::string_view {header.data(), 4} != FILE_MAGIC || std::string_view {trailer.data() + 12, 4} != TRAILER_MAGIC)
+    {
+        return file_error<FileHeader>("Invalid Header", path);
+    }
+    if (static_cast<std::uint8_t>(header[4]) != FORMAT_VERSION)
+    {
+        return file_error<FileHeader>("Unsupported Version", path);
+    }
+
+    auto const index_offset  = get<std::uint64_t>(trailer.data());
+    auto const index_entries = get<std::uint32_t>(trailer.data() + 8);
+    if (index_offset < HEADER_SIZE || index_offset + index_entries * INDEX_ENTRY_SIZE + TRAILER_SIZE != size)
+    {
+        return file_error<FileHeader>("Corrupt Index", path);
+    }
+    std::string entries(index_entries * INDEX_ENTRY_SIZE, '\0');
+    file.seekg(static_cast<std::streamoff>(index_offset));
+    file.read(entries.data(), static_cast<std::streamsize>(entries.size()));
+    if (! file)
+    {
+        return file_error<FileHeader>("Corrupt Index", path);
+    }
+    index.clear();
+    index.reserve(index_entries);
+    for (std::size_t i = 0; i < index_entries; ++i)
+    {
+        char const* entry = entries.data() + i * INDEX_ENTRY_SIZE;
+        index.push_back({get<std::int64_t>(entry), get<std::int64_t>(entry + 8), get<std::uint64_t>(entry + 16), get<std::uint32_t>(entry + 24)});
+    }
+    return FileHeader {static_cast<std::uint8_t>(header[5]), get<std::uint32_t>(header.data() + 8)};
+}
+
+}// namespace
+
+// =================================================================================
+// Writer
+// =================================================================================
+
+std::expected<GCTickWriter, GCException> GCTickWriter::open(std::filesystem::path const& path, std::uint8_t const decimals,
+                                                            std::uint32_t const block_size)
+{
+    /*
+     * Creates the file, or reopens an existing one to append after its last block. An existing file keeps
+     * its own block size and must have been written at the same decimals. Writes go to a copy beside the
+     * file that is renamed into place on close, so a crash mid-write leaves the previous file intact.
+     */
+    GCTickWriter writer;
+    writer.file_path       = path;
+    writer.temporary_path  = path;
+    writer.temporary_path += ".tmp";
+    writer.price_decimals  = std::min(decimals, GCPrice::MAX_DECIMALS);
+    writer.ticks_per_block = std::max<std::uint32_t>(block_size, 1);
+
+    std::error_code error;
+    if (! std::filesystem::exists(path, error) || std::filesystem::file_size(path, error) == 0)
+    {
+        writer.file.open(writer.temporary_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        std::string header {FILE_MAGIC};
+        header += static_cast<char>(FORMAT_VERSION);
+        header += static_cast<char>(writer.price_decimals);
+        put<std::uint16_t>(header, 0);
+        put<std::uint32_t>(header, writer.ticks_per_block);
+        put<std::uint32_t>(header, 0);
+        writer.file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        if (! writer.file)
+        {
+            writer.file.close();
+            std::filesystem::remove(writer.temporary_path, error);
+            return file_error<GCTickWriter>("Cannot Create File", path);
+        }
+        writer.write_offset = HEADER_SIZE;
+        return writer;
+    }
+    // -------------------
+    /* The original is validated before it is copied; a rejected file is never touched */
+    {
+        std::ifstream original {path, std::ios_base::in | std::ios_base::binary};
+        if (! original)
+        {
+            return file_error<GCTickWriter>("Cannot Open File", path);
+        }
+        auto layout = read_layout(original, path, writer.index);
+        if (! layout)
+        {
+            return std::expected<GCTickWriter, GCException> {std::unexpect, std::move(layout.error())};
+        }
+        if (layout.value().decimals != writer.price_decimals)
+        {
+            return file_error<GCTickWriter>("Decimals Mismatch", path);
+        }
+        writer.ticks_per_block = layout.value().block_size;
+    }
+    std::filesystem::copy_file(path, writer.temporary_path, std::filesystem::copy_options::overwrite_existing, error);
+    if (! error)
+    {
+        writer.file.open(writer.temporary_path, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    }
+    if (error || ! writer.file)
+    {
+        std::filesystem::remove(writer.temporary_path, error);
+        return file_error<GCTickWriter>("Cannot Copy File", path);
+    }
+    writer.write_offset = HEADER_SIZE;
+    for (GCTickBlockIndex const& block : writer.index)
+    {
+        writer.total_ticks += block.count;
+    }
+    if (! writer.index.empty())
+    {
+        writer.previous_ms = writer.index.back().last_ms;
+        /* Blocks end where the index begins */
+        writer.write_offset = std::filesystem::file_size(path, error) - TRAILER_SIZE - writer.index.size() * INDEX_ENTRY_SIZE;
+    }
+    return writer;
+}
+
+GCTickWriter::~GCTickWriter()
+{
+    if (file.is_open())
+    {
+        [[maybe_unused]] auto const close_response = close();
+    }
+}
+
+std::expected<std::size_t, GCException> GCTickWriter::append(std::span<GCPriceTick const> ticks)
+{
+    /*
+     * :return: number of ticks appended; a tick older than its predecessor stops the append with an error
+     */
+    if (! file.is_open())
+    {
+        return file_error<std::size_t>("Writer Closed", file_path);
+    }
+    for (GCPriceTick const& tick : ticks)
+    {
+        if (tick.timestamp_ms < previous_ms)
+        {
+            return file_error<std::size_t>("Ticks Must Be Appended Oldest First", file_path);
+        }
+        std::int64_t const units = tick.price.rescale(price_decimals).units();
+        if (block_ticks == 0)
+        {
+            block_first_ms = tick.timestamp_ms;
+            put_varint(block_payload, zigzag(tick.timestamp_ms));
+            put_varint(block_payload, zigzag(units));
+        }
+        else
+        {
+            put_varint(block_payload, static_cast<std::uint64_t>(tick.timestamp_ms - previous_ms));
+            put_varint(block_payload, zigzag(units - previous_units));
+        }
+        previous_ms    = tick.timestamp_ms;
+        previous_units = units;
+        ++total_ticks;
+        if (++block_ticks == ticks_per_block && ! flush_block())
+        {
+            return file_error<std::size_t>("Write Failed", file_path);
+        }
+    }
+    return ticks.size();
+}
+
+std::expected<bool, GCException> GCTickWriter::close()
+{
+    /*
+     * Writes the partial block, the index and the trailer, trims anything left past them, then renames the
+     * copy over the file.
+     */
+    if (! file.is_open())
+    {
+        return true;
+    }
+    std::error_code error;
+    if (! flush_block())
+    {
+        file.close();
+        std::filesystem::remove(temporary_path, error);
+        return file_error<bool>("Write Failed", file_path);
+    }
+    std::string footer;
+    footer.reserve(index.size() * INDEX_ENTRY_SIZE + TRAILER_SIZE);
+    for (GCTickBlockIndex const& block : index)
+    {
+        put<std::int64_t>(footer, block.first_ms);
+        put<std::int64_t>(footer, block.last_ms);
+        put<std::uint64_t>(footer, block.offset);
+        put<std::uint32_t>(footer, block.count);
+        put<std::uint32_t>(footer, 0);
+    }
+    put<std::uint64_t>(footer, write_offset);
+    put<std::uint32_t>(footer, static_cast<std::uint32_t>(index.size()));
+    footer += TRAILER_MAGIC;
+
+    file.seekp(static_cast<std::streamoff>(write_offset));
+    file.write(footer.data(), static_cast<std::streamsize>(footer.size()));
+    bool const written = file.good();
+    file.close();
+
+    std::filesystem::resize_file(temporary_path, write_offset + footer.size(), error);
+    if (written && ! error)
+    {
+        std::filesystem::rename(temporary_path, file_path, error);
+    }
+    if (! written || error)
+    {
+        std::filesystem::remove(temporary_path, error);
+        return file_error<bool>("Write Failed", file_path);
+    }
+    return true;
+}
+
+std::uint64_t GCTickWriter::tick_count() const noexcept { return total_ticks; }
+
+bool GCTickWriter::flush_block()
+{
+    if (block_ticks == 0)
+    {
+        return true;
+    }
+    std::string block_header;
+    put<std::uint32_t>(block_header, block_ticks);
+    put<std::uint32_t>(block_header, static_cast<std::uint32_t>(block_payload.size()));
+    file.seekp(static_cast<std::streamoff>(write_offset));
+    file.write(block_header.data(), static_cast<std::streamsize>(block_header.size()));
+    file.write(block_payload.data(), static_cast<std::streamsize>(block_payload.size()));
+
+    index.push_back({block_first_ms, previous_ms, write_offset, block_ticks});
+    write_offset += BLOCK_HEADER_SIZE + block_payload.size();
+    block_payload.clear();
+    block_ticks = 0;
+    return file.good();
+}
+
+// =================================================================================
+// Reader
+// =================================================================================
+
+std::expected<GCTickReader, GCException> GCTickReader::open(std::filesystem::path const& path)
+{
+    GCTickReader reader;
+    reader.file.open(path, std::ios_base::in | std::ios_base::binary);
+    if (! reader.file)
+    {
+        return file_error<GCTickReader>("Cannot Open File", path);
+    }
+    auto layout = read_layout(reader.file, path, reader.index);
+    if (! layout)
+    {
+        return std::expected<GCTickReader, GCException> {std::unexpect, std::move(layout.error())};
+    }
+    reader.price_decimals = layout.value().decimals;
+    for (GCTickBlockIndex const& block : reader.index)
+    {
+        reader.total_ticks += block.count;
+    }
+    return reader;
+}
+
+std::expected<std::vector<GCPriceTick>, GCException> GCTickReader::read(std::int64_t const from_ms, std::int64_t const to_ms)
+{
+    /*
+     * :return: ticks with from_ms <= timestamp <= to_ms, oldest first
+     */
+    auto const first = std::partition_point(index.begin(), index.end(), [from_ms](GCTickBlockIndex const& entry) { return entry.last_ms < from_ms; });
+    auto const last  = std::partition_point(first, index.end(), [to_ms](GCTickBlockIndex const& entry) { return entry.first_ms <= to_ms; });
+
+    std::size_t capacity = 0;
+    for (auto block = first; block != last; ++block)
+    {
+        capacity += block->count;
+    }
+    std::vector<GCPriceTick> ticks;
+    ticks.reserve(capacity);
+    for (auto block = first; block != last; ++block)
+    {
+        std::array<char, BLOCK_HEADER_SIZE> block_header {};
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(block->offset));
+        file.read(block_header.data(), block_header.size());
+        block_buffer.resize(get<std::uint32_t>(block_header.data() + 4));
+        file.read(block_buffer.data(), static_cast<std::streamsize>(block_buffer.size()));
+        if (! file || get<std::uint32_t>(block_header.data()) != block->count)
+        {
+            return std::expected<std::vector<GCPriceTick>, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                                         "Tick File Error - Truncated Block"};
+        }
+        ++decoded_blocks;
+
+        char const* data      = block_buffer.data();
+        char const* const end = data + block_buffer.size();
+        std::uint64_t timestamp_bits {};
+        std::uint64_t units_bits {};
+        bool valid             = get_varint(data, end, timestamp_bits) && get_varint(data, end, units_bits);
+        std::int64_t timestamp = unzigzag(timestamp_bits);
+        std::int64_t units     = unzigzag(units_bits);
+        for (std::uint32_t i = 0; valid && i < block->count; ++i)
+        {
+            if (i != 0)
+            {
+                valid = get_varint(data, end, timestamp_bits) && get_varint(data, end, units_bits);
+                if (! valid)
+                {
+                    break;
+                }
+                timestamp += static_cast<std::int64_t>(timestamp_bits);
+                units += unzigzag(units_bits);
+            }
+            if (timestamp >= from_ms && timestamp <= to_ms)
+            {
+                ticks.emplace_back(timestamp, GCPrice::from_units(units, price_decimals));
+            }
+        }
+        if (! valid)
+        {
+            return std::expected<std::vector<GCPriceTick>, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                                         "Tick File Error - Corrupt Block"};
+        }
+    }
+    return ticks;
+}
+
+std::vector<GCTickBlockIndex> const& GCTickReader::blocks() const noexcept { return index; }
+
+std::uint64_t GCTickReader::tick_count() const noexcept { return total_ticks; }
+
+std::uint8_t GCTickReader::decimals() const noexcept { return price_decimals; }
+
+std::uint64_t GCTickReader::blocks_decoded() const noexcept { return decoded_blocks; }
+
+std::expected<bool, GCException> write_bar_file(std::filesystem::path const& path, GCBarColumns const& bars)
+{
+    std::size_t const count = bars.size();
+    if (bars.open.size() != count || bars.high.size() != count || bars.low.size() != count || bars.close.size() != count)
+    {
+        return bar_file_error<bool>("Column Lengths Differ", path);
+    }
+    std::string header;
+    header.reserve(HEADER_SIZE);
+    header.append(BAR_MAGIC);
+    put<std::uint8_t>(header, FORMAT_VERSION);
+    put<std::uint8_t>(header, bars.decimals);
+    put<std::uint16_t>(header, 0);
+    put<std::uint64_t>(header, count);
+
+    std::filesystem::path temporary_path = path;
+    temporary_path += ".tmp";
+    {
+        std::ofstream file {temporary_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc};
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        for (std::vector<std::int64_t> const* column : {&bars.timestamp_ms, &bars.open, &bars.high, &bars.low, &bars.close})
+        {
+            file.write(reinterpret_cast<char const*>(column->data()), static_cast<std::streamsize>(count * sizeof(std::int64_t)));
+        }
+        if (! file.flush())
+        {
+            return bar_file_error<bool>("Write Failed", temporary_path);
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary_path, path, error);
+    if (error)
+    {
+        return bar_file_error<bool>("Rename Failed", path);
+    }
+    return true;
+}
+
+std::expected<GCBarColumns, GCException> read_bar_file(std::filesystem::path const& path)
+{
+    std::ifstream file {path, std::ios_base::in | std::ios_base::binary};
+    if (! file)
+    {
+        return bar_file_error<GCBarColumns>("Cannot Open File", path);
+    }
+    std::array<char, HEADER_SIZE> header {};
+    file.read(header.data(), header.size());
+    if (! file || std::string_view {header.data(), BAR_MAGIC.size()} != BAR_MAGIC)
+    {
+        return bar_file_error<GCBarColumns>("Not a Bar File", path);
+    }
+    if (get<std::uint8_t>(header.data() + 4) != FORMAT_VERSION)
+    {
+        return bar_file_error<GCBarColumns>("Unsupported Version", path);
+    }
+    std::error_code error;
+    std::uint64_t const count = get<std::uint64_t>(header.data() + 8);
+    if (std::filesystem::file_size(path, error) != HEADER_SIZE + count * 5 * sizeof(std::int64_t) || error)
+    {
+        return bar_file_error<GCBarColumns>("Truncated File", path);
+    }
+    // -------------------
+    GCBarColumns bars;
+    bars.decimals = get<std::uint8_t>(header.data() + 5);
+    for (std::vector<std::int64_t>* column : {&bars.timestamp_ms, &bars.open, &bars.high, &bars.low, &bars.close})
+    {
+        column->resize(count);
+        file.read(reinterpret_cast<char*>(column->data()), static_cast<std::streamsize>(count * sizeof(std::int64_t)));
+    }
+    if (! file)
+    {
+        return bar_file_error<GCBarColumns>("Truncated File", path);
+    }
+    return bars;
+}
+
+}// namespace gaincapital
@@ -0,0 +1,365 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_transport.h"
+
+#include <algorithm>      // for max
+#include <array>          // for array
+#include <bit>            // for endian
+#include <chrono>         // for steady_clock, microseconds
+#include <cstddef>        // for size_t
+#include <cstdint>        // for int64_t, uint8_t, uint32_t, uint64_t
+#include <cstring>        // for memcpy
+#include <expected>       // for expected
+#include <filesystem>     // for path
+#include <fstream>        // for ifstream, ofstream
+#include <ios>            // for ios_base, streamsize
+#include <memory>         // for shared_ptr
+#include <mutex>          // for mutex, lock_guard, unique_lock
+#include <source_location>// for source_location
+#include <string>         // for basic_string
+#include <string_view>    // for string_view
+#include <utility>        // for move, pair
+
+#include "cpr/cprtypes.h"          // for Header
+#include "gain_capital_exception.h"// for GCException
+
+namespace gaincapital
+{
+
+namespace
+{
+
+static_assert(std::endian::native == std::endian::little, "Session logs are written in host byte order, which must be little-endian");
+
+constexpr std::string_view LOG_MAGIC    = "GCRR";
+constexpr std::uint8_t LOG_VERSION      = 1;
+constexpr std::size_t HEADER_SIZE       = 8;
+constexpr long OK                       = 200;
+constexpr long NOT_FOUND                = 404;
+constexpr std::string_view REPLAY_LOGON = R"({"statusCode":0,"session":"REPLAYED_SESSION"})";
+
+template <typename T>
+void put(std::string& out, T const value)
+{
+    std::array<char, sizeof(T)> bytes {};
+    std::memcpy(bytes.data(), &value, sizeof(T));
+    out.append(bytes.data(), bytes.size());
+}
+
+void put_string(std::string& out, std::string_view text)
+{
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(text.size()));
+    out.append(text);
+}
+
+template <typename T>
+bool get(std::istream& in, T& value)
+{
+    std::array<char, sizeof(T)> bytes {};
+    if (! in.read(bytes.data(), bytes.size()))
+    {
+        return false;
+    }
+    std::memcpy(&value, bytes.data(), sizeof(T));
+    return true;
+}
+
+bool get_string(std::istream& in, std::string& text)
+{
+    std::uint32_t size {};
+    if (! get(in, size))
+    {
+        return false;
+    }
+    text.resize(size);
+    return static_cast<bool>(in.read(text.data(), static_cast<std::streamsize>(size)));
+}
+
+std::string_view request_path(std::string_view url) noexcept
+{
+    /*
+     * :return: the URL without scheme and host, so a log recorded against one server replays against any other
+     */
+    std::size_t const scheme = url.find("://");
+    if (scheme == std::string_view::npos)
+    {
+        return url;
+    }
+    std::size_t const path = url.find('/', scheme + 3);
+    return path == std::string_view::npos ? std::string_view {"/"} : url.substr(path);
+}
+
+bool is_logon(std::string_view type, std::string_view url) noexcept
+{
+    std::string_view const path = request_path(url);
+    return type == "POST" && path.size() >= 8 && path.substr(path.size() - 8) == "/Session";
+}
+
+template <typename T>
+std::expected<T, GCException> log_error(std::string_view reason, std::filesystem::path const& path,
+                                        std::source_location const& location = std::source_location::current())
+{
+    return std::expected<T, GCException> {std::unexpect, location.function_name(),
+                                          "Session Log Error - " + std::string(reason) + " - " + path.string()};
+}
+
+}// namespace
+
+struct GCRecordingTransport::Log
+{
+    std::mutex mutex;
+    std::ofstream file;
+    std::filesystem::path path;
+    std::chrono::steady_clock::time_point start;
+    std::string record;
+    std::uint64_t count {};
+    bool failed {};
+
+    void append(std::chrono::steady_clock::time_point const submitted, NetworkRequest const& request, NetworkResponse const& response)
+    {
+        auto const completed = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> const lock {mutex};
+
+        // The Steady Clock Never Runs Backwards, so Both Offsets Are Non-Negative
+        record.clear();
+        put<std::uint64_t>(record, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(submitted - start).count()));
+        put<std::uint64_t>(record, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(completed - submitted).count()));
+        put<std::int64_t>(record, response.status_code);
+        // The Logon Payload Holds the Password and Its Response the Session Token
+        bool const logon = is_logon(request.type, request.url);
+        put_string(record, request.type);
+        put_string(record, request.url);
+        put_string(record, logon ? std::string_view {} : std::string_view {request.payload});
+        put_string(record, logon ? std::string_view {} : std::string_view {response.text});
+        put_string(record, response.error_message);
+        put<std::uint32_t>(record, static_cast<std::uint32_t>(response.header.size()));
+        for (auto const& [key, value] : response.header)
+        {
+            put_string(record, key);
+            put_string(record, value);
+        }
+        failed = ! file.write(record.data(), static_cast<std::streamsize>(record.size())) || failed;
+        ++count;
+    }
+};
+
+std::expected<std::shared_ptr<GCRecordingTransport>, GCException> GCRecordingTransport::open(std::filesystem::path const& path,
+                                                                                            std::shared_ptr<GCTransport> inner)
+{
+    /*
+     * :path: session log to create, replacing any existing file
+     * :inner: transport that carries the requests, e.g. GCClient::get_transport()
+     */
+    auto log  = std::make_shared<Log>();
+    log->path = path;
+    log->file.open(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+    std::string header;
+    header.append(LOG_MAGIC);
+    put<std::uint8_t>(header, LOG_VERSION);
+    header.append(HEADER_SIZE - header.size(), '\0');
+    if (! log->file || ! log->file.write(header.data(), static_cast<std::streamsize>(header.size())))
+    {
+        return log_error<std::shared_ptr<GCRecordingTransport>>("Cannot Create File", path);
+    }
+    log->start = std::chrono::steady_clock::now();
+
+    std::shared_ptr<GCRecordingTransport> recorder {new GCRecordingTransport {}};
+    recorder->inner = std::move(inner);
+    recorder->log   = std::move(log);
+    return recorder;
+}
+
+std::uint64_t GCRecordingTransport::submit(NetworkRequest request, NetworkCallback callback)
+{
+    /*
+     * Records the exchange before handing the response on, so a log flushed after a call returns includes it.
+     */
+    auto const submitted = std::chrono::steady_clock::now();
+    NetworkRequest recorded {request.type, request.url, {}, request.payload};
+    return inner->submit(std::move(request),
+                         [log = log, submitted, recorded = std::move(recorded), callback = std::move(callback)](NetworkResponse&& response)
+                         {
+                             log->append(submitted, recorded, response);
+                             callback(std::move(response));
+                         });
+}
+
+void GCRecordingTransport::cancel(std::uint64_t const id) { inner->cancel(id); }
+
+std::size_t GCRecordingTransport::in_flight() const noexcept { return inner->in_flight(); }
+
+std::expected<bool, GCException> GCRecordingTransport::flush()
+{
+    std::lock_guard<std::mutex> const lock {log->mutex};
+    if (log->failed || ! log->file.flush())
+    {
+        return log_error<bool>("Write Failed", log->path);
+    }
+    return true;
+}
+
+std::uint64_t GCRecordingTransport::records() const noexcept
+{
+    std::lock_guard<std::mutex> const lock {log->mutex};
+    return log->count;
+}
+
+std::expected<std::shared_ptr<GCReplayTransport>, GCException> GCReplayTransport::open(std::filesystem::path const& path, double const speed)
+{
+    /*
+     * Loads the whole session log; a record cut short by an interrupted recording ends the log.
+     * :speed: multiplier on the recorded latencies
+     */
+    std::ifstream file {path, std::ios_base::in | std::ios_base::binary};
+    if (! file)
+    {
+        return log_error<std::shared_ptr<GCReplayTransport>>("Cannot Open File", path);
+    }
+    std::array<char, HEADER_SIZE> header {};
+    if (! file.read(header.data(), header.size()) || std::string_view {header.data(), LOG_MAGIC.size()} != LOG_MAGIC)
+    {
+        return log_error<std::shared_ptr<GCReplayTransport>>("Not a Session Log", path);
+    }
+    if (static_cast<std::uint8_t>(header[LOG_MAGIC.size()]) != LOG_VERSION)
+    {
+        return log_error<std::shared_ptr<GCReplayTransport>>("Unsupported Version", path);
+    }
+    // -------------------
+    std::shared_ptr<GCReplayTransport> replay {new GCReplayTransport {}};
+    replay->latency_scale = std::max(speed, 0.0);
+
+    NetworkRequest request;
+    Exchange exchange;
+    std::uint64_t submitted_us {};
+    std::uint64_t latency_us {};
+    std::int64_t status_code {};
+    std::uint32_t header_count {};
+    while (get(file, submitted_us) && get(file, latency_us) && get(file, status_code) && get_string(file, request.type) &&
+           get_string(file, request.url) && get_string(file, request.payload) && get_string(file, exchange.response.text) &&
+           get_string(file, exchange.response.error_message) && get(file, header_count))
+    {
+        exchange.response.header.clear();
+        std::string key, value;
+        for (std::uint32_t i = 0; i < header_count && get_string(file, key) && get_string(file, value); ++i)
+        {
+            exchange.response.header[key] = value;
+        }
+        if (! file)
+        {
+            break;
+        }
+        exchange.latency_us           = static_cast<std::int64_t>(latency_us);
+        exchange.response.status_code = status_code;
+        if (status_code == OK && exchange.response.text.empty() && is_logon(request.type, request.url))
+        {
+            // The Recorded Token Was Never Written | Any Session Authenticates Against the Replay
+            exchange.response.text = REPLAY_LOGON;
+        }
+
+        std::string path_key = request.type + ' ' + std::string(request_path(request.url));
+        replay->exact_matches[path_key + '\n' + request.payload].exchanges.push_back(replay->exchanges.size());
+        replay->path_matches[std::move(path_key)].exchanges.push_back(replay->exchanges.size());
+        replay->exchanges.push_back(std::move(exchange));
+        exchange = Exchange {};
+    }
+    replay->replay_thread = std::thread(&GCReplayTransport::run, replay.get());
+    return replay;
+}
+
+GCReplayTransport::~GCReplayTransport()
+{
+    {
+        std::lock_guard<std::mutex> const lock {mutex};
+        stopping = true;
+    }
+    pending_ready.notify_one();
+    if (replay_thread.joinable())
+    {
+        replay_thread.join();
+    }
+}
+
+std::uint64_t GCReplayTransport::submit(NetworkRequest request, NetworkCallback callback)
+{
+    std::string path_key  = request.type + ' ' + std::string(request_path(request.url));
+    std::string exact_key = path_key + '\n' + request.payload;
+    auto due              = std::chrono::steady_clock::now();
+    NetworkResponse response;
+    {
+        std::lock_guard<std::mutex> const lock {mutex};
+        Responses* responses = nullptr;
+        if (auto const exact = exact_matches.find(exact_key); exact != exact_matches.end())
+        {
+            responses = &exact->second;
+        }
+        else if (auto const loose = path_matches.find(path_key); loose != path_matches.end())
+        {
+            responses = &loose->second;
+        }
+
+        if (responses != nullptr)
+        {
+            Exchange const& recorded = exchanges[responses->exchanges[responses->cursor++ % responses->exchanges.size()]];
+            response                 = recorded.response;
+            due += std::chrono::microseconds {static_cast<std::int64_t>(static_cast<double>(recorded.latency_us) * latency_scale)};
+        }
+        else
+        {
+            miss_count.fetch_add(1, std::memory_order_relaxed);
+            response.status_code = NOT_FOUND;
+            response.text        = "Replay Error - No Recorded Response - " + path_key;
+        }
+        if (request.deadline < due)
+        {
+            // A Recorded Response Slower Than the Deadline Times Out as It Would Have Live
+            due                        = request.deadline;
+            response                   = NetworkResponse {};
+            response.error_message     = "Deadline Exceeded";
+            response.deadline_exceeded = true;
+        }
+        pending.emplace(due, std::pair {std::move(response), std::move(callback)});
+    }
+    pending_ready.notify_one();
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::size_t GCReplayTransport::in_flight() const noexcept
+{
+    std::lock_guard<std::mutex> const lock {mutex};
+    return pending.size();
+}
+
+std::size_t GCReplayTransport::size() const noexcept { return exchanges.size(); }
+
+std::uint64_t GCReplayTransport::misses() const noexcept { return miss_count.load(std::memory_order_relaxed); }
+
+void GCReplayTransport::run()
+{
+    /*
+     * Delivers responses in due order. On shutdown the remaining responses are delivered at once,
+     * so no caller waits forever.
+     */
+    std::unique_lock<std::mutex> lock {mutex};
+    while (! stopping || ! pending.empty())
+    {
+        if (pending.empty())
+        {
+            pending_ready.wait(lock);
+            continue;
+        }
+        auto const due = pending.begin()->first;
+        if (! stopping && due > std::chrono::steady_clock::now())
+        {
+            pending_ready.wait_until(lock, due);
+            continue;
+        }
+        auto node = pending.extract(pending.begin());
+        lock.unlock();
+        node.mapped().second(std::move(node.mapped().first));
+        lock.lock();
+    }
+}
+
+}// namespace gaincapital
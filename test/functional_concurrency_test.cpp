@@ -0,0 +1,296 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "httpmockserver/mock_server.h"
+#include "httpmockserver/test_environment.h"
+#include "gtest/gtest.h"
+
+#include "gain_capital_client.h"
+#include "gain_capital_exception.h"
+
+namespace
+{
+
+namespace GC = gaincapital;
+
+std::string const URL = "http://localhost:9202";
+
+std::atomic<int> session_counter {0};
+std::atomic<int> validate_counter {0};
+std::atomic<int> slow_market_counter {0};
+
+class HTTPMock : public httpmock::MockServer
+{
+  public:
+    /// Create HTTP server on port 9202
+    explicit HTTPMock(int port = 9202) : MockServer(port) {}
+
+  private:
+    /// Handler called by MockServer on HTTP request.
+    Response responseHandler(std::string const& url, std::string const& method, std::string const& data, std::vector<UrlArg> const& urlArguments,
+                             std::vector<Header> const& headers) override
+    {
+        // Authenticate Session | New Token Each Time
+        if (method == "POST" && url == "/Session")
+        {
+            return Response(200, "{\"statusCode\": 0, \"session\": \"" + std::to_string(++session_counter) + "\"}");
+        }
+        // Validate Session | Expire Every Fourth Check
+        else if (method == "POST" && matchesPrefix(url, "/Session/validate"))
+        {
+            return Response(200, (++validate_counter % 4 == 0) ? "{\"isAuthenticated\": false}" : "{\"isAuthenticated\": true}");
+        }
+        // Account Info
+        else if (method == "GET" && matchesPrefix(url, "/userAccount/ClientAndTradingAccount"))
+        {
+            return Response(200, "{\"tradingAccounts\": [{\"tradingAccountId\":\"TradingTestID\", \"clientAccountId\":\"ClientTestID\"}]}");
+        }
+        // Market IDs | Slow Lookup Counted for Coalescing
+        else if (method == "GET" && matchesPrefix(url, "/cfd/markets") && ! urlArguments.empty() && urlArguments[0].value == "SLOW_MARKET")
+        {
+            ++slow_market_counter;
+            std::this_thread::sleep_for(std::chrono::milliseconds {100});
+            return Response(200, "{\"Markets\": [{\"MarketId\": 456}]}");
+        }
+        // Market IDs
+        else if (method == "GET" && matchesPrefix(url, "/cfd/markets"))
+        {
+            return Response(200, "{\"Markets\": [{\"MarketId\": 123}]}");
+        }
+        // Prices
+        else if (method == "GET" && matchesPrefix(url, "/market/123/tickhistory"))
+        {
+            return Response(200, "{\"PriceTicks\":[{\"Price\" : 1.0}]}");
+        }
+        // List Open Positons
+        else if (method == "GET" && matchesPrefix(url, "/order/openpositions"))
+        {
+            return Response(200, "{\"OpenPositions\": []}");
+        }
+        // Return "URI not found" for the undefined methods
+        return Response(404, "Not Found");
+    }
+
+    /// Return true if \p url starts with \p str.
+    bool matchesPrefix(std::string const& url, std::string const& str) const { return url.substr(0, str.size()) == str; }
+};
+
+TEST(GainCapital_Concurrency, Shared_Client_Stress_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    int const THREADS    = 8;
+    int const ITERATIONS = 40;
+    std::atomic<int> failures {0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back(
+            [&gc, &failures, t]
+            {
+                std::string const market = "MARKET_" + std::to_string(t % 3);
+                for (int i = 0; i < ITERATIONS; ++i)
+                {
+                    if (! gc.get_prices(market))
+                    {
+                        ++failures;
+                    }
+                    if (! gc.list_open_positions())
+                    {
+                        ++failures;
+                    }
+                    if (i % 10 == 0 && ! gc.authenticate_session())
+                    {
+                        ++failures;
+                    }
+                    auto const session = gc.get_session();
+                    if (session->trading_account_id != "\"TradingTestID\"" || session->header.empty())
+                    {
+                        ++failures;
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_GT(gc.get_session()->generation, 1U);
+    EXPECT_EQ(gc.market_id_map.size(), 3U);
+}
+
+TEST(GainCapital_Concurrency, Concurrent_Reauthentication_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    int const THREADS = 8;
+    std::atomic<int> failures {0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back(
+            [&gc, &failures]
+            {
+                for (int i = 0; i < 25; ++i)
+                {
+                    if (! gc.validate_session())
+                    {
+                        ++failures;
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(gc.get_session()->header.at("UserName"), "USER");
+}
+
+TEST(GainCapital_Concurrency, Coalesced_Market_ID_Lookup_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    int const THREADS = 8;
+    std::atomic<int> failures {0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back(
+            [&gc, &failures]
+            {
+                auto market_id_response = gc.return_market_id("SLOW_MARKET");
+                if (! market_id_response || market_id_response.value() != "456")
+                {
+                    ++failures;
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_LT(slow_market_counter.load(), THREADS);
+}
+
+TEST(GainCapital_Concurrency, Keep_Alive_Proactive_Refresh_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    auto const initial_generation = gc.get_session()->generation;
+
+    auto keep_alive_response = gc.start_session_keep_alive(std::chrono::milliseconds {20}, std::chrono::milliseconds {50});
+
+    if (! keep_alive_response)
+    {
+        FAIL();
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {300});
+
+    EXPECT_TRUE(gc.list_open_positions().has_value());
+    EXPECT_GT(gc.get_session()->generation, initial_generation);
+
+    gc.stop_session_keep_alive();
+}
+
+TEST(GainCapital_Concurrency, Keep_Alive_Skips_Inline_Validation_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    auto keep_alive_response = gc.start_session_keep_alive(std::chrono::seconds {30});
+
+    if (! keep_alive_response)
+    {
+        FAIL();
+    }
+
+    int const validations_before = validate_counter.load();
+
+    for (int i = 0; i < 20; ++i)
+    {
+        EXPECT_TRUE(gc.list_open_positions().has_value());
+    }
+
+    EXPECT_EQ(validate_counter.load(), validations_before);
+}
+
+TEST(GainCapital_Concurrency, Keep_Alive_Refresh_Cycles_Skip_Inline_Validation_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    auto const interval = std::chrono::milliseconds {20};
+    auto const start    = std::chrono::steady_clock::now();
+    int const before    = validate_counter.load();
+
+    auto keep_alive_response = gc.start_session_keep_alive(interval);
+
+    if (! keep_alive_response)
+    {
+        FAIL();
+    }
+
+    // Poll Across Many Refresh Cycles | Only the Keep-Alive Should Validate
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds {400})
+    {
+        EXPECT_TRUE(gc.list_open_positions().has_value());
+    }
+    gc.stop_session_keep_alive();
+
+    auto const cycles = (std::chrono::steady_clock::now() - start) / interval;
+    EXPECT_GT(validate_counter.load() - before, 0);
+    EXPECT_LE(validate_counter.load() - before, cycles + 1);
+}
+
+TEST(GainCapital_Concurrency, Keep_Alive_Requires_Session_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+
+    auto keep_alive_response = gc.start_session_keep_alive();
+
+    if (! keep_alive_response)
+    {
+        EXPECT_EQ(std::string(keep_alive_response.error().what()), "Session Not Authenticated, Run 'authenticate_session' Command");
+    }
+    else
+    {
+        FAIL();
+    }
+}
+
+}// namespace
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new httpmock::TestEnvironment<HTTPMock>());
+    return RUN_ALL_TESTS();
+}
@@ -1,9 +1,12 @@
 // Copyright 2024, Andrew Drogalis
 // GNU License
 
+#include <filesystem>
+#include <future>
 #include <iostream>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 #include "httpmockserver/mock_server.h"
 #include "httpmockserver/test_environment.h"
@@ -11,6 +14,7 @@
 
 #include "gain_capital_client.h"
 #include "gain_capital_exception.h"
+#include "gain_capital_transport.h"
 
 namespace
 {
@@ -491,6 +495,86 @@ TEST(GainCapital_Functional_Server, Get_OHLC_FAILURE_Test3)
     }
 }
 
+TEST(GainCapital_Functional_Server, Get_Prices_Async_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    nlohmann::json response = nlohmann::json::parse("{\"PriceTicks\":[{\"Price\" : 1.0}]}");
+
+    std::promise<std::expected<nlohmann::json, GC::GCException>> promise;
+    auto future = promise.get_future();
+
+    gc.get_prices_async([&promise](std::expected<nlohmann::json, GC::GCException> result) { promise.set_value(std::move(result)); }, "TEST_MARKET");
+
+    auto network_response = future.get();
+
+    if (network_response)
+    {
+        EXPECT_EQ(network_response.value(), response);
+    }
+    else
+    {
+        FAIL();
+    }
+}
+
+TEST(GainCapital_Functional_Server, Get_OHLC_Async_Concurrent_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    nlohmann::json response = nlohmann::json::parse("{\"PriceBars\": \"123\"}");
+
+    int const REQUESTS = 50;
+    std::vector<std::promise<std::expected<nlohmann::json, GC::GCException>>> promises(REQUESTS);
+
+    for (auto& promise : promises)
+    {
+        gc.get_ohlc_async([&promise](std::expected<nlohmann::json, GC::GCException> result) { promise.set_value(std::move(result)); },
+                          "TEST_MARKET", "MINUTE");
+    }
+
+    for (auto& promise : promises)
+    {
+        auto network_response = promise.get_future().get();
+
+        if (network_response)
+        {
+            EXPECT_EQ(network_response.value(), response);
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+}
+
+TEST(GainCapital_Functional_Server, Get_OHLC_Async_FAILURE_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    std::expected<nlohmann::json, GC::GCException> network_response {};
+
+    gc.get_ohlc_async([&network_response](std::expected<nlohmann::json, GC::GCException> result) { network_response = std::move(result); },
+                      "TEST_MARKET", "SECOND");
+
+    if (! network_response)
+    {
+        EXPECT_EQ(typeid(network_response.error()), typeid(GC::GCException));
+        EXPECT_EQ(std::string(network_response.error().what()),
+                  "Interval Error - Provide one of the following intervals: 'HOUR', 'MINUTE', 'DAY', 'WEEK', 'MONTH'");
+    }
+    else
+    {
+        FAIL();
+    }
+}
+
 TEST(GainCapital_Functional_Server, Trade_Order_Market_Basic_Test)
 {
     GC::GCClient gc("USER", "PASSWORD", "APIKEY");
@@ -539,6 +623,46 @@ TEST(GainCapital_Functional_Server, Trade_Order_Limit_Basic_Test)
     }
 }
 
+TEST(GainCapital_Functional_Server, Trade_Order_Typed_Market_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    nlohmann::json response = nlohmann::json::parse("{\"OrderId\": 1}");
+
+    auto network_response = gc.trade_order(GC::MarketOrder {"TEST_MARKET", "buy", 1000});
+
+    if (network_response)
+    {
+        EXPECT_EQ(network_response.value(), response);
+    }
+    else
+    {
+        FAIL();
+    }
+}
+
+TEST(GainCapital_Functional_Server, Trade_Order_Typed_Limit_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    nlohmann::json response = nlohmann::json::parse("{\"OrderId\": 1}");
+
+    auto network_response = gc.trade_order(GC::StopLimitOrder {"TEST_MARKET", "sell", 1000, 1.0, 1.2, std::nullopt});
+
+    if (network_response)
+    {
+        EXPECT_EQ(network_response.value(), response);
+    }
+    else
+    {
+        FAIL();
+    }
+}
+
 TEST(GainCapital_Functional_Server, Trade_Order_FAILURE_Test1)
 {
     GC::GCClient gc("USER", "PASSWORD", "APIKEY");
@@ -707,6 +831,59 @@ TEST(GainCapital_Functional_Server, Cancel_Order_Test)
     }
 }
 
+TEST(GainCapital_Functional_Server, Cancel_Order_FAILURE_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    auto network_response = gc.cancel_order("12AB");
+
+    if (! network_response)
+    {
+        EXPECT_EQ(typeid(network_response.error()), typeid(GC::GCException));
+        EXPECT_EQ(std::string(network_response.error().where()),
+                  "std::expected<nlohmann::json_abi_v3_11_3::basic_json<>, gaincapital::GCException> gaincapital::GCClient::cancel_order(const "
+                  "std::string&, std::string)");
+        EXPECT_EQ(std::string(network_response.error().what()), "ID Must Be an Integer - ID: 12AB");
+    }
+    else
+    {
+        FAIL();
+    }
+}
+
+TEST(GainCapital_Functional_Server, Record_Replay_Session_Test)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "gc_functional_session.gcrr";
+    nlohmann::json recorded_account, recorded_prices;
+    {
+        GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+        gc.set_testing_rest_urls(URL);
+        auto recorder = GC::GCRecordingTransport::open(path, gc.get_transport());
+        ASSERT_TRUE(recorder.has_value());
+        gc.set_transport(recorder.value());
+
+        ASSERT_TRUE(gc.authenticate_session().has_value());
+        recorded_account = gc.get_account_info().value();
+        recorded_prices  = gc.get_prices("USD/CAD").value();
+        EXPECT_TRUE(recorder.value()->flush().has_value());
+    }
+
+    // Replayed Without a Server | Nothing Listens on the Replay URL
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls("http://localhost:9299");
+    auto replay = GC::GCReplayTransport::open(path, 0.0);
+    ASSERT_TRUE(replay.has_value());
+    gc.set_transport(replay.value());
+
+    ASSERT_TRUE(gc.authenticate_session().has_value());
+    EXPECT_EQ(gc.get_account_info().value(), recorded_account);
+    EXPECT_EQ(gc.get_prices("USD/CAD").value(), recorded_prices);
+    EXPECT_EQ(replay.value()->misses(), 0);
+    std::filesystem::remove(path);
+}
+
 }// namespace
 
 int main(int argc, char* argv[])
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 #include "httpmockserver/mock_server.h"
 #include "httpmockserver/test_environment.h"
@@ -358,6 +359,29 @@ TEST(GainCapital_Failed_Server, Cancel_Order_Failed_Server_Test)
     }
 }
 
+TEST(GainCapital_Failed_Server, Cancel_Orders_Failed_Server_Test)
+{
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(URL);
+    auto _ = gc.authenticate_session();
+
+    std::vector<std::string> const order_ids {"123456", "654321"};
+    auto network_response = gc.cancel_orders(order_ids);
+
+    if (! network_response)
+    {
+        FAIL();
+    }
+    ASSERT_EQ(network_response.value().size(), 2U);
+    for (GC::GCCancelResult const& result : network_response.value())
+    {
+        ASSERT_FALSE(result.response.has_value());
+        EXPECT_EQ(std::string(result.response.error().where()),
+                  "std::expected<std::vector<gaincapital::GCCancelResult>, gaincapital::GCException> gaincapital::GCClient::cancel_orders("
+                  "std::span<const std::__cxx11::basic_string<char> >, std::string, std::size_t)");
+    }
+}
+
 }// namespace
 
 int main(int argc, char* argv[])
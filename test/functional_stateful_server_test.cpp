@@ -0,0 +1,654 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "httpmockserver/mock_server.h"
+#include "httpmockserver/test_environment.h"
+#include "gtest/gtest.h"
+
+#include "gain_capital_client.h"
+#include "gain_capital_exception.h"
+
+namespace
+{
+
+namespace GC = gaincapital;
+
+std::string const URL = "http://localhost:9203";
+
+std::atomic<int> margin_counter {0};
+std::atomic<int> positions_counter {0};
+std::atomic<int> active_orders_counter {0};
+std::atomic<int> cancel_counter {0};
+
+// Orders Accepted by the Mock Server | OrderId = 1000 + Index
+struct ServerOrder
+{
+    std::string reference;
+    bool active;
+    std::string trigger_price;
+};
+std::mutex server_mutex;
+std::vector<ServerOrder> server_orders;
+nlohmann::json server_positions = nlohmann::json::array();
+std::atomic<bool> drop_next_order_response {false};
+
+std::size_t server_order_count()
+{
+    std::lock_guard<std::mutex> const lock {server_mutex};
+    return server_orders.size();
+}
+
+bool close_server_order(long const order_id)
+{
+    std::lock_guard<std::mutex> const lock {server_mutex};
+    if (order_id < 1001 || static_cast<std::size_t>(order_id - 1001) >= server_orders.size())
+    {
+        return false;
+    }
+    server_orders[static_cast<std::size_t>(order_id - 1001)].active = false;
+    return true;
+}
+
+void set_server_positions(std::string const& positions)
+{
+    std::lock_guard<std::mutex> const lock {server_mutex};
+    server_positions = nlohmann::json::parse(positions);
+}
+
+class HTTPMock : public httpmock::MockServer
+{
+  public:
+    /// Create HTTP server on port 9203
+    explicit HTTPMock(int port = 9203) : MockServer(port) {}
+
+  private:
+    /// Handler called by MockServer on HTTP request.
+    Response responseHandler(std::string const& url, std::string const& method, std::string const& data, std::vector<UrlArg> const& urlArguments,
+                             std::vector<Header> const& headers) override
+    {
+        std::lock_guard<std::mutex> const lock {server_mutex};
+        // Authenticate Session
+        if (method == "POST" && url == "/Session")
+        {
+            return Response(200, "{\"statusCode\": 0, \"session\": \"123\"}");
+        }
+        // Validate Session
+        else if (method == "POST" && matchesPrefix(url, "/Session/validate"))
+        {
+            return Response(200, "{\"isAuthenticated\": true}");
+        }
+        // Account Info
+        else if (method == "GET" && matchesPrefix(url, "/userAccount/ClientAndTradingAccount"))
+        {
+            return Response(200, "{\"tradingAccounts\": [{\"tradingAccountId\":\"TradingTestID\", \"clientAccountId\":\"ClientTestID\"}]}");
+        }
+        // Margin Info | Counted for Caching
+        else if (method == "GET" && matchesPrefix(url, "/margin/clientAccountMargin"))
+        {
+            ++margin_counter;
+            return Response(200, "{\"Margin\": 100}");
+        }
+        // Market IDs | Every Market but One Shares an ID
+        else if (method == "GET" && matchesPrefix(url, "/cfd/markets") && ! urlArguments.empty() && urlArguments[0].value == "OTHER_MARKET")
+        {
+            return Response(200, "{\"Markets\": [{\"MarketId\": 456}]}");
+        }
+        else if (method == "GET" && matchesPrefix(url, "/cfd/markets"))
+        {
+            return Response(200, "{\"Markets\": [{\"MarketId\": 123}]}");
+        }
+        // Market Information
+        else if (method == "GET" && matchesPrefix(url, "/market/123/information"))
+        {
+            return Response(200, "{\"MarketInformation\":{\"MarketId\":123,\"PriceDecimalPlaces\":2,\"WebMinSize\":100,\"IncrementSize\":100}}");
+        }
+        else if (method == "GET" && matchesPrefix(url, "/market/456/information"))
+        {
+            return Response(200, "{\"MarketInformation\":{\"MarketId\":456,\"PriceDecimalPlaces\":5}}");
+        }
+        // Prices
+        else if (method == "GET" && matchesPrefix(url, "/market/123/tickhistory"))
+        {
+            return Response(200, "{\"PriceTicks\":[{\"TickDate\":\"\\/Date(1700000000000)\\/\",\"Price\":1.0},"
+                                 "{\"TickDate\":\"\\/Date(1700000001000)\\/\",\"Price\":1.5}]}");
+        }
+        // OHLC
+        else if (method == "GET" && matchesPrefix(url, "/market/123/barhistory"))
+        {
+            return Response(200, "{\"PriceBars\":[{\"BarDate\":\"\\/Date(1700000000000)\\/\","
+                                 "\"Open\":1.0,\"High\":2.0,\"Low\":0.5,\"Close\":1.5}],"
+                                 "\"PartialPriceBar\":{\"BarDate\":\"\\/Date(1700000060000)\\/\","
+                                 "\"Open\":1.5,\"High\":1.5,\"Low\":1.5,\"Close\":1.5}}");
+        }
+        // List Open Positons | Never Cacheable
+        else if (method == "GET" && matchesPrefix(url, "/order/openpositions"))
+        {
+            ++positions_counter;
+            std::string const body = nlohmann::json {{"OpenPositions", server_positions}}.dump();
+            return Response(200, body).addHeader(Header("Cache-Control", "no-store"));
+        }
+        // Trade Market Order | Optionally Lose the Response
+        else if (method == "POST" && matchesPrefix(url, "/order/newtradeorder"))
+        {
+            if (drop_next_order_response.exchange(false))
+            {
+                return Response(500, "Gateway Timeout");
+            }
+            return Response(200, "{\"OrderId\": 1}");
+        }
+        // Trade Limit Order | Optionally Accept but Lose the Response
+        else if (method == "POST" && matchesPrefix(url, "/order/newstoplimitorder"))
+        {
+            nlohmann::json const order = nlohmann::json::parse(data);
+            server_orders.emplace_back(order.value("Reference", ""), true, order.value("TriggerPrice", ""));
+            if (drop_next_order_response.exchange(false))
+            {
+                return Response(500, "Gateway Timeout");
+            }
+            return Response(200, "{\"OrderId\": " + std::to_string(1000 + server_orders.size()) + "}");
+        }
+        // List Active Orders | Truncated to MaxResults
+        else if (method == "POST" && matchesPrefix(url, "/order/activeorders"))
+        {
+            ++active_orders_counter;
+            std::size_t const max_results = std::stoul(nlohmann::json::parse(data)["MaxResults"].get<std::string>());
+            nlohmann::json active_orders  = nlohmann::json::array();
+            for (std::size_t i = 0; i < server_orders.size() && active_orders.size() < max_results; ++i)
+            {
+                if (server_orders[i].active)
+                {
+                    active_orders.push_back(
+                        {{"TradeOrder", nullptr},
+                         {"StopLimitOrder",
+                          {{"OrderId", 1001 + i},
+                           {"MarketId", 123},
+                           {"Reference", server_orders[i].reference},
+                           {"TriggerPrice", server_orders[i].trigger_price}}}});
+                }
+            }
+            return Response(200, nlohmann::json {{"ActiveOrders", active_orders}}.dump());
+        }
+        // Amend Limit Order | Working Orders Only, Otherwise Answered but Not Accepted
+        else if (method == "POST" && matchesPrefix(url, "/order/updatestoplimitorder"))
+        {
+            nlohmann::json const order = nlohmann::json::parse(data);
+            std::size_t const index    = std::stoul(order["OrderId"].get<std::string>()) - 1001;
+            if (index >= server_orders.size() || ! server_orders[index].active)
+            {
+                return Response(200, "{\"OrderId\": " + order["OrderId"].get<std::string>() + ", \"StatusReason\": 2, \"Status\": 2}");
+            }
+            server_orders[index].trigger_price = order["TriggerPrice"].get<std::string>();
+            return Response(200, "{\"OrderId\": " + order["OrderId"].get<std::string>() + ", \"StatusReason\": 1, \"Status\": 1}");
+        }
+        // Cancel Order
+        else if (method == "POST" && matchesPrefix(url, "/order/cancel"))
+        {
+            ++cancel_counter;
+            std::size_t const index = std::stoul(nlohmann::json::parse(data)["OrderId"].get<std::string>()) - 1001;
+            if (index >= server_orders.size())
+            {
+                return Response(400, "Order Not Found");
+            }
+            server_orders[index].active = false;
+            return Response(200, "{}");
+        }
+        // Return "URI not found" for the undefined methods
+        return Response(404, "Not Found");
+    }
+
+    /// Return true if \p url starts with \p str.
+    bool matchesPrefix(std::string const& url, std::string const& str) const { return url.substr(0, str.size()) == str; }
+};
+
+class GainCapital_Stateful_Server : public ::testing::Test
+{
+    /*
+     * The mock server keeps the orders and positions a test creates, so each test starts from an empty server
+     * and a freshly authenticated client.
+     */
+  protected:
+    GC::GCClient gc {"USER", "PASSWORD", "APIKEY"};
+
+    void SetUp() override
+    {
+        {
+            std::lock_guard<std::mutex> const lock {server_mutex};
+            server_orders.clear();
+            server_positions = nlohmann::json::array();
+        }
+        drop_next_order_response = false;
+        margin_counter           = 0;
+        positions_counter        = 0;
+        active_orders_counter    = 0;
+        cancel_counter           = 0;
+        gc.set_testing_rest_urls(URL);
+        ASSERT_TRUE(gc.authenticate_session().has_value());
+    }
+};
+
+TEST_F(GainCapital_Stateful_Server, Response_Cache_Hit_Rate_Test)
+{
+    gc.set_cache_ttl("/margin/clientAccountMargin", std::chrono::seconds {10});
+
+    for (int i = 0; i < 10; ++i)
+    {
+        auto margin_response = gc.get_margin_info();
+        if (! margin_response)
+        {
+            FAIL();
+        }
+        EXPECT_EQ(margin_response.value()["Margin"], 100);
+    }
+
+    auto const metrics = gc.get_metrics();
+    EXPECT_EQ(margin_counter.load(), 1);
+    EXPECT_EQ(metrics.cache_hits, 9U);
+    EXPECT_EQ(metrics.cache_misses, 1U);
+    EXPECT_DOUBLE_EQ(metrics.cache_hit_rate(), 0.9);
+
+    gc.clear_response_cache();
+    EXPECT_TRUE(gc.get_margin_info().has_value());
+    EXPECT_EQ(margin_counter.load(), 2);
+}
+
+TEST_F(GainCapital_Stateful_Server, Response_Cache_No_Store_Test)
+{
+    gc.set_cache_ttl("/order/openpositions", std::chrono::seconds {10});
+
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_TRUE(gc.list_open_positions().has_value());
+    }
+
+    EXPECT_EQ(positions_counter.load(), 5);
+    EXPECT_EQ(gc.get_metrics().cache_hits, 0U);
+}
+
+TEST_F(GainCapital_Stateful_Server, Typed_Tick_History_Test)
+{
+    auto tick_response = gc.get_tick_history("MARKET_0", 2);
+
+    if (! tick_response)
+    {
+        FAIL();
+    }
+    ASSERT_EQ(tick_response.value().size(), 2U);
+    EXPECT_EQ(tick_response.value()[0].timestamp_ms, 1700000000000);
+    EXPECT_EQ(tick_response.value()[1].price, GC::GCPrice {1.5});
+}
+
+TEST_F(GainCapital_Stateful_Server, Typed_Bar_History_Test)
+{
+    auto bar_response = gc.get_bar_history("MARKET_0", "MINUTE");
+
+    if (! bar_response)
+    {
+        FAIL();
+    }
+    ASSERT_EQ(bar_response.value().size(), 2U);
+    EXPECT_EQ(bar_response.value()[0].high, GC::GCPrice {2.0});
+    EXPECT_EQ(bar_response.value()[0].low, GC::GCPrice {0.5});
+    EXPECT_EQ(bar_response.value()[1].timestamp_ms, 1700000060000);
+}
+
+TEST_F(GainCapital_Stateful_Server, Typed_History_FAILURE_Test)
+{
+    auto tick_response = gc.get_tick_history("OTHER_MARKET");
+
+    if (! tick_response)
+    {
+        EXPECT_EQ(std::string(tick_response.error().where()),
+                  "std::expected<std::vector<gaincapital::GCPriceTick>, gaincapital::GCException> gaincapital::GCClient::get_tick_history(const "
+                  "std::string&, std::size_t, std::size_t, std::size_t, std::string)");
+    }
+    else
+    {
+        FAIL();
+    }
+}
+
+TEST_F(GainCapital_Stateful_Server, Lost_Order_Response_Not_Duplicated_Test)
+{
+    drop_next_order_response = true;
+    auto order_response = gc.trade_order(GC::StopLimitOrder {"MARKET_0", "buy", 1000, 1.0, 0.9, std::nullopt});
+
+    if (! order_response)
+    {
+        FAIL();
+    }
+    EXPECT_EQ(server_order_count(), 1U);
+
+    auto const record = gc.get_order_manager().find_by_order_id(order_response.value()["OrderId"].get<std::int64_t>());
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(record->state, GC::GCOrderState::Acked);
+    EXPECT_EQ(record->attempts, 1U);
+    EXPECT_EQ(record->signed_quantity, 1000.0);
+}
+
+TEST_F(GainCapital_Stateful_Server, Unsettled_Orders_Leave_Pending_Test)
+{
+    // Nothing Is Sent Without a Quote
+    EXPECT_FALSE(gc.trade_order(GC::MarketOrder {"OTHER_MARKET", "buy", 1000}).has_value());
+    EXPECT_EQ(gc.get_order_manager().snapshot().back().state, GC::GCOrderState::Rejected);
+
+    // A Market Order Sent Without a Reply Is Unknown Until the Open Positions Account for It
+    drop_next_order_response = true;
+    EXPECT_FALSE(gc.trade_order(GC::MarketOrder {"MARKET_0", "buy", 1000}).has_value());
+    EXPECT_EQ(gc.get_order_manager().snapshot().back().state, GC::GCOrderState::Unknown);
+    EXPECT_EQ(gc.get_position_book().exposure(123), 0.0);
+
+    set_server_positions("[{\"MarketId\":123,\"Direction\":\"buy\",\"Quantity\":1000,\"Price\":1.0}]");
+    EXPECT_EQ(gc.reconcile_positions().value(), 1U);
+    EXPECT_EQ(gc.get_order_manager().snapshot().back().state, GC::GCOrderState::Filled);
+}
+
+TEST_F(GainCapital_Stateful_Server, Order_Lifecycle_Reconcile_Test)
+{
+    auto filled_response    = gc.trade_order(GC::StopLimitOrder {"MARKET_0", "buy", 1000, 1.0, std::nullopt, std::nullopt});
+    auto cancelled_response = gc.trade_order(GC::StopLimitOrder {"MARKET_0", "sell", 1000, 2.0, std::nullopt, std::nullopt});
+
+    if (! filled_response || ! cancelled_response)
+    {
+        FAIL();
+    }
+    std::int64_t const filled_id    = filled_response.value()["OrderId"].get<std::int64_t>();
+    std::int64_t const cancelled_id = cancelled_response.value()["OrderId"].get<std::int64_t>();
+
+    EXPECT_TRUE(gc.reconcile_orders().has_value());
+    EXPECT_EQ(gc.get_order_manager().find_by_order_id(filled_id)->state, GC::GCOrderState::Working);
+    EXPECT_EQ(gc.get_order_manager().find_by_order_id(cancelled_id)->state, GC::GCOrderState::Working);
+
+    close_server_order(filled_id);
+    EXPECT_TRUE(gc.cancel_order(std::to_string(cancelled_id)).has_value());
+
+    EXPECT_TRUE(gc.reconcile_orders().has_value());
+    EXPECT_EQ(gc.get_order_manager().find_by_order_id(filled_id)->state, GC::GCOrderState::Closed);
+    EXPECT_EQ(gc.get_order_manager().find_by_order_id(cancelled_id)->state, GC::GCOrderState::Cancelled);
+    EXPECT_EQ(gc.get_position_book().exposure(123), 0.0);
+
+    set_server_positions("[{\"MarketId\":123,\"Direction\":\"buy\",\"Quantity\":1000,\"Price\":1.0}]");
+    EXPECT_EQ(gc.reconcile_positions().value(), 1U);
+    EXPECT_EQ(gc.get_order_manager().find_by_order_id(filled_id)->state, GC::GCOrderState::Filled);
+    EXPECT_EQ(gc.get_position_book().exposure(123), 1000.0);
+}
+
+TEST_F(GainCapital_Stateful_Server, Position_Book_Fill_And_Reconcile_Test)
+{
+    set_server_positions("[{\"MarketId\":123,\"Direction\":\"buy\",\"Quantity\":1000,\"Price\":1.0}]");
+    auto reconcile_response = gc.reconcile_positions();
+
+    if (! reconcile_response)
+    {
+        FAIL();
+    }
+    EXPECT_EQ(reconcile_response.value(), 1U);
+    EXPECT_EQ(gc.get_position_book().exposure(123), 1000.0);
+
+    EXPECT_TRUE(gc.trade_order(GC::MarketOrder {"MARKET_0", "buy", 500}).has_value());
+    EXPECT_EQ(gc.get_position_book().exposure(123), 1500.0);
+
+    set_server_positions("[{\"MarketId\":123,\"Direction\":\"buy\",\"Quantity\":1200,\"Price\":1.0}]");
+    EXPECT_TRUE(gc.start_position_reconcile(std::chrono::milliseconds {20}).has_value());
+    std::this_thread::sleep_for(std::chrono::milliseconds {200});
+    gc.stop_position_reconcile();
+
+    EXPECT_EQ(gc.get_position_book().exposure(123), 1200.0);
+    EXPECT_EQ(gc.reconcile_positions().value(), 0U);
+}
+
+TEST_F(GainCapital_Stateful_Server, Active_Orders_Paging_And_Delta_Test)
+{
+    gc.set_active_orders_page_size(50);
+
+    {
+        std::lock_guard<std::mutex> const lock {server_mutex};
+        for (int i = 0; i < 120; ++i)
+        {
+            server_orders.emplace_back("PAGING-" + std::to_string(i), true);
+        }
+    }
+    EXPECT_EQ(gc.list_active_orders().value()["ActiveOrders"].size(), 120U);
+
+    auto delta_response = gc.list_active_orders_delta();
+
+    if (! delta_response)
+    {
+        FAIL();
+    }
+    EXPECT_EQ(delta_response.value().added.size(), 120U);
+    EXPECT_TRUE(delta_response.value().changed.empty());
+    EXPECT_TRUE(delta_response.value().removed.empty());
+
+    // Sized From the Previous Listing | One Request
+    int const requests_before = active_orders_counter.load();
+    EXPECT_TRUE(gc.list_active_orders_delta().value().empty());
+    EXPECT_EQ(active_orders_counter.load() - requests_before, 1);
+
+    {
+        std::lock_guard<std::mutex> const lock {server_mutex};
+        server_orders[0].active    = false;
+        server_orders[1].reference = "PAGING-CHANGED";
+        server_orders.emplace_back("PAGING-NEW", true);
+    }
+    delta_response = gc.list_active_orders_delta();
+
+    if (! delta_response)
+    {
+        FAIL();
+    }
+    ASSERT_EQ(delta_response.value().added.size(), 1U);
+    ASSERT_EQ(delta_response.value().changed.size(), 1U);
+    ASSERT_EQ(delta_response.value().removed.size(), 1U);
+    EXPECT_EQ(delta_response.value().added[0]["StopLimitOrder"]["Reference"], "PAGING-NEW");
+    EXPECT_EQ(delta_response.value().changed[0]["StopLimitOrder"]["Reference"], "PAGING-CHANGED");
+    EXPECT_EQ(delta_response.value().removed[0], 1001);
+}
+
+TEST_F(GainCapital_Stateful_Server, Bulk_Cancel_Test)
+{
+    std::vector<std::string> order_ids;
+    {
+        std::lock_guard<std::mutex> const lock {server_mutex};
+        for (int i = 0; i < 20; ++i)
+        {
+            server_orders.emplace_back("BULK-" + std::to_string(i), true);
+            order_ids.push_back(std::to_string(1000 + server_orders.size()));
+        }
+    }
+    order_ids.emplace_back("999999");
+    order_ids.emplace_back("ORDER");
+
+    auto cancel_response = gc.cancel_orders(order_ids, "", 4);
+
+    if (! cancel_response)
+    {
+        FAIL();
+    }
+    ASSERT_EQ(cancel_response.value().size(), order_ids.size());
+    EXPECT_EQ(cancel_counter.load(), 21);
+    for (std::size_t i = 0; i + 2 < order_ids.size(); ++i)
+    {
+        EXPECT_EQ(cancel_response.value()[i].order_id, order_ids[i]);
+        EXPECT_TRUE(cancel_response.value()[i].response.has_value());
+    }
+    EXPECT_FALSE(cancel_response.value()[20].response.has_value());
+    ASSERT_FALSE(cancel_response.value()[21].response.has_value());
+    EXPECT_EQ(std::string(cancel_response.value()[21].response.error().what()), "ID Must Be an Integer - ID: ORDER");
+
+    std::lock_guard<std::mutex> const lock {server_mutex};
+    for (ServerOrder const& order : server_orders)
+    {
+        EXPECT_FALSE(order.active);
+    }
+}
+
+TEST_F(GainCapital_Stateful_Server, Cancel_All_Test)
+{
+    {
+        std::lock_guard<std::mutex> const lock {server_mutex};
+        for (int i = 0; i < 10; ++i)
+        {
+            server_orders.emplace_back("CANCEL-ALL-" + std::to_string(i), true);
+        }
+    }
+
+    auto other_market_response = gc.cancel_all("OTHER_MARKET");
+
+    if (! other_market_response)
+    {
+        FAIL();
+    }
+    EXPECT_TRUE(other_market_response.value().empty());
+
+    auto cancel_response = gc.cancel_all("MARKET_0");
+
+    if (! cancel_response)
+    {
+        FAIL();
+    }
+    EXPECT_EQ(cancel_response.value().size(), 10U);
+    for (GC::GCCancelResult const& result : cancel_response.value())
+    {
+        EXPECT_TRUE(result.response.has_value());
+    }
+    EXPECT_TRUE(gc.list_active_orders().value()["ActiveOrders"].empty());
+}
+
+TEST_F(GainCapital_Stateful_Server, Amend_Order_Test)
+{
+    auto order_response = gc.trade_order(GC::StopLimitOrder {"MARKET_0", "buy", 1000, 1.0, 0.9, std::nullopt});
+
+    if (! order_response)
+    {
+        FAIL();
+    }
+    std::int64_t const order_id = order_response.value()["OrderId"].get<std::int64_t>();
+
+    auto amend_response = gc.amend_order(std::to_string(order_id), GC::StopLimitOrder {"MARKET_0", "buy", 2000, 1.1, 1.0, std::nullopt});
+
+    if (! amend_response)
+    {
+        FAIL();
+    }
+    EXPECT_EQ(amend_response.value()["OrderId"], order_id);
+    {
+        std::lock_guard<std::mutex> const lock {server_mutex};
+        EXPECT_EQ(server_orders[0].trigger_price, "1.1");
+    }
+    auto const record = gc.get_order_manager().find_by_order_id(order_id);
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(record->signed_quantity, 2000.0);
+    EXPECT_EQ(record->price, 1.1);
+
+    gc.set_risk_limits({.max_notional = 5000});
+    auto risk_response = gc.amend_order(std::to_string(order_id), GC::StopLimitOrder {"MARKET_0", "buy", 10000, 1.2, 1.0, std::nullopt});
+
+    if (risk_response)
+    {
+        FAIL();
+    }
+    EXPECT_EQ(std::string(risk_response.error().what()), "Risk Check Failed - Max Notional Exceeded");
+    {
+        std::lock_guard<std::mutex> const lock {server_mutex};
+        EXPECT_EQ(server_orders[0].trigger_price, "1.1");
+    }
+    EXPECT_EQ(gc.get_order_manager().find_by_order_id(order_id)->signed_quantity, 2000.0);
+    gc.set_risk_limits({});
+
+    auto invalid_response = gc.amend_order("ORDER", GC::StopLimitOrder {"MARKET_0", "buy", 2000, 1.2, 1.0, std::nullopt});
+
+    if (invalid_response)
+    {
+        FAIL();
+    }
+    EXPECT_EQ(std::string(invalid_response.error().what()), "ID Must Be an Integer - ID: ORDER");
+
+    close_server_order(order_id);
+    auto closed_response = gc.amend_order(std::to_string(order_id), GC::StopLimitOrder {"MARKET_0", "buy", 3000, 1.2, 1.0, std::nullopt});
+
+    if (closed_response)
+    {
+        FAIL();
+    }
+    EXPECT_TRUE(std::string(closed_response.error().what()).starts_with("Amend Not Accepted"));
+    EXPECT_EQ(gc.get_order_manager().find_by_order_id(order_id)->signed_quantity, 2000.0);
+    EXPECT_EQ(gc.get_order_manager().find_by_order_id(order_id)->price, 1.1);
+}
+
+TEST_F(GainCapital_Stateful_Server, Risk_Check_Rejects_Before_Sending_Test)
+{
+    gc.set_risk_limits({.max_notional = 5000});
+    EXPECT_TRUE(gc.set_market_risk_limits("MARKET_0", {.max_notional = 5000, .price_band = 0.1}).has_value());
+
+    auto order_response = gc.trade_order(GC::StopLimitOrder {"MARKET_0", "buy", 1000, 1.5, std::nullopt, std::nullopt});
+
+    if (order_response)
+    {
+        FAIL();
+    }
+    EXPECT_EQ(std::string(order_response.error().what()), "Risk Check Failed - Price Outside Band");
+    EXPECT_EQ(server_order_count(), 0U);
+    EXPECT_EQ(gc.get_order_manager().snapshot().back().state, GC::GCOrderState::Rejected);
+
+    EXPECT_TRUE(gc.trade_order(GC::StopLimitOrder {"MARKET_0", "buy", 1000, 1.05, std::nullopt, std::nullopt}).has_value());
+    EXPECT_EQ(server_order_count(), 1U);
+
+    order_response = gc.trade_order(GC::MarketOrder {"MARKET_0", "sell", 10000});
+    EXPECT_FALSE(order_response.has_value());
+}
+
+TEST_F(GainCapital_Stateful_Server, Market_Spec_Cache_Test)
+{
+    auto load_response = gc.load_market_specs({"MARKET_0", "OTHER_MARKET"});
+
+    if (! load_response)
+    {
+        FAIL();
+    }
+    EXPECT_EQ(load_response.value(), 2U);
+    EXPECT_EQ(gc.get_market_spec("MARKET_0")->price_decimals, 2);
+    EXPECT_EQ(gc.get_market_spec("OTHER_MARKET")->market_id, 456);
+    EXPECT_FALSE(gc.get_market_spec("MARKET_1").has_value());
+
+    auto order_response = gc.trade_order(GC::MarketOrder {"MARKET_0", "buy", 150});
+
+    if (order_response)
+    {
+        FAIL();
+    }
+    EXPECT_EQ(std::string(order_response.error().what()), "Quantity Not a Multiple of the Market Increment");
+
+    nlohmann::json trade_map = {{"MARKET_0", {{"Direction", "buy"}, {"Quantity", "150"}, {"TriggerPrice", "1.0512"}}}};
+    order_response           = gc.trade_order(trade_map, "LIMIT");
+
+    if (order_response)
+    {
+        FAIL();
+    }
+    EXPECT_EQ(std::string(order_response.error().what()), "Quantity Not a Multiple of the Market Increment");
+
+    order_response = gc.trade_order(GC::StopLimitOrder {"MARKET_0", "buy", 1000, 1.0512, std::nullopt, std::nullopt});
+
+    if (! order_response)
+    {
+        FAIL();
+    }
+    std::lock_guard<std::mutex> const lock {server_mutex};
+    EXPECT_EQ(server_orders[0].trigger_price, "1.05");
+}
+
+}// namespace
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::AddGlobalTestEnvironment(new httpmock::TestEnvironment<HTTPMock>());
+    return RUN_ALL_TESTS();
+}
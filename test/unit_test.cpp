@@ -1,12 +1,48 @@
 // Copyright 2024, Andrew Drogalis
 // GNU License
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
 #include <typeinfo>
+#include <vector>
 
 #include "gtest/gtest.h"
 
+#include "gain_capital_active_orders.h"
+#include "gain_capital_arena.h"
+#include "gain_capital_bar_builder.h"
+#include "gain_capital_breaker.h"
+#include "gain_capital_cache.h"
 #include "gain_capital_client.h"
+#include "gain_capital_deadline.h"
 #include "gain_capital_exception.h"
+#include "gain_capital_hedge.h"
+#include "gain_capital_market_data.h"
+#include "gain_capital_market_spec.h"
+#include "gain_capital_metrics.h"
+#include "gain_capital_mock_server.h"
+#include "gain_capital_order.h"
+#include "gain_capital_order_manager.h"
+#include "gain_capital_position_book.h"
+#include "gain_capital_price.h"
+#include "gain_capital_reactor.h"
+#include "gain_capital_risk.h"
+#include "gain_capital_single_flight.h"
+#include "gain_capital_tick_store.h"
+#include "gain_capital_transport.h"
 
 namespace
 {
@@ -312,4 +348,1548 @@ TEST(GainCapitalUnit, Cancel_Order_API_Call_FailEarly)
     }
 }
 
+// =================================================================================
+// Session Refresh
+// =================================================================================
+
+class ExpiringSessionTransport final : public GC::GCTransport
+{
+    /* Every session fails validation; each response is delivered on its own thread after 20ms */
+  public:
+    ~ExpiringSessionTransport() override
+    {
+        std::lock_guard<std::mutex> const lock {mutex};
+        responders.clear();
+    }
+
+    std::uint64_t submit(GC::NetworkRequest request, GC::NetworkCallback callback) override
+    {
+        std::string body;
+        if (request.url.ends_with("/Session"))
+        {
+            body = "{\"statusCode\":0,\"session\":\"Session" + std::to_string(++logon_count) + "\"}";
+        }
+        else if (request.url.ends_with("/Session/validate"))
+        {
+            body = "{\"isAuthenticated\":false}";
+        }
+        else
+        {
+            body = "{\"tradingAccounts\":[{\"tradingAccountId\":1,\"clientAccountId\":2}]}";
+        }
+        std::lock_guard<std::mutex> const lock {mutex};
+        responders.emplace_back(
+            [body = std::move(body), callback = std::move(callback)]
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds {20});
+                callback(GC::NetworkResponse {200, body, "", {}});
+            });
+        return responders.size();
+    }
+
+    [[nodiscard]] std::size_t in_flight() const noexcept override { return 0; }
+
+    [[nodiscard]] int logons() const noexcept { return logon_count.load(); }
+
+  private:
+    std::atomic<int> logon_count {0};
+    std::mutex mutex;
+    std::vector<std::jthread> responders;
+};
+
+TEST(GainCapitalUnit, Session_Refreshed_Once_By_Racing_Validations)
+{
+    auto transport = std::make_shared<ExpiringSessionTransport>();
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_transport(transport);
+    ASSERT_TRUE(gc.authenticate_session().has_value());
+    std::string const first_session = gc.get_session()->header.at("Session");
+
+    // Both Validations Report the Same Expired Session; Only One Thread Logs On Again
+    auto first  = std::async(std::launch::async, [&gc] { return gc.validate_session(); });
+    auto second = std::async(std::launch::async, [&gc] { return gc.validate_session(); });
+    EXPECT_TRUE(first.get().has_value());
+    EXPECT_TRUE(second.get().has_value());
+    EXPECT_EQ(transport->logons(), 2);
+    EXPECT_NE(gc.get_session()->header.at("Session"), first_session);
+}
+
+// =================================================================================
+// Request Coalescing
+// =================================================================================
+
+TEST(GainCapitalUnit, Single_Flight_Leader_And_Waiters)
+{
+    GC::GCSingleFlight<std::function<void(int)>> single_flight;
+    std::vector<int> results;
+
+    EXPECT_TRUE(single_flight.join("KEY", [&results](int value) { results.push_back(value); }));
+    EXPECT_FALSE(single_flight.join("KEY", [&results](int value) { results.push_back(value + 1); }));
+    EXPECT_TRUE(single_flight.join("OTHER", [](int) {}));
+
+    auto waiters = single_flight.complete("KEY");
+    for (auto& waiter : waiters)
+    {
+        waiter(10);
+    }
+
+    EXPECT_EQ(results, (std::vector<int> {10, 11}));
+    EXPECT_EQ(single_flight.coalesced(), 1U);
+    EXPECT_TRUE(single_flight.complete("KEY").empty());
+    EXPECT_TRUE(single_flight.join("KEY", [](int) {}));
+}
+
+TEST(GainCapitalUnit, Single_Flight_Canonical_Key)
+{
+    using SingleFlight = GC::GCSingleFlight<std::function<void(int)>>;
+
+    EXPECT_EQ(SingleFlight::request_key("GET", "http://host/market/1/tickhistory?PriceTicks=1&priceType=BID", ""),
+              SingleFlight::request_key("GET", "http://host/market/1/tickhistory?priceType=BID&PriceTicks=1", ""));
+    EXPECT_NE(SingleFlight::request_key("GET", "http://host/market/1/tickhistory?PriceTicks=1&priceType=BID", ""),
+              SingleFlight::request_key("GET", "http://host/market/1/tickhistory?PriceTicks=1&priceType=ASK", ""));
+    EXPECT_NE(SingleFlight::request_key("POST", "http://host/order/activeorders", "{\"MaxResults\":1}"),
+              SingleFlight::request_key("POST", "http://host/order/activeorders", "{\"MaxResults\":2}"));
+}
+
+// =================================================================================
+// Response Cache
+// =================================================================================
+
+TEST(GainCapitalUnit, Response_Cache_Endpoint_TTL)
+{
+    GC::GCResponseCache cache;
+    cache.set_ttl("/margin/clientAccountMargin", std::chrono::milliseconds {50});
+
+    EXPECT_EQ(cache.ttl_for("http://host/margin/clientAccountMargin?x=1"), std::chrono::milliseconds {50});
+    EXPECT_EQ(cache.ttl_for("http://host/order/openpositions?margin/clientAccountMargin"), std::chrono::milliseconds::zero());
+
+    cache.store("KEY", nlohmann::json {{"Margin", 1}}, std::chrono::milliseconds {50}, cpr::Header {});
+    auto cached = cache.lookup("KEY");
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached.value()["Margin"], 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {80});
+    EXPECT_FALSE(cache.lookup("KEY").has_value());
+
+    cache.set_ttl("/margin/clientAccountMargin", std::chrono::milliseconds::zero());
+    EXPECT_EQ(cache.ttl_for("http://host/margin/clientAccountMargin"), std::chrono::milliseconds::zero());
+}
+
+TEST(GainCapitalUnit, Response_Cache_Honours_Cache_Control)
+{
+    GC::GCResponseCache cache;
+
+    EXPECT_FALSE(GC::GCResponseCache::server_max_age(cpr::Header {}).has_value());
+    EXPECT_EQ(GC::GCResponseCache::server_max_age(cpr::Header {{"Cache-Control", "private, max-age=5"}}), std::chrono::seconds {5});
+    EXPECT_EQ(GC::GCResponseCache::server_max_age(cpr::Header {{"cache-control", "No-Store"}}), std::chrono::milliseconds::zero());
+    EXPECT_FALSE(GC::GCResponseCache::server_max_age(cpr::Header {{"Cache-Control", "public, s-maxage=60"}}).has_value());
+    EXPECT_EQ(GC::GCResponseCache::server_max_age(cpr::Header {{"Cache-Control", "s-maxage=60 , max-age=5"}}), std::chrono::seconds {5});
+    EXPECT_EQ(GC::GCResponseCache::server_max_age(cpr::Header {{"Cache-Control", "max-age=5, no-cache"}}), std::chrono::milliseconds::zero());
+
+    cache.store("NO_STORE", nlohmann::json {}, std::chrono::seconds {10}, cpr::Header {{"Cache-Control", "no-store"}});
+    cache.store("NO_CACHE", nlohmann::json {}, std::chrono::seconds {10}, cpr::Header {{"Cache-Control", "no-cache"}});
+    cache.store("MAX_AGE_ZERO", nlohmann::json {}, std::chrono::seconds {10}, cpr::Header {{"Cache-Control", "max-age=0"}});
+    cache.store("MAX_AGE", nlohmann::json {}, std::chrono::seconds {10}, cpr::Header {{"Cache-Control", "max-age=60"}});
+
+    EXPECT_FALSE(cache.lookup("NO_STORE").has_value());
+    EXPECT_FALSE(cache.lookup("NO_CACHE").has_value());
+    EXPECT_FALSE(cache.lookup("MAX_AGE_ZERO").has_value());
+    EXPECT_TRUE(cache.lookup("MAX_AGE").has_value());
+    EXPECT_EQ(cache.size(), 1U);
+}
+
+TEST(GainCapitalUnit, Metrics_Cache_Hit_Rate)
+{
+    GC::GCMetrics metrics;
+    EXPECT_EQ(metrics.snapshot().cache_hit_rate(), 0.0);
+
+    metrics.record_cache_hit();
+    metrics.record_cache_hit();
+    metrics.record_cache_hit();
+    metrics.record_cache_miss();
+    metrics.record_request();
+
+    auto const snapshot = metrics.snapshot();
+    EXPECT_EQ(snapshot.cache_hits, 3U);
+    EXPECT_EQ(snapshot.requests_sent, 1U);
+    EXPECT_DOUBLE_EQ(snapshot.cache_hit_rate(), 0.75);
+}
+
+// =================================================================================
+// Arena Parsing
+// =================================================================================
+
+TEST(GainCapitalUnit, Arena_Reset_Retains_High_Water_Mark)
+{
+    GC::GCArena arena {64};
+
+    for (int i = 0; i < 32; ++i)
+    {
+        EXPECT_NE(arena.allocate(16, alignof(std::max_align_t)), nullptr);
+    }
+    EXPECT_EQ(arena.allocations(), 32U);
+
+    arena.reset();
+    EXPECT_EQ(arena.allocations(), 0U);
+    EXPECT_GE(arena.capacity(), 32U * 16U);
+}
+
+TEST(GainCapitalUnit, Arena_Scope_Resets_Thread_Arena)
+{
+    {
+        GC::GCArenaScope const outer;
+        {
+            GC::GCArenaScope const inner;
+            GC::GCArenaJson const json = GC::GCArenaJson::parse("{\"PriceTicks\": [1, 2, 3]}");
+            EXPECT_EQ(json["PriceTicks"].size(), 3U);
+        }
+        EXPECT_GT(GC::GCArena::thread_local_arena().allocations(), 0U);
+    }
+    EXPECT_EQ(GC::GCArena::thread_local_arena().allocations(), 0U);
+}
+
+TEST(GainCapitalUnit, Parse_Price_Ticks)
+{
+    auto ticks = GC::parse_price_ticks("{\"PriceTicks\":[{\"TickDate\":\"\\/Date(1414422604000)\\/\",\"Price\":1.27485},"
+                                       "{\"TickDate\":\"\\/Date(1414422605000+0100)\\/\",\"Price\":1.2749}]}");
+    ASSERT_TRUE(ticks.has_value());
+    ASSERT_EQ(ticks.value().size(), 2U);
+    EXPECT_EQ(ticks.value()[0].timestamp_ms, 1414422604000);
+    EXPECT_EQ(ticks.value()[0].price.units(), 1274850);
+    EXPECT_EQ(ticks.value()[1].timestamp_ms, 1414422605000);
+
+    auto market_ticks = GC::parse_price_ticks("{\"PriceTicks\":[{\"TickDate\":\"\\/Date(0)\\/\",\"Price\":1.27486}]}", 4);
+    ASSERT_TRUE(market_ticks.has_value());
+    EXPECT_EQ(market_ticks.value()[0].price.units(), 12749);
+    EXPECT_EQ(market_ticks.value()[0].price.decimals(), 4);
+
+    EXPECT_FALSE(GC::parse_price_ticks("{\"PriceTicks\":[{\"Price\":1.0}]}").has_value());
+    EXPECT_FALSE(GC::parse_price_ticks("{\"PriceTicks\":[{\"TickDate\":\"1414422604000\",\"Price\":1.0}]}").has_value());
+    EXPECT_FALSE(GC::parse_price_ticks("not json").has_value());
+}
+
+TEST(GainCapitalUnit, Parse_Price_Bars)
+{
+    auto bars = GC::parse_price_bars("{\"PriceBars\":[{\"BarDate\":\"\\/Date(60000)\\/\",\"Open\":1,\"High\":3,\"Low\":0.5,\"Close\":2}],"
+                                     "\"PartialPriceBar\":null}");
+    ASSERT_TRUE(bars.has_value());
+    ASSERT_EQ(bars.value().size(), 1U);
+    EXPECT_EQ(bars.value()[0].timestamp_ms, 60000);
+    EXPECT_EQ(bars.value()[0].open, GC::GCPrice {1.0});
+    EXPECT_EQ(bars.value()[0].high, GC::GCPrice {3.0});
+    EXPECT_EQ(bars.value()[0].low, GC::GCPrice {0.5});
+    EXPECT_EQ(bars.value()[0].close, GC::GCPrice {2.0});
+
+    EXPECT_FALSE(GC::parse_price_bars("{\"PriceBars\": \"123\"}").has_value());
+}
+
+// =================================================================================
+// Fixed Point Prices
+// =================================================================================
+
+TEST(GainCapitalUnit, Price_Parse)
+{
+    EXPECT_EQ(GC::GCPrice::parse("1.27485", 5)->units(), 127485);
+    EXPECT_EQ(GC::GCPrice::parse("1.2", 5)->units(), 120000);
+    EXPECT_EQ(GC::GCPrice::parse("-0.5", 2)->units(), -50);
+    EXPECT_EQ(GC::GCPrice::parse("+12", 0)->units(), 12);
+    EXPECT_EQ(GC::GCPrice::parse(".25", 2)->units(), 25);
+    EXPECT_EQ(GC::GCPrice::parse("1.23456", 3)->units(), 1235);
+    EXPECT_EQ(GC::GCPrice::parse("-1.23449", 3)->units(), -1234);
+    EXPECT_EQ(GC::GCPrice::parse("1.5e-3", 5)->units(), 150);
+
+    EXPECT_FALSE(GC::GCPrice::parse("", 5).has_value());
+    EXPECT_FALSE(GC::GCPrice::parse("-", 5).has_value());
+    EXPECT_FALSE(GC::GCPrice::parse("1.2.3", 5).has_value());
+    EXPECT_FALSE(GC::GCPrice::parse("1.2x", 5).has_value());
+    EXPECT_FALSE(GC::GCPrice::parse("99999999999999999999", 0).has_value());
+}
+
+TEST(GainCapitalUnit, Price_Format)
+{
+    EXPECT_EQ(GC::GCPrice::from_units(127485, 5).to_string(), "1.27485");
+    EXPECT_EQ(GC::GCPrice::from_units(120000, 5).to_string(), "1.2");
+    EXPECT_EQ(GC::GCPrice::from_units(200, 2).to_string(), "2");
+    EXPECT_EQ(GC::GCPrice::from_units(-5, 3).to_string(), "-0.005");
+    EXPECT_EQ(GC::GCPrice::from_units(0, 4).to_string(), "0");
+    EXPECT_EQ(GC::GCPrice(1.0001, 4).to_string(), "1.0001");
+    EXPECT_DOUBLE_EQ(GC::GCPrice::from_units(127485, 5).to_double(), 1.27485);
+}
+
+TEST(GainCapitalUnit, Price_Arithmetic)
+{
+    GC::GCPrice const price = GC::GCPrice::from_units(127485, 5);
+    EXPECT_EQ(price.rescale(3).units(), 1275);
+    EXPECT_EQ(price.rescale(7).units(), 12748500);
+    EXPECT_EQ(GC::GCPrice::from_units(-127485, 5).rescale(3).units(), -1275);
+
+    EXPECT_EQ(price, GC::GCPrice::from_units(12748500, 7));
+    EXPECT_LT(price, GC::GCPrice::from_units(1275, 3));
+    EXPECT_EQ(price + GC::GCPrice::from_units(15, 5), GC::GCPrice::from_units(1275, 3));
+    EXPECT_EQ((price - GC::GCPrice::from_units(1, 2)).units(), 126485);
+    EXPECT_EQ((GC::GCPrice::from_units(25, 2) * 4).to_string(), "1");
+
+    GC::GCPrice tick {1.0, 5};
+    tick += GC::GCPrice::from_units(1, 5);
+    EXPECT_EQ(tick.to_string(), "1.00001");
+}
+
+// =================================================================================
+// Bar Builder
+// =================================================================================
+
+TEST(GainCapitalUnit, Bar_Builder_Minute_Bars)
+{
+    GC::GCBarBuilder builder;
+    std::vector<GC::GCPriceTick> const ticks {
+        {0, GC::GCPrice {1.0}}, {20000, GC::GCPrice {1.2}}, {50000, GC::GCPrice {0.9}}, {65000, GC::GCPrice {1.1}}, {130000, GC::GCPrice {1.3}}};
+    EXPECT_EQ(builder.add_ticks(ticks), 5U);
+    EXPECT_FALSE(builder.add_tick({100000, GC::GCPrice {1.0}}));
+    EXPECT_EQ(builder.last_tick_ms(), 130000);
+
+    auto one_minute = builder.bars("minute", 10);
+    ASSERT_TRUE(one_minute.has_value());
+    ASSERT_EQ(one_minute.value().size(), 3U);
+    EXPECT_EQ(one_minute.value()[0].timestamp_ms, 0);
+    EXPECT_EQ(one_minute.value()[0].high, GC::GCPrice {1.2});
+    EXPECT_EQ(one_minute.value()[0].low, GC::GCPrice {0.9});
+    EXPECT_EQ(one_minute.value()[0].close, GC::GCPrice {0.9});
+    EXPECT_EQ(one_minute.value()[1].timestamp_ms, 60000);
+    EXPECT_EQ(one_minute.value()[2].timestamp_ms, 120000);
+
+    auto two_minute = builder.bars("MINUTE", 10, 2);
+    ASSERT_TRUE(two_minute.has_value());
+    ASSERT_EQ(two_minute.value().size(), 2U);
+    EXPECT_EQ(two_minute.value()[0].open, GC::GCPrice {1.0});
+    EXPECT_EQ(two_minute.value()[0].close, GC::GCPrice {1.1});
+
+    auto latest = builder.bars("MINUTE", 2);
+    ASSERT_TRUE(latest.has_value());
+    ASSERT_EQ(latest.value().size(), 2U);
+    EXPECT_EQ(latest.value()[0].timestamp_ms, 60000);
+
+    auto const hour = builder.current("HOUR", 4);
+    ASSERT_TRUE(hour.has_value());
+    EXPECT_EQ(hour->timestamp_ms, 0);
+    EXPECT_EQ(hour->high, GC::GCPrice {1.3});
+    EXPECT_EQ(hour->low, GC::GCPrice {0.9});
+
+    EXPECT_FALSE(builder.current("MINUTE", 4).has_value());
+    EXPECT_FALSE(builder.bars("SECOND", 10).has_value());
+    EXPECT_FALSE(builder.bars("HOUR", 10, 3).has_value());
+}
+
+TEST(GainCapitalUnit, Bar_Builder_Calendar_Bars)
+{
+    GC::GCBarBuilder builder;
+    EXPECT_FALSE(builder.current("MONTH").has_value());
+
+    // Thursday 2024-02-29 12:00 UTC, then Monday 2024-03-04 00:00 UTC
+    EXPECT_TRUE(builder.add_tick({1709208000000, GC::GCPrice {1.5}}));
+    auto const week  = builder.current("WEEK");
+    auto const month = builder.current("MONTH");
+    ASSERT_TRUE(week.has_value() && month.has_value());
+    EXPECT_EQ(week->timestamp_ms, 1708905600000);
+    EXPECT_EQ(month->timestamp_ms, 1706745600000);
+    EXPECT_EQ(builder.current("DAY")->timestamp_ms, 1709164800000);
+
+    EXPECT_TRUE(builder.add_tick({1709510400000, GC::GCPrice {1.6}}));
+    EXPECT_EQ(builder.current("WEEK")->timestamp_ms, 1709510400000);
+    EXPECT_EQ(builder.current("MONTH")->timestamp_ms, 1709251200000);
+    EXPECT_EQ(builder.bars("MONTH", 10).value().size(), 2U);
+
+    builder.clear();
+    EXPECT_FALSE(builder.current("DAY").has_value());
+}
+
+TEST(GainCapitalUnit, Bar_Builder_History_Ring)
+{
+    GC::GCBarBuilder builder {2};
+    for (std::int64_t minute = 0; minute < 5; ++minute)
+    {
+        EXPECT_TRUE(builder.add_tick({minute * 60000, GC::GCPrice::from_units(minute, 0)}));
+    }
+    auto bars = builder.bars("MINUTE", 10);
+    ASSERT_TRUE(bars.has_value());
+    ASSERT_EQ(bars.value().size(), 3U);
+    EXPECT_EQ(bars.value()[0].timestamp_ms, 120000);
+    EXPECT_EQ(bars.value()[1].timestamp_ms, 180000);
+    EXPECT_EQ(bars.value()[2].close, GC::GCPrice::from_units(4, 0));
+}
+
+TEST(GainCapitalUnit, Bar_Resample)
+{
+    std::vector<GC::GCPriceBar> minute_bars;
+    for (std::int64_t minute = 0; minute < 130; ++minute)
+    {
+        GC::GCPrice const open = GC::GCPrice::from_units(1000 + minute, 3);
+        minute_bars.push_back({minute * 60000, open, open + GC::GCPrice::from_units(5, 3), open - GC::GCPrice::from_units(5, 3), open});
+    }
+    GC::GCBarColumns const columns = GC::GCBarColumns::from_bars(minute_bars, 3);
+    ASSERT_EQ(columns.size(), 130U);
+    EXPECT_EQ(columns.high[0], 1005);
+
+    auto fifteen = GC::resample_bars(columns, "MINUTE", 1, "MINUTE", 15);
+    ASSERT_TRUE(fifteen.has_value());
+    ASSERT_EQ(fifteen.value().size(), 9U);
+    EXPECT_EQ(fifteen.value().timestamp_ms[1], 900000);
+    EXPECT_EQ(fifteen.value().open[1], 1015);
+    EXPECT_EQ(fifteen.value().high[1], 1034);
+    EXPECT_EQ(fifteen.value().low[1], 1010);
+    EXPECT_EQ(fifteen.value().close[1], 1029);
+    EXPECT_EQ(fifteen.value().close[8], 1129);
+
+    auto hourly = GC::resample_bars(fifteen.value(), "MINUTE", 15, "HOUR", 1);
+    ASSERT_TRUE(hourly.has_value());
+    std::vector<GC::GCPriceBar> const hour_bars = hourly.value().to_bars();
+    ASSERT_EQ(hour_bars.size(), 3U);
+    EXPECT_EQ(hour_bars[1].timestamp_ms, 3600000);
+    EXPECT_EQ(hour_bars[1].open, GC::GCPrice {1.06});
+    EXPECT_EQ(hour_bars[1].high, GC::GCPrice {1.124});
+    EXPECT_EQ(hour_bars[2].close, GC::GCPrice {1.129});
+
+    auto monthly = GC::resample_bars(columns, "MINUTE", 1, "MONTH");
+    ASSERT_TRUE(monthly.has_value());
+    ASSERT_EQ(monthly.value().size(), 1U);
+    EXPECT_EQ(monthly.value().low[0], 995);
+
+    EXPECT_FALSE(GC::resample_bars(columns, "MINUTE", 3, "MINUTE", 5).has_value());
+    EXPECT_FALSE(GC::resample_bars(columns, "HOUR", 1, "MINUTE", 30).has_value());
+    EXPECT_FALSE(GC::resample_bars(columns, "WEEK", 1, "MONTH").has_value());
+    EXPECT_FALSE(GC::resample_bars(columns, "MINUTE", 1, "YEAR").has_value());
+    EXPECT_EQ(GC::resample_bars(GC::GCBarColumns {}, "DAY", 1, "WEEK").value().size(), 0U);
+}
+
+// =================================================================================
+// Tick Store
+// =================================================================================
+
+std::vector<GC::GCPriceTick> make_ticks(std::int64_t const first, std::int64_t const count)
+{
+    std::vector<GC::GCPriceTick> ticks;
+    for (std::int64_t i = first; i < first + count; ++i)
+    {
+        ticks.push_back({1700000000000 + i * 250, GC::GCPrice::from_units(127000 + (i * 37) % 101 - 50, 5)});
+    }
+    return ticks;
+}
+
+TEST(GainCapitalUnit, Tick_Store_Round_Trip)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "gc_tick_store_round_trip.gctk";
+    std::filesystem::remove(path);
+    std::vector<GC::GCPriceTick> const ticks = make_ticks(0, 10000);
+    {
+        auto writer = GC::GCTickWriter::open(path, 5, 1000);
+        ASSERT_TRUE(writer.has_value());
+        EXPECT_EQ(writer.value().append(ticks).value(), 10000U);
+        EXPECT_TRUE(writer.value().close().has_value());
+        EXPECT_FALSE(writer.value().append(ticks).has_value());
+    }
+    EXPECT_LT(std::filesystem::file_size(path), 10000U * 4);
+
+    auto reader = GC::GCTickReader::open(path);
+    ASSERT_TRUE(reader.has_value());
+    EXPECT_EQ(reader.value().tick_count(), 10000U);
+    EXPECT_EQ(reader.value().decimals(), 5);
+    ASSERT_EQ(reader.value().blocks().size(), 10U);
+
+    auto all = reader.value().read();
+    ASSERT_TRUE(all.has_value());
+    ASSERT_EQ(all.value().size(), ticks.size());
+    EXPECT_EQ(all.value()[9999].timestamp_ms, ticks[9999].timestamp_ms);
+    EXPECT_EQ(all.value()[1234].price, ticks[1234].price);
+    EXPECT_EQ(reader.value().blocks_decoded(), 10U);
+
+    auto range = reader.value().read(ticks[2500].timestamp_ms, ticks[2600].timestamp_ms);
+    ASSERT_TRUE(range.has_value());
+    ASSERT_EQ(range.value().size(), 101U);
+    EXPECT_EQ(range.value().front().price, ticks[2500].price);
+    EXPECT_EQ(reader.value().blocks_decoded(), 11U);
+
+    EXPECT_TRUE(reader.value().read(0, 1000).value().empty());
+    EXPECT_EQ(reader.value().blocks_decoded(), 11U);
+    std::filesystem::remove(path);
+}
+
+TEST(GainCapitalUnit, Tick_Store_Append)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "gc_tick_store_append.gctk";
+    std::filesystem::remove(path);
+    {
+        auto writer = GC::GCTickWriter::open(path, 5, 64);
+        ASSERT_TRUE(writer.has_value());
+        EXPECT_TRUE(writer.value().append(make_ticks(0, 100)).has_value());
+    }
+    EXPECT_FALSE(GC::GCTickWriter::open(path, 4).has_value());
+    {
+        auto writer = GC::GCTickWriter::open(path, 5);
+        ASSERT_TRUE(writer.has_value());
+        EXPECT_EQ(writer.value().tick_count(), 100U);
+        EXPECT_FALSE(writer.value().append(make_ticks(50, 1)).has_value());
+        EXPECT_TRUE(writer.value().append(make_ticks(100, 100)).has_value());
+
+        // Until Close the File Still Holds Only the Earlier Ticks, as It Would After a Crash
+        auto reader = GC::GCTickReader::open(path);
+        ASSERT_TRUE(reader.has_value());
+        EXPECT_EQ(reader.value().tick_count(), 100U);
+        EXPECT_EQ(reader.value().read().value().size(), 100U);
+    }
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+    auto reader = GC::GCTickReader::open(path);
+    ASSERT_TRUE(reader.has_value());
+    EXPECT_EQ(reader.value().tick_count(), 200U);
+    EXPECT_EQ(reader.value().blocks().size(), 4U);
+    auto all = reader.value().read();
+    ASSERT_TRUE(all.has_value());
+    ASSERT_EQ(all.value().size(), 200U);
+    EXPECT_EQ(all.value()[150].price, make_ticks(150, 1)[0].price);
+    std::filesystem::remove(path);
+}
+
+TEST(GainCapitalUnit, Tick_Store_Invalid_File)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "gc_tick_store_invalid.gctk";
+    {
+        std::ofstream file {path, std::ios_base::binary | std::ios_base::trunc};
+        file << "{\"PriceTicks\":[{\"TickDate\":\"\\/Date(0)\\/\",\"Price\":1.0}]}";
+    }
+    auto reader = GC::GCTickReader::open(path);
+    ASSERT_FALSE(reader.has_value());
+    EXPECT_EQ(std::string(reader.error().what()), "Tick File Error - Invalid Header - " + path.string());
+    EXPECT_FALSE(GC::GCTickWriter::open(path).has_value());
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(GC::GCTickReader::open(path).has_value());
+}
+
+TEST(GainCapitalUnit, Bar_File_Round_Trip)
+{
+    auto const price                       = [](double const value) { return GC::GCPrice {value, 4}; };
+    std::vector<GC::GCPriceBar> const bars = {{60'000, price(1.2), price(1.2004), price(1.1998), price(1.2001)},
+                                              {120'000, price(1.2001), price(1.2003), price(1.2), price(1.2002)}};
+    std::filesystem::path const path       = std::filesystem::temp_directory_path() / "gc_bar_file_round_trip.gcbr";
+
+    ASSERT_TRUE(GC::write_bar_file(path, GC::GCBarColumns::from_bars(bars, 4)).has_value());
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+    auto columns = GC::read_bar_file(path);
+    ASSERT_TRUE(columns.has_value());
+    EXPECT_EQ(columns.value().decimals, 4);
+    EXPECT_EQ(columns.value().close, (std::vector<std::int64_t> {12001, 12002}));
+    auto const round_trip = columns.value().to_bars();
+    ASSERT_EQ(round_trip.size(), 2);
+    EXPECT_EQ(round_trip[1].timestamp_ms, 120'000);
+    EXPECT_EQ(round_trip[1].open, GC::GCPrice(1.2001, 4));
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    auto truncated = GC::read_bar_file(path);
+    ASSERT_FALSE(truncated.has_value());
+    EXPECT_EQ(std::string(truncated.error().what()), "Bar File Error - Truncated File - " + path.string());
+    std::filesystem::remove(path);
+}
+
+// =================================================================================
+// Order Templates
+// =================================================================================
+
+TEST(GainCapitalUnit, Order_Template_Market_Render)
+{
+    GC::GCOrderTemplate order_template {GC::MarketOrder {"USD/CAD", "buy", 1000}, "123", "TradingTestID"};
+    EXPECT_EQ(order_template.endpoint(), "/order/newtradeorder");
+
+    nlohmann::json payload = nlohmann::json::parse(order_template.render(GC::GCPrice {1.25}, GC::GCPrice {1.2502}));
+    EXPECT_EQ(payload["BidPrice"], "1.25");
+    EXPECT_EQ(payload["OfferPrice"], "1.2502");
+    EXPECT_EQ(payload["Quantity"], "1000");
+    EXPECT_EQ(payload["Direction"], "buy");
+    EXPECT_EQ(payload["MarketId"], "123");
+    EXPECT_EQ(payload["MarketName"], "USD/CAD");
+    EXPECT_EQ(payload["TradingAccountId"], "TradingTestID");
+    EXPECT_EQ(payload["PriceTolerance"], "0");
+
+    payload = nlohmann::json::parse(order_template.render(GC::GCPrice {1.3}, GC::GCPrice {1.31}, 500));
+    EXPECT_EQ(payload["BidPrice"], "1.3");
+    EXPECT_EQ(payload["Quantity"], "500");
+}
+
+TEST(GainCapitalUnit, Order_Template_Stop_Limit_Render)
+{
+    GC::GCOrderTemplate order_template {GC::StopLimitOrder {"USD/CAD", "sell", 2000, 1.5, 1.6, 1.4}, "123", "TradingTestID"};
+    EXPECT_EQ(order_template.endpoint(), "/order/newstoplimitorder");
+
+    nlohmann::json const payload = nlohmann::json::parse(order_template.render(GC::GCPrice {1.25}, GC::GCPrice {1.26}));
+    EXPECT_EQ(payload["TriggerPrice"], "1.5");
+    ASSERT_EQ(payload["IfDone"].size(), 2U);
+    EXPECT_EQ(payload["IfDone"][0]["Stop"]["TriggerPrice"], "1.6");
+    EXPECT_EQ(payload["IfDone"][0]["Stop"]["Direction"], "buy");
+    EXPECT_EQ(payload["IfDone"][0]["Stop"]["Quantity"], "2000");
+    EXPECT_EQ(payload["IfDone"][1]["Limit"]["TriggerPrice"], "1.4");
+    EXPECT_EQ(payload["IfDone"][1]["Limit"]["Quantity"], "2000");
+    EXPECT_FALSE(payload.contains("PriceTolerance"));
+}
+
+TEST(GainCapitalUnit, Order_Template_Amend_Render)
+{
+    GC::GCOrderTemplate order_template = GC::GCOrderTemplate::amend(GC::StopLimitOrder {"USD/CAD", "buy", 500, 1.2, 1.1, std::nullopt}, "123",
+                                                                    "TradingTestID", 1234);
+    EXPECT_EQ(order_template.endpoint(), "/order/updatestoplimitorder");
+
+    nlohmann::json const payload = nlohmann::json::parse(order_template.render(GC::GCPrice {1.2}, GC::GCPrice {1.2}));
+    EXPECT_EQ(payload["OrderId"], "1234");
+    EXPECT_EQ(payload["TriggerPrice"], "1.2");
+    EXPECT_EQ(payload["Quantity"], "500");
+    ASSERT_EQ(payload["IfDone"].size(), 1U);
+    EXPECT_EQ(payload["IfDone"][0]["Stop"]["TriggerPrice"], "1.1");
+    EXPECT_EQ(payload["IfDone"][0]["Stop"]["Direction"], "sell");
+    EXPECT_FALSE(payload.contains("Reference"));
+}
+
+// =================================================================================
+// Order Manager
+// =================================================================================
+
+TEST(GainCapitalUnit, Order_Manager_References)
+{
+    GC::GCOrderManager manager {"GCTEST"};
+    std::uint64_t const client_order_id = manager.create(123, 1000, true);
+
+    EXPECT_EQ(client_order_id, 1U);
+    EXPECT_EQ(manager.reference(client_order_id), "GCTEST-1");
+    EXPECT_EQ(manager.parse_reference("GCTEST-1"), 1U);
+    EXPECT_FALSE(manager.parse_reference("OTHER-1").has_value());
+    EXPECT_FALSE(manager.parse_reference("GCTEST-").has_value());
+    EXPECT_FALSE(manager.parse_reference("GCTEST-1x").has_value());
+
+
+    GC::GCOrderTemplate order_template {GC::MarketOrder {"USD/CAD", "buy", 1000}, "123", "TradingTestID", manager.reference(client_order_id)};
+    EXPECT_EQ(nlohmann::json::parse(order_template.render(GC::GCPrice {1.0}, GC::GCPrice {1.1}))["Reference"], "GCTEST-1");
+}
+
+TEST(GainCapitalUnit, Order_Manager_Lifecycle)
+{
+    GC::GCOrderManager manager {"GCTEST"};
+    std::uint64_t const market_order = manager.create(123, -1000, false);
+    std::uint64_t const filled_order = manager.create(123, 1000, true);
+    std::uint64_t const cancel_order = manager.create(123, 500, true);
+
+    manager.acknowledge(market_order, 10);
+    manager.acknowledge(filled_order, 11);
+    manager.acknowledge(cancel_order, 12);
+
+    EXPECT_EQ(manager.find(market_order)->state, GC::GCOrderState::Filled);
+    EXPECT_EQ(manager.find(filled_order)->state, GC::GCOrderState::Acked);
+
+    nlohmann::json const both_working = nlohmann::json::parse(
+        "{\"ActiveOrders\":[{\"TradeOrder\":null,\"StopLimitOrder\":{\"OrderId\":11,\"Reference\":\"GCTEST-2\"}},"
+        "{\"TradeOrder\":null,\"StopLimitOrder\":{\"OrderId\":12}}]}");
+    EXPECT_EQ(manager.reconcile(both_working), 0U);
+    EXPECT_EQ(manager.find(filled_order)->state, GC::GCOrderState::Working);
+    EXPECT_EQ(manager.find_by_order_id(12)->state, GC::GCOrderState::Working);
+
+    manager.request_cancel(11);
+    manager.withdraw_cancel(11);
+    manager.request_cancel(12);
+    EXPECT_EQ(manager.reconcile(nlohmann::json::parse("{\"ActiveOrders\":[]}")), 1U);
+    EXPECT_EQ(manager.find(filled_order)->state, GC::GCOrderState::Closed);
+    EXPECT_EQ(manager.find(cancel_order)->state, GC::GCOrderState::Cancelled);
+
+    EXPECT_EQ(manager.confirm_fills(123, -1000), 0U);
+    EXPECT_EQ(manager.confirm_fills(456, 1000), 0U);
+    EXPECT_EQ(manager.confirm_fills(123, 1000), 1U);
+    EXPECT_EQ(manager.find(filled_order)->state, GC::GCOrderState::Filled);
+
+    EXPECT_FALSE(manager.reconcile(nlohmann::json::parse("{\"ActiveOrders\": \"123\"}")).has_value());
+    EXPECT_EQ(manager.find_on_server(both_working, filled_order), 11);
+    EXPECT_FALSE(manager.find_on_server(both_working, cancel_order).has_value());
+    EXPECT_EQ(manager.snapshot().size(), 3U);
+}
+
+TEST(GainCapitalUnit, Order_Manager_Unknown_Orders)
+{
+    GC::GCOrderManager manager {"GCTEST"};
+    std::uint64_t const market_order  = manager.create(123, 1000, false);
+    std::uint64_t const resting_order = manager.create(123, 1000, true);
+
+    manager.mark_unknown(market_order);
+    manager.mark_unknown(resting_order);
+    EXPECT_EQ(manager.find(market_order)->state, GC::GCOrderState::Unknown);
+
+    // A Resting Order Is Settled by the Active Orders
+    EXPECT_EQ(manager.reconcile(nlohmann::json::parse("{\"ActiveOrders\":[{\"StopLimitOrder\":{\"OrderId\":20,\"Reference\":\"GCTEST-2\"}}]}")), 0U);
+    EXPECT_EQ(manager.find(resting_order)->state, GC::GCOrderState::Working);
+    EXPECT_EQ(manager.find(market_order)->state, GC::GCOrderState::Unknown);
+
+    // A Market Order Only by a Position Correction
+    EXPECT_EQ(manager.confirm_fills(123, 1000), 1U);
+    EXPECT_EQ(manager.find(market_order)->state, GC::GCOrderState::Filled);
+}
+
+// =================================================================================
+// Position Book
+// =================================================================================
+
+TEST(GainCapitalUnit, Position_Book_Fills)
+{
+    GC::GCPositionBook book;
+    book.apply_fill(123, 1000, 1.0);
+    book.apply_fill(123, 1000, 2.0);
+
+    EXPECT_EQ(book.exposure(123), 2000.0);
+    EXPECT_DOUBLE_EQ(book.position(123)->average_price, 1.5);
+
+    book.apply_fill(123, -500, 3.0);
+    EXPECT_EQ(book.exposure(123), 1500.0);
+    EXPECT_DOUBLE_EQ(book.position(123)->average_price, 1.5);
+
+    book.apply_fill(123, -2000, 4.0);
+    EXPECT_EQ(book.exposure(123), -500.0);
+    EXPECT_DOUBLE_EQ(book.position(123)->average_price, 4.0);
+
+    book.apply_fill(123, 500, 1.0);
+    EXPECT_EQ(book.exposure(123), 0.0);
+    EXPECT_FALSE(book.position(123).has_value());
+}
+
+TEST(GainCapitalUnit, Position_Book_Reconcile_Differences)
+{
+    GC::GCPositionBook book;
+    book.apply_fill(123, 1000, 1.0);
+    book.apply_fill(456, 500, 1.0);
+    book.apply_fill(789, -100, 1.0);
+
+    nlohmann::json const open_positions = nlohmann::json::parse(
+        "{\"OpenPositions\":[{\"MarketId\":123,\"Direction\":\"buy\",\"Quantity\":1000,\"Price\":1.0},"
+        "{\"MarketId\":456,\"Direction\":\"buy\",\"Quantity\":800,\"Price\":1.0},"
+        "{\"MarketId\":456,\"Direction\":\"sell\",\"Quantity\":100,\"Price\":2.0},"
+        "{\"MarketId\":999,\"Direction\":\"sell\",\"Quantity\":\"250\",\"Price\":1.0}]}");
+
+    EXPECT_EQ(book.reconcile(open_positions), 3U);
+    EXPECT_EQ(book.exposure(123), 1000.0);
+    EXPECT_EQ(book.exposure(456), 700.0);
+    EXPECT_EQ(book.exposure(789), 0.0);
+    EXPECT_EQ(book.exposure(999), -250.0);
+    EXPECT_EQ(book.snapshot().size(), 3U);
+
+    EXPECT_EQ(book.reconcile(open_positions), 0U);
+    EXPECT_FALSE(book.reconcile(nlohmann::json::parse("{\"OpenPositions\": \"123\"}")).has_value());
+    EXPECT_FALSE(book.reconcile(nlohmann::json::parse("{\"OpenPositions\":[{\"MarketId\":123,\"Quantity\":\"1,000\"}]}")).has_value());
+    EXPECT_EQ(book.exposure(123), 1000.0);
+}
+
+TEST(GainCapitalUnit, Position_Book_Reconcile_Skips_Fills_After_Stamp)
+{
+    GC::GCPositionBook book;
+    std::vector<std::pair<std::int64_t, double>> corrections;
+    book.set_correction_listener([&corrections](std::int64_t const market_id, double const quantity_change)
+                                 { corrections.emplace_back(market_id, quantity_change); });
+    book.apply_fill(123, 1000, 1.0);
+
+    // The Snapshot Was Requested Before the Fill on 456 Was Applied
+    std::uint64_t const fill_stamp = book.fill_sequence();
+    book.apply_fill(456, 500, 1.0);
+    nlohmann::json const open_positions = nlohmann::json::parse("{\"OpenPositions\":[{\"MarketId\":123,\"Direction\":\"buy\",\"Quantity\":800}]}");
+
+    EXPECT_EQ(book.reconcile(open_positions, fill_stamp), 1U);
+    EXPECT_EQ(book.exposure(123), 800.0);
+    EXPECT_EQ(book.exposure(456), 500.0);
+    ASSERT_EQ(corrections.size(), 1U);
+    EXPECT_EQ(corrections[0].first, 123);
+    EXPECT_EQ(corrections[0].second, -200.0);
+
+    // A Snapshot Taken After the Fill Applies to Every Market
+    EXPECT_EQ(book.reconcile(open_positions, book.fill_sequence()), 1U);
+    EXPECT_EQ(book.exposure(456), 0.0);
+}
+
+// =================================================================================
+// Active Orders
+// =================================================================================
+
+TEST(GainCapitalUnit, Active_Orders_Window)
+{
+    GC::GCActiveOrderTracker tracker(100);
+    EXPECT_EQ(tracker.window("ACCOUNT"), 100U);
+
+    tracker.record_count("ACCOUNT", 99);
+    EXPECT_EQ(tracker.window("ACCOUNT"), 100U);
+
+    tracker.record_count("ACCOUNT", 100);
+    EXPECT_EQ(tracker.window("ACCOUNT"), 200U);
+    EXPECT_EQ(tracker.window("OTHER"), 100U);
+
+    tracker.record_count("ACCOUNT", 1000000);
+    EXPECT_EQ(tracker.window("ACCOUNT"), GC::GCActiveOrderTracker::MAX_WINDOW);
+}
+
+TEST(GainCapitalUnit, Active_Orders_Diff)
+{
+    GC::GCActiveOrderTracker tracker;
+    auto const listing = [](std::string const& orders) { return nlohmann::json::parse("{\"ActiveOrders\":[" + orders + "]}"); };
+
+    auto delta = tracker.diff("ACCOUNT", listing("{\"TradeOrder\":null,\"StopLimitOrder\":{\"OrderId\":1,\"Quantity\":1}},"
+                                                 "{\"TradeOrder\":{\"OrderId\":2,\"Quantity\":1},\"StopLimitOrder\":null}"));
+    ASSERT_TRUE(delta.has_value());
+    EXPECT_EQ(delta->added.size(), 2U);
+
+    delta = tracker.diff("ACCOUNT", listing("{\"TradeOrder\":null,\"StopLimitOrder\":{\"OrderId\":1,\"Quantity\":2}},"
+                                            "{\"TradeOrder\":null,\"StopLimitOrder\":{\"OrderId\":3,\"Quantity\":1}}"));
+    ASSERT_TRUE(delta.has_value());
+    ASSERT_EQ(delta->added.size(), 1U);
+    ASSERT_EQ(delta->changed.size(), 1U);
+    ASSERT_EQ(delta->removed.size(), 1U);
+    EXPECT_EQ(delta->added[0]["StopLimitOrder"]["OrderId"], 3);
+    EXPECT_EQ(delta->changed[0]["StopLimitOrder"]["Quantity"], 2);
+    EXPECT_EQ(delta->removed[0], 2);
+
+    EXPECT_FALSE(tracker.diff("ACCOUNT", nlohmann::json::parse("{\"ActiveOrders\": \"123\"}")).has_value());
+}
+
+class FullBookTransport final : public GC::GCTransport
+{
+    /* Every active order listing fills whatever MaxResults window it is asked for */
+  public:
+    std::uint64_t submit(GC::NetworkRequest request, GC::NetworkCallback callback) override
+    {
+        std::string body = "{\"statusCode\":0,\"session\":\"Session\",\"isAuthenticated\":true,"
+                           "\"tradingAccounts\":[{\"tradingAccountId\":1,\"clientAccountId\":2}]}";
+        if (request.url.ends_with("/order/activeorders"))
+        {
+            std::size_t const max_results = std::stoul(nlohmann::json::parse(request.payload)["MaxResults"].get<std::string>());
+            nlohmann::json listing        = nlohmann::json::array();
+            for (std::size_t i = 0; i < max_results; ++i)
+            {
+                listing.push_back({{"TradeOrder", nullptr}, {"StopLimitOrder", {{"OrderId", i + 1}}}});
+            }
+            body = nlohmann::json {{"ActiveOrders", std::move(listing)}}.dump();
+            ++listings;
+        }
+        callback(GC::NetworkResponse {200, body, "", {}});
+        return listings;
+    }
+
+    [[nodiscard]] std::size_t in_flight() const noexcept override { return 0; }
+
+    std::uint64_t listings {};
+};
+
+TEST(GainCapitalUnit, Active_Orders_Truncated_At_Max_Window)
+{
+    auto transport = std::make_shared<FullBookTransport>();
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_transport(transport);
+    ASSERT_TRUE(gc.authenticate_session().has_value());
+    gc.set_active_orders_page_size(GC::GCActiveOrderTracker::MAX_WINDOW / 4);
+
+    // The Window Doubles to Its Limit, Then a Full Listing Is an Error Rather Than a Silently Truncated Book
+    auto active_orders_response = gc.list_active_orders();
+    ASSERT_FALSE(active_orders_response.has_value());
+    EXPECT_EQ(std::string(active_orders_response.error().what()),
+              "Active Orders Truncated at " + std::to_string(GC::GCActiveOrderTracker::MAX_WINDOW) + " Orders");
+    EXPECT_EQ(transport->listings, 3U);
+    EXPECT_FALSE(gc.reconcile_orders().has_value());
+}
+
+// =================================================================================
+// Market Specs
+// =================================================================================
+
+TEST(GainCapitalUnit, Market_Spec_Parse)
+{
+    auto const spec = GC::parse_market_spec(nlohmann::json::parse("{\"MarketInformation\":{\"MarketId\":123,\"PriceDecimalPlaces\":3,"
+                                                                   "\"WebMinSize\":1000,\"MaxLongSize\":\"50000\",\"MaxShortSize\":20000,"
+                                                                   "\"IncrementSize\":500}}"));
+    ASSERT_TRUE(spec.has_value());
+    EXPECT_EQ(spec->market_id, 123);
+    EXPECT_EQ(spec->price_decimals, 3);
+    EXPECT_EQ(spec->max_long_quantity, 50000.0);
+    EXPECT_DOUBLE_EQ(spec->round_price(1.23456), 1.235);
+
+    EXPECT_FALSE(spec->check_quantity(1500).has_value());
+    EXPECT_FALSE(spec->check_quantity(-20000).has_value());
+    EXPECT_EQ(spec->check_quantity(500), "Quantity Below Market Minimum");
+    EXPECT_EQ(spec->check_quantity(-25000), "Quantity Above Market Maximum");
+    EXPECT_EQ(spec->check_quantity(1250), "Quantity Not a Multiple of the Market Increment");
+
+    EXPECT_FALSE(GC::parse_market_spec(nlohmann::json::parse("{\"MarketInformation\":{\"MarketId\":123}}")).has_value());
+}
+
+TEST(GainCapitalUnit, Market_Spec_Store)
+{
+    GC::GCMarketSpecStore store;
+    EXPECT_FALSE(store.find("USD/CAD").has_value());
+
+    store.publish({{"USD/CAD", GC::GCMarketSpec {.market_id = 123, .price_decimals = 5}}});
+    store.publish({{"EUR/USD", GC::GCMarketSpec {.market_id = 456, .price_decimals = 4}}});
+
+    EXPECT_EQ(store.find("USD/CAD")->price_decimals, 5);
+    EXPECT_EQ(store.find(std::int64_t {456})->price_decimals, 4);
+    EXPECT_FALSE(store.find(std::int64_t {789}).has_value());
+}
+
+// =================================================================================
+// Risk Engine
+// =================================================================================
+
+TEST(GainCapitalUnit, Risk_Engine_Limits)
+{
+    auto const book = std::make_shared<GC::GCPositionBook>();
+    book->apply_fill(123, 800, 1.0);
+
+    GC::GCRiskEngine engine {book};
+    EXPECT_EQ(engine.check({123, 1e9, 1.0, 1.0, 1.0}), GC::GCRiskResult::Accepted);
+
+    engine.set_limits({.max_notional = 10000, .max_position = 1000, .price_band = 0.01});
+    EXPECT_EQ(engine.check({123, 100, 1.0, 0.999, 1.001}), GC::GCRiskResult::Accepted);
+    EXPECT_EQ(engine.check({123, -20000, 1.0, 0.999, 1.001}), GC::GCRiskResult::MaxNotional);
+    EXPECT_EQ(engine.check({123, 300, 1.0, 0.999, 1.001}), GC::GCRiskResult::MaxPosition);
+    EXPECT_EQ(engine.check({123, -1500, 1.0, 0.999, 1.001}), GC::GCRiskResult::Accepted);
+    EXPECT_EQ(engine.check({123, 100, 1.05, 0.999, 1.001}), GC::GCRiskResult::PriceBand);
+
+    engine.set_market_limits(456, {.max_position = 50});
+    EXPECT_EQ(engine.check({456, 100, 1.05, 0.999, 1.001}), GC::GCRiskResult::MaxPosition);
+    EXPECT_EQ(engine.check({456, 50, 1.05, 0.999, 1.001}), GC::GCRiskResult::Accepted);
+
+    engine.add_rule([](GC::GCRiskOrder const& order) { return order.signed_quantity > 0; });
+    EXPECT_EQ(engine.check({123, -100, 1.0, 0.999, 1.001}), GC::GCRiskResult::Rule);
+    EXPECT_EQ(GC::GCRiskEngine::describe(GC::GCRiskResult::Rule), "Custom Rule Failed");
+}
+
+TEST(GainCapitalUnit, Risk_Engine_Order_Rate)
+{
+    GC::GCRiskEngine engine {std::make_shared<GC::GCPositionBook>()};
+    engine.set_limits({.max_orders_per_second = 2});
+
+    EXPECT_EQ(engine.check({123, 100, 1.0, 1.0, 1.0}), GC::GCRiskResult::Accepted);
+    EXPECT_EQ(engine.check({123, 100, 1.0, 1.0, 1.0}), GC::GCRiskResult::Accepted);
+    EXPECT_EQ(engine.check({123, 100, 1.0, 1.0, 1.0}), GC::GCRiskResult::OrderRate);
+    EXPECT_EQ(engine.check({123, 100, 1.0, 1.0, 1.0}, false), GC::GCRiskResult::Accepted);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {600});
+    EXPECT_EQ(engine.check({123, 100, 1.0, 1.0, 1.0}), GC::GCRiskResult::Accepted);
+}
+
+// =================================================================================
+// Record and Replay Transport
+// =================================================================================
+
+class CountingTransport final : public GC::GCTransport
+{
+  public:
+    explicit CountingTransport(std::chrono::milliseconds const response_latency = std::chrono::milliseconds::zero()) : latency(response_latency) {}
+
+    std::uint64_t submit(GC::NetworkRequest request, GC::NetworkCallback callback) override
+    {
+        std::this_thread::sleep_for(latency);
+        callback(GC::NetworkResponse {200, request.type + " " + request.url + " " + std::to_string(++count), "", {{"Server", "stub"}}});
+        return count;
+    }
+
+    [[nodiscard]] std::size_t in_flight() const noexcept override { return 0; }
+
+  private:
+    std::chrono::milliseconds latency;
+    std::uint64_t count {};
+};
+
+GC::NetworkResponse submit_and_wait(GC::GCTransport& transport, std::string const& type, std::string const& url, std::string const& payload = "")
+{
+    std::promise<GC::NetworkResponse> promise;
+    auto future = promise.get_future();
+    transport.submit(GC::NetworkRequest {type, url, {{"Authorization", "token"}}, payload},
+                     [&promise](GC::NetworkResponse&& response) { promise.set_value(std::move(response)); });
+    return future.get();
+}
+
+TEST(GainCapitalUnit, Transport_Record_Replay)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "gc_transport_record_replay.gcrr";
+    {
+        auto recorder = GC::GCRecordingTransport::open(path, std::make_shared<CountingTransport>());
+        ASSERT_TRUE(recorder.has_value());
+        EXPECT_EQ(submit_and_wait(*recorder.value(), "GET", "https://live.example/market/1/tickhistory").text,
+                  "GET https://live.example/market/1/tickhistory 1");
+        auto _ = submit_and_wait(*recorder.value(), "GET", "https://live.example/market/1/tickhistory");
+        _      = submit_and_wait(*recorder.value(), "POST", "https://live.example/v2/Session", "{\"Password\":\"secret\"}");
+        _      = submit_and_wait(*recorder.value(), "POST", "https://live.example/order/newtradeorder", "{\"Quantity\":\"1000\"}");
+        EXPECT_EQ(recorder.value()->records(), 4);
+        EXPECT_TRUE(recorder.value()->flush().has_value());
+    }
+    std::ifstream file {path, std::ios_base::binary};
+    std::string const contents {std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {}};
+    EXPECT_EQ(contents.find("secret"), std::string::npos);
+    EXPECT_EQ(contents.find("token"), std::string::npos);
+    EXPECT_EQ(contents.find("Session 3"), std::string::npos);
+
+    auto replay = GC::GCReplayTransport::open(path, 0.0);
+    ASSERT_TRUE(replay.has_value());
+    EXPECT_EQ(replay.value()->size(), 4);
+
+    // Matched on Path, Served in Recorded Order, Then From the Start
+    GC::NetworkResponse response = submit_and_wait(*replay.value(), "GET", "http://localhost:9200/market/1/tickhistory");
+    EXPECT_EQ(response.status_code, 200);
+    EXPECT_EQ(response.text, "GET https://live.example/market/1/tickhistory 1");
+    EXPECT_EQ(response.header["Server"], "stub");
+    EXPECT_EQ(submit_and_wait(*replay.value(), "GET", "http://localhost:9200/market/1/tickhistory").text,
+              "GET https://live.example/market/1/tickhistory 2");
+    EXPECT_EQ(submit_and_wait(*replay.value(), "GET", "http://localhost:9200/market/1/tickhistory").text,
+              "GET https://live.example/market/1/tickhistory 1");
+
+    // Logon Payload and Response Were Not Recorded | Falls Back to Method and Path, Answered With a Placeholder Session
+    EXPECT_EQ(submit_and_wait(*replay.value(), "POST", "http://localhost:9200/v2/Session", "{\"Password\":\"other\"}").text,
+              "{\"statusCode\":0,\"session\":\"REPLAYED_SESSION\"}");
+    EXPECT_EQ(submit_and_wait(*replay.value(), "POST", "http://localhost:9200/order/newtradeorder", "{\"Quantity\":\"5\"}").text,
+              "POST https://live.example/order/newtradeorder 4");
+
+    response = submit_and_wait(*replay.value(), "GET", "http://localhost:9200/market/2/tickhistory");
+    EXPECT_EQ(response.status_code, 404);
+    EXPECT_EQ(response.text, "Replay Error - No Recorded Response - GET /market/2/tickhistory");
+    EXPECT_EQ(replay.value()->misses(), 1);
+    EXPECT_EQ(replay.value()->in_flight(), 0);
+
+    replay.value().reset();
+    std::filesystem::remove(path);
+    EXPECT_FALSE(GC::GCReplayTransport::open(path).has_value());
+}
+
+TEST(GainCapitalUnit, Transport_Replay_Recorded_Speed)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "gc_transport_recorded_speed.gcrr";
+    {
+        auto recorder = GC::GCRecordingTransport::open(path, std::make_shared<CountingTransport>(std::chrono::milliseconds {100}));
+        ASSERT_TRUE(recorder.has_value());
+        auto _ = submit_and_wait(*recorder.value(), "GET", "https://live.example/userAccount/ClientAndTradingAccount");
+    }
+    auto const elapsed = [&path](double const speed)
+    {
+        auto replay = GC::GCReplayTransport::open(path, speed);
+        auto start  = std::chrono::steady_clock::now();
+        auto _      = submit_and_wait(*replay.value(), "GET", "http://localhost:9200/userAccount/ClientAndTradingAccount");
+        return std::chrono::steady_clock::now() - start;
+    };
+    EXPECT_GE(elapsed(1.0), std::chrono::milliseconds {100});
+    EXPECT_LT(elapsed(0.0), std::chrono::milliseconds {50});
+    std::filesystem::remove(path);
+}
+
+// =================================================================================
+// Hedged Requests
+// =================================================================================
+
+class StragglerTransport final : public GC::GCTransport
+{
+    /* The first request hangs until it is cancelled; every later one is answered at once */
+  public:
+    std::uint64_t submit(GC::NetworkRequest request, GC::NetworkCallback callback) override
+    {
+        std::unique_lock<std::mutex> lock {mutex};
+        std::uint64_t const id = ++submitted;
+        if (id == 1)
+        {
+            straggler = std::move(callback);
+            return id;
+        }
+        lock.unlock();
+        callback(GC::NetworkResponse {200, request.type + " " + std::to_string(id), "", {}});
+        return id;
+    }
+
+    void cancel(std::uint64_t const id) override
+    {
+        GC::NetworkCallback callback;
+        {
+            std::lock_guard<std::mutex> const lock {mutex};
+            cancelled.push_back(id);
+            callback = id == 1 ? std::move(straggler) : nullptr;
+        }
+        if (callback)
+        {
+            callback(GC::NetworkResponse {0, "", "Request Cancelled", {}});
+        }
+    }
+
+    [[nodiscard]] std::size_t in_flight() const noexcept override { return 0; }
+
+    std::vector<std::uint64_t> cancelled_ids()
+    {
+        std::lock_guard<std::mutex> const lock {mutex};
+        return cancelled;
+    }
+
+  private:
+    std::mutex mutex;
+    std::uint64_t submitted {};
+    GC::NetworkCallback straggler;
+    std::vector<std::uint64_t> cancelled;
+};
+
+TEST(GainCapitalUnit, Hedge_Straggler_Cancelled)
+{
+    GC::GCHedgePolicy policy;
+    policy.max_delay        = std::chrono::milliseconds {20};
+    policy.holdout_fraction = 0;
+    GC::GCHedger hedger {policy};
+    auto transport = std::make_shared<StragglerTransport>();
+
+    auto const start = std::chrono::steady_clock::now();
+    std::promise<GC::NetworkResponse> promise;
+    auto future = promise.get_future();
+    hedger.submit(transport, GC::NetworkRequest {"GET", URL + "/market/1/tickhistory?PriceTicks=1", {}, ""},
+                  [&promise](GC::NetworkResponse&& response) { promise.set_value(std::move(response)); });
+    GC::NetworkResponse const response = future.get();
+
+    // The Hedge Answers After the Delay and the Straggler Is Cancelled
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds {20});
+    EXPECT_EQ(response.status_code, 200);
+    EXPECT_EQ(response.text, "GET 2");
+    EXPECT_EQ(transport->cancelled_ids(), std::vector<std::uint64_t> {1});
+    GC::GCHedgeStats const stats = hedger.stats();
+    EXPECT_EQ(stats.hedgeable_reads, 1);
+    EXPECT_EQ(stats.hedges_sent, 1);
+    EXPECT_EQ(stats.hedge_wins, 1);
+}
+
+TEST(GainCapitalUnit, Hedge_Fast_Reads_And_Other_Endpoints)
+{
+    GC::GCHedger hedger {GC::GCHedgePolicy {}};
+    auto transport = std::make_shared<CountingTransport>();
+    EXPECT_EQ(hedger.hedge_delay(), std::chrono::milliseconds {500});
+
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        auto _ = submit_and_wait(*transport, "GET", URL);
+        std::promise<void> done;
+        hedger.submit(transport, GC::NetworkRequest {"GET", URL + "/market/1/barhistory", {}, ""},
+                      [&done](GC::NetworkResponse&&) { done.set_value(); });
+        done.get_future().get();
+    }
+    EXPECT_FALSE(hedger.hedges(GC::NetworkRequest {"POST", URL + "/market/1/tickhistory", {}, ""}));
+    EXPECT_FALSE(hedger.hedges(GC::NetworkRequest {"GET", URL + "/order/openpositions", {}, ""}));
+    EXPECT_TRUE(hedger.hedges(GC::NetworkRequest {"GET", URL + "/cfd/markets?MarketName=USD/CAD", {}, ""}));
+
+    // Answered Well Within the Delay | The Delay Falls to Its Floor
+    GC::GCHedgeStats const stats = hedger.stats();
+    EXPECT_EQ(stats.hedgeable_reads, 100);
+    EXPECT_EQ(stats.hedges_sent, 0);
+    EXPECT_EQ(hedger.hedge_delay(), std::chrono::milliseconds {2});
+}
+
+// =================================================================================
+// Mock Server
+// =================================================================================
+
+TEST(GainCapitalUnit, Mock_Server_Session)
+{
+    GC::GCMockServerConfig config;
+    config.threads = 2;
+    auto server    = GC::GCMockServer::start(config);
+    ASSERT_TRUE(server.has_value());
+
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(server.value()->url());
+    ASSERT_TRUE(gc.authenticate_session().has_value());
+    EXPECT_EQ(gc.CLASS_trading_account_id, "\"MockTradingAccount\"");
+
+    auto tick_response = gc.get_tick_history("USD/CAD", 250);
+    ASSERT_TRUE(tick_response.has_value());
+    EXPECT_EQ(tick_response.value().size(), 250);
+    auto bar_response = gc.get_bar_history("USD/CAD", "MINUTE", 40);
+    ASSERT_TRUE(bar_response.has_value());
+    EXPECT_EQ(bar_response.value().size(), 40);
+
+    auto order_response = gc.trade_order(GC::StopLimitOrder {"USD/CAD", "buy", 1000, 1.3, std::nullopt, std::nullopt});
+    ASSERT_TRUE(order_response.has_value());
+    std::string const order_id = std::to_string(order_response.value()["OrderId"].get<std::int64_t>());
+    EXPECT_EQ(gc.list_active_orders().value()["ActiveOrders"].size(), 1);
+    EXPECT_TRUE(gc.cancel_order(order_id).has_value());
+    EXPECT_EQ(gc.list_active_orders().value()["ActiveOrders"].size(), 0);
+    EXPECT_GE(server.value()->requests_served(), 7);
+
+    server.value()->stop();
+    EXPECT_FALSE(gc.get_account_info().has_value());
+}
+
+TEST(GainCapitalUnit, Reactor_Cancel)
+{
+    GC::GCMockServerConfig config;
+    config.threads = 1;
+    config.latency = std::chrono::seconds {2};
+    auto server    = GC::GCMockServer::start(config);
+    ASSERT_TRUE(server.has_value());
+
+    GC::GCReactor reactor;
+    auto const start = std::chrono::steady_clock::now();
+    std::promise<GC::NetworkResponse> promise;
+    auto future            = promise.get_future();
+    std::uint64_t const id = reactor.submit(GC::NetworkRequest {"GET", server.value()->url() + "/market/1/information", {}, ""},
+                                            [&promise](GC::NetworkResponse&& response) { promise.set_value(std::move(response)); });
+    reactor.cancel(id);
+    GC::NetworkResponse const response = future.get();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds {1});
+    EXPECT_EQ(response.status_code, 0);
+    EXPECT_EQ(response.error_message, "Request Cancelled");
+
+    // Cancelling a Finished Request Changes Nothing
+    reactor.cancel(id);
+    EXPECT_EQ(reactor.in_flight(), 0);
+}
+
+[[noreturn]] void construct_reactor_without_files()
+{
+    rlimit const no_files {0, 0};
+    setrlimit(RLIMIT_NOFILE, &no_files);
+    try
+    {
+        GC::GCReactor const reactor;
+    }
+    catch (GC::GCException const& error)
+    {
+        std::_Exit(std::string(error.what()).starts_with("Failed to Create Epoll Instance") ? 0 : 2);
+    }
+    std::_Exit(1);
+}
+
+TEST(GainCapitalUnit, Reactor_Setup_Failure_Throws)
+{
+    // With No File Descriptors Left the Epoll Instance Cannot Be Created
+    EXPECT_EXIT(construct_reactor_without_files(), ::testing::ExitedWithCode(0), "");
+}
+
+TEST(GainCapitalUnit, Mock_Server_Faults)
+{
+    auto const start_session = [](GC::GCMockFaults const& faults)
+    {
+        GC::GCMockServerConfig config;
+        config.threads = 1;
+        config.faults  = faults;
+        auto server    = std::move(GC::GCMockServer::start(config).value());
+        auto gc        = std::make_unique<GC::GCClient>("USER", "PASSWORD", "APIKEY");
+        gc->set_testing_rest_urls(server->url());
+        [[maybe_unused]] auto const auth_response = gc->authenticate_session();
+        return std::pair {std::move(server), std::move(gc)};
+    };
+
+    // Every Request Outside Logon Lands in a Burst
+    auto [throttled_server, throttled] = start_session({.burst_probability = 1, .burst_length = 3, .burst_status = 429});
+    auto account_response              = throttled->get_account_info();
+    ASSERT_FALSE(account_response.has_value());
+    EXPECT_NE(std::string(account_response.error().what()).find("Status Code: 429"), std::string::npos);
+    EXPECT_EQ(throttled_server->faults_injected(), throttled_server->requests_served() - 1);
+
+    // A Stalled Body Still Arrives Whole
+    auto [stalled_server, stalled] = start_session({.stall_probability = 1, .stall = std::chrono::milliseconds {100}});
+    auto const start               = std::chrono::steady_clock::now();
+    auto tick_response             = stalled->get_tick_history("USD/CAD", 500);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds {100});
+    ASSERT_TRUE(tick_response.has_value());
+    EXPECT_EQ(tick_response.value().size(), 500);
+
+    auto [reset_server, reset] = start_session({.reset_probability = 1});
+    EXPECT_FALSE(reset->get_account_info().has_value());
+}
+
+// =================================================================================
+// Deadlines
+// =================================================================================
+
+TEST(GainCapitalUnit, Deadline_Scope_Nesting)
+{
+    EXPECT_EQ(GC::GCDeadlineScope::current(), GC::NO_DEADLINE);
+    {
+        GC::GCDeadlineScope const outer {std::chrono::seconds {1}};
+        GC::GCDeadline const outer_deadline = GC::GCDeadlineScope::current();
+        {
+            // A Nested Scope Only Shortens the Deadline
+            GC::GCDeadlineScope const longer {std::chrono::seconds {10}};
+            EXPECT_EQ(GC::GCDeadlineScope::current(), outer_deadline);
+            GC::GCDeadlineScope const shorter {std::chrono::milliseconds {10}};
+            EXPECT_LT(GC::GCDeadlineScope::current(), outer_deadline);
+        }
+        EXPECT_EQ(GC::GCDeadlineScope::current(), outer_deadline);
+        std::async(std::launch::async, [] { EXPECT_EQ(GC::GCDeadlineScope::current(), GC::NO_DEADLINE); }).wait();
+    }
+    EXPECT_EQ(GC::GCDeadlineScope::current(), GC::NO_DEADLINE);
+}
+
+TEST(GainCapitalUnit, Deadline_Exceeded)
+{
+    GC::GCMockServerConfig config;
+    config.threads = 1;
+    config.faults  = {.stall_probability = 1, .stall = std::chrono::seconds {2}};
+    auto server    = GC::GCMockServer::start(config);
+    ASSERT_TRUE(server.has_value());
+
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(server.value()->url());
+    {
+        // Logon Is Never Faulted; the Account Lookup After It Stalls
+        GC::GCDeadlineScope const scope {std::chrono::milliseconds {200}};
+        [[maybe_unused]] auto const auth_response = gc.authenticate_session();
+    }
+    ASSERT_TRUE(gc.validate_session_header().has_value());
+
+    auto const expect_deadline_exceeded = [](auto const& response, std::chrono::steady_clock::time_point const start)
+    {
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds {1});
+        ASSERT_FALSE(response.has_value());
+        EXPECT_EQ(response.error().code(), GC::GCErrorCode::DeadlineExceeded);
+    };
+    {
+        GC::GCDeadlineScope const scope {std::chrono::milliseconds {100}};
+        auto const start = std::chrono::steady_clock::now();
+        auto response    = gc.get_account_info();
+        expect_deadline_exceeded(response, start);
+        EXPECT_STREQ(response.error().what(), "Deadline Exceeded");
+    }
+    {
+        // The Deadline Reaches the Price Fetches Inside trade_order
+        GC::GCDeadlineScope const scope {std::chrono::milliseconds {150}};
+        auto const start = std::chrono::steady_clock::now();
+        expect_deadline_exceeded(gc.trade_order(GC::StopLimitOrder {"USD/CAD", "buy", 1000, 1.3, std::nullopt, std::nullopt}), start);
+    }
+    {
+        GC::GCDeadlineScope const expired {std::chrono::milliseconds::zero()};
+        expect_deadline_exceeded(gc.get_tick_history("USD/CAD", 100), std::chrono::steady_clock::now());
+    }
+
+    // Without a Scope the Client's Request Timeout Applies
+    gc.set_request_timeout(std::chrono::milliseconds {100});
+    expect_deadline_exceeded(gc.get_margin_info(), std::chrono::steady_clock::now());
+
+    // The Reactor Ends the Transfer Itself
+    GC::GCReactor reactor;
+    std::promise<GC::NetworkResponse> promise;
+    auto future = promise.get_future();
+    [[maybe_unused]] std::uint64_t const id =
+        reactor.submit(GC::NetworkRequest {"GET", server.value()->url() + "/market/1/information", {}, "",
+                                           std::chrono::steady_clock::now() + std::chrono::milliseconds {100}},
+                       [&promise](GC::NetworkResponse&& response) { promise.set_value(std::move(response)); });
+    GC::NetworkResponse const response = future.get();
+    EXPECT_TRUE(response.deadline_exceeded);
+    EXPECT_EQ(response.status_code, 0);
+    EXPECT_EQ(reactor.in_flight(), 0);
+}
+
+TEST(GainCapitalUnit, Deadline_Not_Shared_By_Coalesced_Reads)
+{
+    GC::GCMockServerConfig config;
+    config.threads = 1;
+    config.latency = std::chrono::milliseconds {300};
+    auto server    = GC::GCMockServer::start(config);
+    ASSERT_TRUE(server.has_value());
+
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(server.value()->url());
+    ASSERT_TRUE(gc.authenticate_session().has_value());
+    std::size_t const coalesced_before = gc.get_metrics().requests_coalesced;
+
+    // The Same GET From a Tight Scope and From a Thread Without One
+    auto scoped = std::async(std::launch::async,
+                             [&gc]
+                             {
+                                 GC::GCDeadlineScope const scope {std::chrono::milliseconds {50}};
+                                 return gc.get_margin_info();
+                             });
+    std::this_thread::sleep_for(std::chrono::milliseconds {10});
+    auto unscoped = std::async(std::launch::async, [&gc] { return gc.get_margin_info(); });
+
+    auto scoped_response = scoped.get();
+    ASSERT_FALSE(scoped_response.has_value());
+    EXPECT_EQ(scoped_response.error().code(), GC::GCErrorCode::DeadlineExceeded);
+    EXPECT_TRUE(unscoped.get().has_value());
+    EXPECT_EQ(gc.get_metrics().requests_coalesced, coalesced_before);
+}
+
+// =================================================================================
+// Circuit Breaker
+// =================================================================================
+
+namespace
+{
+
+GC::NetworkResponse response_with_status(long const status_code)
+{
+    GC::NetworkResponse response;
+    response.status_code = status_code;
+    return response;
+}
+
+GC::GCBreakerStats breaker_stats(GC::GCCircuitBreaker const& breaker, std::string const& endpoint)
+{
+    for (GC::GCBreakerStats const& stats : breaker.stats())
+    {
+        if (stats.endpoint == endpoint)
+        {
+            return stats;
+        }
+    }
+    return GC::GCBreakerStats {};
+}
+
+}// namespace
+
+TEST(GainCapitalUnit, Breaker_Endpoint_Key)
+{
+    EXPECT_EQ(GC::GCCircuitBreaker::endpoint_key("GET", "https://ciapi.cityindex.com/TradingAPI/market/401484347/tickhistory?PriceTicks=1"),
+              "GET /TradingAPI/market/{id}/tickhistory");
+    EXPECT_EQ(GC::GCCircuitBreaker::endpoint_key("GET", "https://ciapi.cityindex.com/TradingAPI/market/154297/tickhistory?PriceTicks=5"),
+              "GET /TradingAPI/market/{id}/tickhistory");
+    EXPECT_EQ(GC::GCCircuitBreaker::endpoint_key("POST", "http://127.0.0.1:8080/v2/order/newtradeorder"), "POST /v2/order/newtradeorder");
+    EXPECT_EQ(GC::GCCircuitBreaker::endpoint_key("GET", "http://127.0.0.1:8080"), "GET /");
+}
+
+TEST(GainCapitalUnit, Breaker_Trip_And_Recover)
+{
+    GC::GCBreakerPolicy policy;
+    policy.min_requests  = 4;
+    policy.open_duration = std::chrono::milliseconds {50};
+    policy.probes        = 2;
+    GC::GCCircuitBreaker breaker(policy);
+    std::string const url = "http://127.0.0.1/market/1/tickhistory";
+    std::string const key = "GET /market/{id}/tickhistory";
+
+    // Client Errors Do Not Count; Half of Four Requests Failing Trips the Breaker
+    for (long const status : {400, 200, 503, 0})
+    {
+        breaker.record(breaker.acquire("GET", url).value(), response_with_status(status));
+    }
+    EXPECT_EQ(breaker_stats(breaker, key).state, GC::GCBreakerState::Open);
+    EXPECT_FALSE(breaker.acquire("GET", url).has_value());
+    EXPECT_TRUE(breaker.acquire("POST", "http://127.0.0.1/order/newtradeorder").has_value());
+
+    // A Failed Probe Reopens the Breaker
+    std::this_thread::sleep_for(std::chrono::milliseconds {60});
+    auto first_probe  = breaker.acquire("GET", url);
+    auto second_probe = breaker.acquire("GET", url);
+    ASSERT_TRUE(first_probe.has_value() && second_probe.has_value());
+    EXPECT_FALSE(breaker.acquire("GET", url).has_value());
+    EXPECT_EQ(breaker_stats(breaker, key).state, GC::GCBreakerState::HalfOpen);
+    breaker.record(*first_probe, response_with_status(200));
+    breaker.record(*second_probe, response_with_status(429));
+    EXPECT_EQ(breaker_stats(breaker, key).state, GC::GCBreakerState::Open);
+    EXPECT_EQ(breaker_stats(breaker, key).trips, 2);
+
+    // Every Probe Succeeding Closes It
+    std::this_thread::sleep_for(std::chrono::milliseconds {60});
+    first_probe  = breaker.acquire("GET", url);
+    second_probe = breaker.acquire("GET", url);
+    ASSERT_TRUE(first_probe.has_value() && second_probe.has_value());
+    breaker.record(*first_probe, response_with_status(200));
+    breaker.record(*second_probe, response_with_status(200));
+    GC::GCBreakerStats const stats = breaker_stats(breaker, key);
+    EXPECT_EQ(stats.state, GC::GCBreakerState::Closed);
+    EXPECT_EQ(stats.requests, 0);
+    EXPECT_EQ(stats.rejected, 2);
+    EXPECT_TRUE(breaker.acquire("GET", url).has_value());
+}
+
+TEST(GainCapitalUnit, Breaker_Ignores_Caller_Deadlines)
+{
+    GC::GCBreakerPolicy policy;
+    policy.min_requests  = 4;
+    policy.open_duration = std::chrono::milliseconds {50};
+    policy.probes        = 1;
+    GC::GCCircuitBreaker breaker(policy);
+    std::string const url = "http://127.0.0.1/market/1/tickhistory";
+    std::string const key = "GET /market/{id}/tickhistory";
+    GC::NetworkResponse expired;
+    expired.deadline_exceeded = true;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        breaker.record(breaker.acquire("GET", url).value(), expired);
+    }
+    EXPECT_EQ(breaker_stats(breaker, key).state, GC::GCBreakerState::Closed);
+    EXPECT_EQ(breaker_stats(breaker, key).requests, 0);
+
+    // An Expired Probe Hands Its Slot Back Without Reopening the Breaker
+    for (int i = 0; i < 4; ++i)
+    {
+        breaker.record(breaker.acquire("GET", url).value(), response_with_status(503));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds {60});
+    breaker.record(breaker.acquire("GET", url).value(), expired);
+    EXPECT_EQ(breaker_stats(breaker, key).state, GC::GCBreakerState::HalfOpen);
+    breaker.record(breaker.acquire("GET", url).value(), response_with_status(200));
+    EXPECT_EQ(breaker_stats(breaker, key).state, GC::GCBreakerState::Closed);
+    EXPECT_EQ(breaker_stats(breaker, key).trips, 1);
+
+    // Nor Do Requests the Client Fails Before Sending
+    GC::GCMockServerConfig config;
+    config.threads = 1;
+    auto server    = GC::GCMockServer::start(config);
+    ASSERT_TRUE(server.has_value());
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(server.value()->url());
+    gc.set_circuit_breaker(true, policy);
+    ASSERT_TRUE(gc.authenticate_session().has_value());
+    {
+        GC::GCDeadlineScope const expired_scope {std::chrono::milliseconds::zero()};
+        for (int i = 0; i < 10; ++i)
+        {
+            EXPECT_FALSE(gc.get_margin_info().has_value());
+        }
+    }
+    EXPECT_EQ(gc.get_metrics().circuit_trips, 0);
+    EXPECT_TRUE(gc.get_margin_info().has_value());
+}
+
+TEST(GainCapitalUnit, Breaker_Slow_Calls)
+{
+    GC::GCBreakerPolicy policy;
+    policy.min_requests    = 3;
+    policy.slow_call       = std::chrono::milliseconds {5};
+    policy.slow_call_ratio = 0.6;
+    GC::GCCircuitBreaker breaker(policy);
+    std::string const url = "http://127.0.0.1/market/1/information";
+
+    breaker.record(breaker.acquire("GET", url).value(), response_with_status(200));
+    for (int i = 0; i < 2; ++i)
+    {
+        auto permit = breaker.acquire("GET", url).value();
+        std::this_thread::sleep_for(std::chrono::milliseconds {10});
+        breaker.record(permit, response_with_status(200));
+    }
+    GC::GCBreakerStats const stats = breaker_stats(breaker, "GET /market/{id}/information");
+    EXPECT_EQ(stats.slow_calls, 2);
+    EXPECT_EQ(stats.failures, 0);
+    EXPECT_EQ(stats.state, GC::GCBreakerState::Open);
+}
+
+TEST(GainCapitalUnit, Breaker_Client_Fails_Fast)
+{
+    GC::GCMockServerConfig config;
+    config.threads = 1;
+    config.faults  = {.burst_probability = 1, .burst_length = 1000, .burst_status = 503};
+    auto server    = GC::GCMockServer::start(config);
+    ASSERT_TRUE(server.has_value());
+
+    GC::GCClient gc("USER", "PASSWORD", "APIKEY");
+    gc.set_testing_rest_urls(server.value()->url());
+    GC::GCBreakerPolicy policy;
+    policy.min_requests  = 5;
+    policy.open_duration = std::chrono::seconds {10};
+    gc.set_circuit_breaker(true, policy);
+    [[maybe_unused]] auto const auth_response = gc.authenticate_session();
+
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_FALSE(gc.get_margin_info().has_value());
+    }
+    std::uint64_t const served = server.value()->requests_served();
+    auto response              = gc.get_margin_info();
+    ASSERT_FALSE(response.has_value());
+    EXPECT_EQ(response.error().code(), GC::GCErrorCode::CircuitOpen);
+    EXPECT_EQ(server.value()->requests_served(), served);
+
+    // Each Endpoint Has Its Own Breaker
+    auto account_response = gc.get_account_info();
+    ASSERT_FALSE(account_response.has_value());
+    EXPECT_NE(account_response.error().code(), GC::GCErrorCode::CircuitOpen);
+
+    GC::GCMetricsSnapshot const metrics = gc.get_metrics();
+    EXPECT_EQ(metrics.circuit_trips, 1);
+    EXPECT_EQ(metrics.circuit_rejections, 6);
+}
+
 }// namespace
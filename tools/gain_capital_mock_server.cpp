@@ -0,0 +1,821 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include "gain_capital_mock_server.h"
+
+#include <algorithm>      // for min, max
+#include <array>          // for array
+#include <cctype>         // for tolower
+#include <cerrno>         // for errno, EAGAIN, EINTR
+#include <charconv>       // for from_chars
+#include <chrono>         // for steady_clock, microseconds
+#include <cstddef>        // for size_t
+#include <cstdint>        // for int64_t, uint16_t, uint32_t, uint64_t
+#include <expected>       // for expected
+#include <functional>     // for ref
+#include <map>            // for map, multimap
+#include <memory>         // for unique_ptr
+#include <mutex>          // for mutex, lock_guard
+#include <netinet/in.h>   // for sockaddr_in, htons, ntohs
+#include <netinet/tcp.h>  // for TCP_NODELAY
+#include <optional>       // for optional
+#include <random>         // for mt19937_64, uniform_real_distribution, exponential_distribution
+#include <source_location>// for source_location
+#include <string>         // for basic_string, to_string
+#include <string_view>    // for string_view
+#include <sys/epoll.h>    // for epoll_create1, epoll_ctl, epoll_wait
+#include <sys/eventfd.h>  // for eventfd
+#include <sys/socket.h>   // for socket, bind, listen, accept4, setsockopt, linger
+#include <thread>         // for thread
+#include <unistd.h>       // for close, read, write
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for move
+#include <vector>         // for vector
+
+#include "json/json.hpp"
+
+#include "gain_capital_exception.h"// for GCException
+#include "gain_capital_price.h"    // for GCPrice
+
+namespace gaincapital
+{
+
+namespace
+{
+
+constexpr std::size_t MAX_REQUEST_SIZE  = 1 << 20;
+constexpr std::size_t MAX_HISTORY_ROWS  = 100'000;
+constexpr std::size_t DEFAULT_ROWS      = 100;
+constexpr std::int64_t HISTORY_START_MS = 1'700'000'000'000;
+constexpr std::int64_t TICK_SPACING_MS  = 250;
+constexpr std::int64_t BAR_SPACING_MS   = 60'000;
+constexpr auto TRICKLE_INTERVAL         = std::chrono::milliseconds {1};
+
+struct Reply
+{
+    int status {200};
+    std::string body;
+};
+
+struct Fault
+{
+    std::chrono::microseconds delay {};
+    int error_status {};// replaces the reply when nonzero
+    bool reset {};
+    bool stall {};
+};
+
+bool iequals(std::string_view lhs, std::string_view rhs) noexcept
+{
+    auto const same = [](char const a, char const b)
+    { return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b)); };
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), same);
+}
+
+std::optional<std::string_view> query_value(std::string_view query, std::string_view key) noexcept
+{
+    while (! query.empty())
+    {
+        std::size_t const end      = std::min(query.find('&'), query.size());
+        std::string_view const arg = query.substr(0, end);
+        std::size_t const equals   = arg.find('=');
+        if (equals != std::string_view::npos && iequals(arg.substr(0, equals), key))
+        {
+            return arg.substr(equals + 1);
+        }
+        query.remove_prefix(std::min(end + 1, query.size()));
+    }
+    return std::nullopt;
+}
+
+std::optional<std::int64_t> query_number(std::string_view query, std::string_view key) noexcept
+{
+    auto const text = query_value(query, key);
+    std::int64_t value {};
+    if (! text || std::from_chars(text->data(), text->data() + text->size(), value).ec != std::errc {})
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+double json_number(nlohmann::json const& payload, char const* key)
+{
+    /* The client sends quantities and prices as strings */
+    if (! payload.contains(key))
+    {
+        return 0;
+    }
+    nlohmann::json const& value = payload[key];
+    return value.is_string() ? std::stod(value.get<std::string>()) : value.get<double>();
+}
+
+std::int64_t market_id(std::string_view market_name) noexcept
+{
+    /* Stable per name, so every thread and every run agree without shared state */
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (char const c : market_name)
+    {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+    return 400'000'000 + static_cast<std::int64_t>(hash % 1'000'000);
+}
+
+std::string_view reason_phrase(int const status) noexcept
+{
+    switch (status)
+    {
+        case 200:
+            return "OK";
+        case 400:
+            return "Bad Request";
+        case 404:
+            return "Not Found";
+        case 429:
+            return "Too Many Requests";
+        case 503:
+            return "Service Unavailable";
+        default:
+            return "Error";
+    }
+}
+
+void append_price(std::string& out, std::int64_t const units, std::uint8_t const decimals) { GCPrice::from_units(units, decimals).append_to(out); }
+
+std::string tick_history(std::size_t const rows, std::int64_t const start_ms, std::uint8_t const decimals)
+{
+    std::string body = "{\"PriceTicks\":[";
+    body.reserve(rows * 48 + 32);
+    std::int64_t units = 125'000;
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        units += static_cast<std::int64_t>((i * 7919) % 7) - 3;
+        body += (i == 0) ? "{\"TickDate\":\"\\/Date(" : ",{\"TickDate\":\"\\/Date(";
+        body += std::to_string(start_ms + static_cast<std::int64_t>(i) * TICK_SPACING_MS);
+        body += ")\\/\",\"Price\":";
+        append_price(body, units, decimals);
+        body += '}';
+    }
+    body += "]}";
+    return body;
+}
+
+std::string bar_history(std::size_t const rows, std::int64_t const start_ms, std::uint8_t const decimals)
+{
+    std::string body = "{\"PriceBars\":[";
+    body.reserve(rows * 112 + 48);
+    std::int64_t units = 125'000;
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        std::int64_t const close = units + static_cast<std::int64_t>((i * 7919) % 21) - 10;
+        body += (i == 0) ? "{\"BarDate\":\"\\/Date(" : ",{\"BarDate\":\"\\/Date(";
+        body += std::to_string(start_ms + static_cast<std::int64_t>(i) * BAR_SPACING_MS);
+        body += ")\\/\",\"Open\":";
+        append_price(body, units, decimals);
+        body += ",\"High\":";
+        append_price(body, std::max(units, close) + 4, decimals);
+        body += ",\"Low\":";
+        append_price(body, std::min(units, close) - 4, decimals);
+        body += ",\"Close\":";
+        append_price(body, close, decimals);
+        body += '}';
+        units = close;
+    }
+    body += "],\"PartialPriceBar\":null}";
+    return body;
+}
+
+}// namespace
+
+struct GCMockServer::OrderBook
+{
+    std::mutex mutex;
+    std::int64_t next_order_id {1'000'000};
+    std::uint64_t sessions {};
+    std::map<std::int64_t, nlohmann::json> active_orders;
+    std::vector<nlohmann::json> open_positions;
+};
+
+struct GCMockServer::Worker
+{
+    struct Connection
+    {
+        std::string input;
+        std::string output;
+        std::uint64_t serial {};
+        std::size_t delayed_responses {};
+        bool close_after_write {};
+        bool want_write {};
+        std::chrono::steady_clock::time_point ready_at {};// responses leave in request order whatever their delay
+    };
+
+    struct Delayed
+    {
+        int fd {};
+        std::uint64_t serial {};
+        std::string response;
+        std::size_t sent {};// bytes already handed to the connection
+        std::size_t header_size {};
+        std::size_t stall_at {};// offset the response pauses at; 0 for none
+        bool reset {};
+    };
+
+    int listen_fd {-1};
+    int epoll_fd {-1};
+    std::uint64_t next_serial {1};
+    std::unordered_map<int, Connection> connections;
+    std::multimap<std::chrono::steady_clock::time_point, Delayed> delayed;
+    std::unordered_map<std::size_t, std::string> tick_bodies;
+    std::unordered_map<std::size_t, std::string> bar_bodies;
+    std::mt19937_64 random;
+    std::thread thread;
+
+    ~Worker() { shutdown(); }
+
+    void shutdown()
+    {
+        /* Closing the connections tells pooled clients the server is gone instead of leaving requests unanswered */
+        for (auto const& [fd, connection] : connections)
+        {
+            close(fd);
+        }
+        connections.clear();
+        delayed.clear();
+        for (int* fd : {&listen_fd, &epoll_fd})
+        {
+            if (*fd >= 0)
+            {
+                close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+    void close_connection(int const fd)
+    {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    }
+
+    void reset_connection(int const fd)
+    {
+        /* Zero linger makes close send a RST in place of a FIN */
+        linger const abort {1, 0};
+        setsockopt(fd, SOL_SOCKET, SO_LINGER, &abort, sizeof(abort));
+        close_connection(fd);
+    }
+
+    void flush(int const fd)
+    {
+        auto it = connections.find(fd);
+        if (it == connections.end())
+        {
+            return;
+        }
+        Connection& connection = it->second;
+        std::size_t written    = 0;
+        while (written < connection.output.size())
+        {
+            ssize_t const bytes = write(fd, connection.output.data() + written, connection.output.size() - written);
+            if (bytes > 0)
+            {
+                written += static_cast<std::size_t>(bytes);
+                continue;
+            }
+            if (bytes < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (bytes < 0 && errno == EAGAIN)
+            {
+                break;
+            }
+            close_connection(fd);
+            return;
+        }
+        connection.output.erase(0, written);
+
+        if (connection.want_write == connection.output.empty())
+        {
+            connection.want_write = ! connection.output.empty();
+            epoll_event event {};
+            event.data.fd = fd;
+            event.events  = EPOLLIN | EPOLLRDHUP | (connection.want_write ? static_cast<unsigned>(EPOLLOUT) : 0U);
+            epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+        }
+        if (connection.output.empty() && connection.delayed_responses == 0 && connection.close_after_write)
+        {
+            close_connection(fd);
+        }
+    }
+};
+
+GCMockServer::GCMockServer() : order_book(std::make_unique<OrderBook>()) {}
+
+std::expected<std::unique_ptr<GCMockServer>, GCException> GCMockServer::start(GCMockServerConfig const& config)
+{
+    /*
+     * Binds every thread's listener before any thread starts, so the server accepts requests once this returns.
+     */
+    auto const fail = [](std::string const& reason)
+    {
+        return std::expected<std::unique_ptr<GCMockServer>, GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                                         "Mock Server Error - " + reason};
+    };
+
+    std::unique_ptr<GCMockServer> server {new GCMockServer {}};
+    server->config            = config;
+    server->config.threads    = std::max<std::size_t>(config.threads, 1);
+    server->bound_port        = config.port;
+    server->stop_fd           = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (server->stop_fd < 0)
+    {
+        return fail("Cannot Create Stop Event");
+    }
+
+    for (std::size_t i = 0; i < server->config.threads; ++i)
+    {
+        auto worker       = std::make_unique<Worker>();
+        worker->random.seed(config.faults.seed + i);
+        worker->listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        worker->epoll_fd  = epoll_create1(EPOLL_CLOEXEC);
+        int const enable  = 1;
+        setsockopt(worker->listen_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        setsockopt(worker->listen_fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+
+        sockaddr_in address {};
+        address.sin_family      = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port        = htons(server->bound_port);
+        if (worker->listen_fd < 0 || worker->epoll_fd < 0 || bind(worker->listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(worker->listen_fd, SOMAXCONN) != 0)
+        {
+            return fail("Cannot Listen on Port " + std::to_string(server->bound_port));
+        }
+        socklen_t length = sizeof(address);
+        getsockname(worker->listen_fd, reinterpret_cast<sockaddr*>(&address), &length);
+        server->bound_port = ntohs(address.sin_port);
+
+        for (int const fd : {worker->listen_fd, server->stop_fd})
+        {
+            epoll_event event {};
+            event.events  = EPOLLIN;
+            event.data.fd = fd;
+            epoll_ctl(worker->epoll_fd, EPOLL_CTL_ADD, fd, &event);
+        }
+        server->workers.push_back(std::move(worker));
+    }
+    for (auto& worker : server->workers)
+    {
+        worker->thread = std::thread(&GCMockServer::run, server.get(), std::ref(*worker));
+    }
+    return server;
+}
+
+GCMockServer::~GCMockServer()
+{
+    stop();
+    if (stop_fd >= 0)
+    {
+        close(stop_fd);
+    }
+}
+
+void GCMockServer::stop()
+{
+    std::uint64_t const one              = 1;
+    [[maybe_unused]] ssize_t const bytes = write(stop_fd, &one, sizeof(one));
+    for (auto& worker : workers)
+    {
+        if (worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+}
+
+std::uint16_t GCMockServer::port() const noexcept { return bound_port; }
+
+std::string GCMockServer::url() const { return "http://127.0.0.1:" + std::to_string(bound_port); }
+
+std::uint64_t GCMockServer::requests_served() const noexcept { return served.load(std::memory_order_relaxed); }
+
+std::uint64_t GCMockServer::faults_injected() const noexcept { return faulted.load(std::memory_order_relaxed); }
+
+void GCMockServer::run(Worker& worker)
+{
+    /*
+     * Drains each readable connection, answers every complete request in its buffer, and writes responses
+     * as far as the socket accepts. Delayed responses wait in a timer queue that bounds the epoll timeout.
+     */
+    auto const route = [this, &worker](std::string_view method, std::string_view target, std::string_view body) -> Reply
+    {
+        std::size_t const question = target.find('?');
+        std::string_view path      = target.substr(0, question);
+        std::string_view query     = question == std::string_view::npos ? std::string_view {} : target.substr(question + 1);
+        for (std::string_view const prefix : {"/v2", "/TradingAPI"})
+        {
+            if (path.starts_with(prefix) && path.size() > prefix.size() && path[prefix.size()] == '/')
+            {
+                path.remove_prefix(prefix.size());
+            }
+        }
+        nlohmann::json payload;
+        if (method == "POST")
+        {
+            payload = nlohmann::json::parse(body, nullptr, false);
+            if (payload.is_discarded())
+            {
+                return {400, "{\"ErrorMessage\":\"Malformed Payload\"}"};
+            }
+        }
+        // -------------------
+        if (method == "POST" && path == "/Session")
+        {
+            std::lock_guard<std::mutex> const lock {order_book->mutex};
+            return {200, "{\"statusCode\":0,\"session\":\"MockSession" + std::to_string(++order_book->sessions) + "\"}"};
+        }
+        if (method == "POST" && path == "/Session/validate")
+        {
+            return {200, "{\"isAuthenticated\":true}"};
+        }
+        if (method == "GET" && path == "/userAccount/ClientAndTradingAccount")
+        {
+            return {200, "{\"tradingAccounts\":[{\"tradingAccountId\":\"MockTradingAccount\",\"clientAccountId\":\"MockClientAccount\"}]}"};
+        }
+        if (method == "GET" && path == "/margin/clientAccountMargin")
+        {
+            return {200, "{\"Cash\":100000,\"Margin\":0,\"NetEquity\":100000,\"Currency\":\"USD\"}"};
+        }
+        if (method == "GET" && path == "/cfd/markets")
+        {
+            std::string const name {query_value(query, "MarketName").value_or("")};
+            return {200, "{\"Markets\":[{\"MarketId\":" + std::to_string(market_id(name)) + ",\"Name\":" + nlohmann::json(name).dump() + "}]}"};
+        }
+        if (method == "GET" && path.starts_with("/market/"))
+        {
+            std::string_view const rest   = path.substr(8);
+            std::size_t const slash       = rest.find('/');
+            std::string_view const id     = rest.substr(0, slash);
+            std::string_view const action = slash == std::string_view::npos ? std::string_view {} : rest.substr(slash + 1);
+            if (action == "information")
+            {
+                return {200, "{\"MarketInformation\":{\"MarketId\":" + std::string(id) +
+                                 ",\"PriceDecimalPlaces\":" + std::to_string(config.price_decimals) +
+                                 ",\"WebMinSize\":1000,\"MaxLongSize\":10000000,\"MaxShortSize\":10000000,\"IncrementSize\":1,"
+                                 "\"BetPer\":1,\"MarginFactor\":3.33}}"};
+            }
+            bool const ticks = action.starts_with("tickhistory");
+            if (ticks || action.starts_with("barhistory"))
+            {
+                std::int64_t const requested = query_number(query, ticks ? "PriceTicks" : "PriceBars")
+                                                   .value_or(query_number(query, "maxResults").value_or(static_cast<std::int64_t>(DEFAULT_ROWS)));
+                std::size_t const asked = static_cast<std::size_t>(std::max<std::int64_t>(requested, 0));
+                std::size_t const rows  = std::min(config.history_rows != 0 ? config.history_rows : asked, MAX_HISTORY_ROWS);
+                if (auto const from_s = query_number(query, "fromTimeStampUTC"))
+                {
+                    std::int64_t const start_ms = *from_s * 1000;
+                    return {200, ticks ? tick_history(rows, start_ms, config.price_decimals) : bar_history(rows, start_ms, config.price_decimals)};
+                }
+                auto& cache = ticks ? worker.tick_bodies : worker.bar_bodies;
+                auto cached = cache.find(rows);
+                if (cached == cache.end())
+                {
+                    cached = cache.emplace(rows, ticks ? tick_history(rows, HISTORY_START_MS, config.price_decimals)
+                                                       : bar_history(rows, HISTORY_START_MS, config.price_decimals))
+                                 .first;
+                }
+                return {200, cached->second};
+            }
+        }
+        // -------------------
+        if (method == "POST" && path.starts_with("/order/"))
+        {
+            std::string_view const action = path.substr(7);
+            std::lock_guard<std::mutex> const lock {order_book->mutex};
+            if (action == "newtradeorder")
+            {
+                std::int64_t const order_id = order_book->next_order_id++;
+                double const bid            = json_number(payload, "BidPrice");
+                double const offer          = json_number(payload, "OfferPrice");
+                std::string const direction = payload.value("Direction", "buy");
+                order_book->open_positions.push_back({{"OrderId", order_id},
+                                                      {"MarketId", static_cast<std::int64_t>(json_number(payload, "MarketId"))},
+                                                      {"Direction", direction},
+                                                      {"Quantity", json_number(payload, "Quantity")},
+                                                      {"Price", direction == "sell" ? bid : offer}});
+                return {200, "{\"OrderId\":" + std::to_string(order_id) + ",\"StatusReason\":1,\"Status\":1}"};
+            }
+            if (action == "newstoplimitorder" || action == "updatestoplimitorder")
+            {
+                std::int64_t const order_id = action == "newstoplimitorder" ? order_book->next_order_id++
+                                                                           : static_cast<std::int64_t>(json_number(payload, "OrderId"));
+                if (action == "updatestoplimitorder" && ! order_book->active_orders.contains(order_id))
+                {
+                    return {200, "{\"OrderId\":" + std::to_string(order_id) + ",\"StatusReason\":2,\"Status\":2}"};
+                }
+                nlohmann::json order = {{"OrderId", order_id},
+                                        {"MarketId", static_cast<std::int64_t>(json_number(payload, "MarketId"))},
+                                        {"Direction", payload.value("Direction", "buy")},
+                                        {"Quantity", json_number(payload, "Quantity")},
+                                        {"TriggerPrice", json_number(payload, "TriggerPrice")}};
+                if (payload.contains("Reference"))
+                {
+                    order["Reference"] = payload["Reference"];
+                }
+                order_book->active_orders[order_id] = {{"TradeOrder", nullptr}, {"StopLimitOrder", std::move(order)}};
+                return {200, "{\"OrderId\":" + std::to_string(order_id) + ",\"StatusReason\":1,\"Status\":1}"};
+            }
+            if (action == "cancel")
+            {
+                std::int64_t const order_id = static_cast<std::int64_t>(json_number(payload, "OrderId"));
+                bool const cancelled        = order_book->active_orders.erase(order_id) != 0;
+                return {200, "{\"OrderId\":" + std::to_string(order_id) + ",\"StatusReason\":" + (cancelled ? "1" : "2") + "}"};
+            }
+            if (action == "activeorders")
+            {
+                nlohmann::json response = {{"ActiveOrders", nlohmann::json::array()}};
+                for (auto const& [order_id, entry] : order_book->active_orders)
+                {
+                    response["ActiveOrders"].push_back(entry);
+                }
+                return {200, response.dump()};
+            }
+        }
+        if (method == "GET" && path == "/order/openpositions")
+        {
+            std::lock_guard<std::mutex> const lock {order_book->mutex};
+            return {200, nlohmann::json {{"OpenPositions", order_book->open_positions}}.dump()};
+        }
+        return {404, "{\"ErrorMessage\":\"Not Found\"}"};
+    };
+
+    auto const draw_fault = [this, &worker]() -> Fault
+    {
+        GCMockFaults const& faults = config.faults;
+        std::uniform_real_distribution<double> uniform {0.0, 1.0};
+        auto const happens = [&uniform, &worker](double const probability) { return probability > 0 && uniform(worker.random) < probability; };
+
+        Fault fault;
+        if (faults.jitter.count() > 0)
+        {
+            std::exponential_distribution<double> exponential {1.0 / static_cast<double>(faults.jitter.count())};
+            fault.delay = std::chrono::microseconds {static_cast<std::int64_t>(exponential(worker.random))};
+        }
+        bool const tail = happens(faults.tail_probability);
+        if (tail)
+        {
+            fault.delay += faults.tail_latency;
+        }
+        fault.reset = happens(faults.reset_probability);
+        fault.stall = faults.stall.count() > 0 && happens(faults.stall_probability);
+
+        /* A burst is shared by every thread, like a throttling gateway in front of the whole API */
+        std::size_t remaining = burst_remaining.load(std::memory_order_relaxed);
+        while (remaining > 0 && ! burst_remaining.compare_exchange_weak(remaining, remaining - 1, std::memory_order_relaxed))
+        {
+        }
+        if (remaining == 0 && faults.burst_length > 0 && happens(faults.burst_probability))
+        {
+            burst_remaining.store(faults.burst_length - 1, std::memory_order_relaxed);
+            remaining = 1;
+        }
+        fault.error_status = remaining > 0 ? faults.burst_status : 0;
+
+        if (tail || fault.reset || fault.stall || fault.error_status != 0)
+        {
+            faulted.fetch_add(1, std::memory_order_relaxed);
+        }
+        return fault;
+    };
+
+    auto const respond = [this, &worker, &route, &draw_fault](int const fd, Worker::Connection& connection) -> bool
+    {
+        /*
+         * :return: false when the buffer holds a malformed request and the connection was closed
+         */
+        std::size_t consumed = 0;
+        while (true)
+        {
+            std::string_view const buffer = std::string_view {connection.input}.substr(consumed);
+            std::size_t const header_end  = buffer.find("\r\n\r\n");
+            if (header_end == std::string_view::npos)
+            {
+                break;
+            }
+            std::string_view const head        = buffer.substr(0, header_end);
+            std::size_t const line_end         = head.find("\r\n");
+            std::string_view const request_line = head.substr(0, line_end);
+            std::size_t const first_space      = request_line.find(' ');
+            std::size_t const second_space     = request_line.find(' ', first_space + 1);
+            if (first_space == std::string_view::npos || second_space == std::string_view::npos)
+            {
+                worker.close_connection(fd);
+                return false;
+            }
+
+            std::size_t content_length = 0;
+            bool close_requested       = false;
+            std::string_view headers   = line_end == std::string_view::npos ? std::string_view {} : head.substr(line_end + 2);
+            while (! headers.empty())
+            {
+                std::size_t const end        = std::min(headers.find("\r\n"), headers.size());
+                std::string_view const field = headers.substr(0, end);
+                std::size_t const colon      = field.find(':');
+                if (colon != std::string_view::npos)
+                {
+                    std::string_view const name = field.substr(0, colon);
+                    std::string_view value      = field.substr(colon + 1);
+                    while (! value.empty() && value.front() == ' ')
+                    {
+                        value.remove_prefix(1);
+                    }
+                    if (iequals(name, "Content-Length"))
+                    {
+                        std::from_chars(value.data(), value.data() + value.size(), content_length);
+                    }
+                    else if (iequals(name, "Connection") && iequals(value, "close"))
+                    {
+                        close_requested = true;
+                    }
+                }
+                headers.remove_prefix(std::min(end + 2, headers.size()));
+            }
+            if (buffer.size() < header_end + 4 + content_length)
+            {
+                break;
+            }
+            // -------------------
+            std::string_view const method = request_line.substr(0, first_space);
+            std::string_view const target = request_line.substr(first_space + 1, second_space - first_space - 1);
+            Reply reply                   = route(method, target, buffer.substr(header_end + 4, content_length));
+
+            /* Logon is never faulted, so a degraded server still lets a client start its session */
+            Fault const fault = (method == "POST" && target.find("/Session") != std::string_view::npos) ? Fault {} : draw_fault();
+            if (fault.error_status != 0)
+            {
+                reply = {fault.error_status, "{\"ErrorMessage\":\"Injected Fault\"}"};
+            }
+            std::string response = "HTTP/1.1 " + std::to_string(reply.status) + " " + std::string(reason_phrase(reply.status)) +
+                                   "\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(reply.body.size()) +
+                                   (fault.error_status != 0 ? "\r\nRetry-After: 1" : "") +
+                                   (close_requested ? "\r\nConnection: close\r\n\r\n" : "\r\n\r\n") + reply.body;
+            served.fetch_add(1, std::memory_order_relaxed);
+            connection.close_after_write = connection.close_after_write || close_requested;
+            // -------------------
+            auto const now     = std::chrono::steady_clock::now();
+            auto const due     = std::max(now + config.latency + fault.delay, connection.ready_at);
+            bool const trickle = config.faults.body_bytes_per_second > 0;
+            if (due <= now && ! fault.reset && ! fault.stall && ! trickle && connection.delayed_responses == 0)
+            {
+                connection.output += response;
+            }
+            else
+            {
+                std::size_t const header_size = response.size() - reply.body.size();
+                std::size_t const stall_at    = fault.stall ? header_size + reply.body.size() / 2 : 0;
+                connection.ready_at           = due;
+                worker.delayed.emplace(due, Worker::Delayed {fd, connection.serial, std::move(response), 0, header_size, stall_at, fault.reset});
+                ++connection.delayed_responses;
+            }
+            consumed += header_end + 4 + content_length;
+        }
+        connection.input.erase(0, consumed);
+        if (connection.input.size() > MAX_REQUEST_SIZE)
+        {
+            worker.close_connection(fd);
+            return false;
+        }
+        return true;
+    };
+    // -------------------
+    std::array<epoll_event, 256> events {};
+    std::array<char, 64 * 1024> read_buffer {};
+    while (true)
+    {
+        int timeout_ms = -1;
+        if (! worker.delayed.empty())
+        {
+            auto const wait = worker.delayed.begin()->first - std::chrono::steady_clock::now();
+            timeout_ms      = static_cast<int>(std::max<std::int64_t>(0, std::chrono::ceil<std::chrono::milliseconds>(wait).count()));
+        }
+        int const ready = epoll_wait(worker.epoll_fd, events.data(), static_cast<int>(events.size()), timeout_ms);
+        for (std::size_t i = 0; i < static_cast<std::size_t>(std::max(ready, 0)); ++i)
+        {
+            int const fd             = events[i].data.fd;
+            std::uint32_t const mask = events[i].events;
+            if (fd == stop_fd)
+            {
+                worker.shutdown();
+                return;
+            }
+            if (fd == worker.listen_fd)
+            {
+                while (true)
+                {
+                    int const client = accept4(worker.listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (client < 0)
+                    {
+                        break;
+                    }
+                    int const enable = 1;
+                    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+                    epoll_event event {};
+                    event.events  = EPOLLIN | EPOLLRDHUP;
+                    event.data.fd = client;
+                    epoll_ctl(worker.epoll_fd, EPOLL_CTL_ADD, client, &event);
+                    worker.connections[client] = Worker::Connection {{}, {}, worker.next_serial++, 0, false, false, {}};
+                }
+                continue;
+            }
+            auto it = worker.connections.find(fd);
+            if (it == worker.connections.end())
+            {
+                continue;
+            }
+            if ((mask & static_cast<std::uint32_t>(EPOLLIN)) != 0U)
+            {
+                bool open = true;
+                while (true)
+                {
+                    ssize_t const bytes = read(fd, read_buffer.data(), read_buffer.size());
+                    if (bytes > 0)
+                    {
+                        it->second.input.append(read_buffer.data(), static_cast<std::size_t>(bytes));
+                        continue;
+                    }
+                    open = bytes < 0 && (errno == EAGAIN || errno == EINTR);
+                    if (! open || errno == EAGAIN)
+                    {
+                        break;
+                    }
+                }
+                if (! open)
+                {
+                    worker.close_connection(fd);
+                    continue;
+                }
+                if (! respond(fd, it->second))
+                {
+                    continue;
+                }
+                worker.flush(fd);
+                continue;
+            }
+            if ((mask & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) != 0U)
+            {
+                worker.close_connection(fd);
+                continue;
+            }
+            if ((mask & static_cast<std::uint32_t>(EPOLLOUT)) != 0U)
+            {
+                worker.flush(fd);
+            }
+        }
+        // -------------------
+        /*
+         * A due response is written whole, or up to its stall point, or one trickle slice past its headers;
+         * whatever remains goes back in the queue for after the stall or the next slice.
+         */
+        auto const now          = std::chrono::steady_clock::now();
+        std::size_t const slice = std::max<std::size_t>(1, config.faults.body_bytes_per_second * TRICKLE_INTERVAL.count() / 1000);
+        while (! worker.delayed.empty() && worker.delayed.begin()->first <= now)
+        {
+            auto node                = worker.delayed.extract(worker.delayed.begin());
+            Worker::Delayed& delayed = node.mapped();
+            int const fd             = delayed.fd;
+            auto it                  = worker.connections.find(fd);
+            if (it == worker.connections.end() || it->second.serial != delayed.serial)
+            {
+                continue;
+            }
+            if (delayed.reset)
+            {
+                worker.reset_connection(fd);
+                continue;
+            }
+            std::size_t end = delayed.response.size();
+            if (config.faults.body_bytes_per_second > 0)
+            {
+                end = std::min(end, std::max(delayed.sent, delayed.header_size) + slice);
+            }
+            bool const stalls = delayed.stall_at > delayed.sent && delayed.stall_at < end;
+            end               = stalls ? delayed.stall_at : end;
+            it->second.output.append(delayed.response, delayed.sent, end - delayed.sent);
+            delayed.sent = end;
+            if (end < delayed.response.size())
+            {
+                node.key() = now + (stalls ? config.faults.stall : std::chrono::microseconds {TRICKLE_INTERVAL});
+                worker.delayed.insert(std::move(node));
+            }
+            else
+            {
+                --it->second.delayed_responses;
+            }
+            worker.flush(fd);
+        }
+    }
+}
+
+}// namespace gaincapital
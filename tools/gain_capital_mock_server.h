@@ -0,0 +1,104 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#ifndef GAIN_CAPITAL_MOCK_SERVER_H
+#define GAIN_CAPITAL_MOCK_SERVER_H
+
+#include <atomic>  // for atomic
+#include <chrono>  // for microseconds
+#include <cstddef> // for size_t
+#include <cstdint> // for uint8_t, uint16_t, uint64_t
+#include <expected>// for expected
+#include <memory>  // for unique_ptr
+#include <string>  // for basic_string
+#include <vector>  // for vector
+
+#include "gain_capital_exception.h"// for GCException
+
+namespace gaincapital
+{
+
+struct GCMockFaults
+{
+    /*
+     * Degraded-server behaviour, drawn independently for every response except logon. Draws come from a
+     * per-thread generator seeded from seed, so a scenario replays the same way for the same request order.
+     */
+    std::chrono::microseconds jitter {0};// mean of an exponential delay added to the configured latency
+    double tail_probability {0};
+    std::chrono::microseconds tail_latency {0};// added on top for the tail_probability share of responses
+    std::size_t body_bytes_per_second {0};// 0 writes each response at once; otherwise bodies trickle out in 1ms slices
+    double reset_probability {0};// connection reset in place of the response
+    double burst_probability {0};// chance a request starts a burst of burst_length error responses
+    std::size_t burst_length {0};
+    int burst_status {503};// 429 or 503, sent with Retry-After
+    double stall_probability {0};// the body stops halfway for stall before the rest is written
+    std::chrono::microseconds stall {0};
+    std::uint64_t seed {1};
+};
+
+struct GCMockServerConfig
+{
+    std::uint16_t port {0};// 0 picks a free port
+    std::size_t threads {4};
+    std::size_t history_rows {0};// rows in every tick and bar history response; 0 serves the count requested
+    std::chrono::microseconds latency {0};
+    std::uint8_t price_decimals {5};
+    GCMockFaults faults;
+};
+
+class GCMockServer
+{
+    /*
+     * Stand-in for the Gain Capital REST API for load and soak testing. Serves Session, account, markets,
+     * market information, tick and bar history, order placement, amendment and cancellation, and the active
+     * order and open position lists, from an in-memory order book. Each thread runs its own epoll loop over
+     * its own SO_REUSEPORT listener with keep-alive connections; injected latency delays responses on a timer
+     * without blocking the loop. Routes match with or without the /v2 and /TradingAPI prefixes. Faults from
+     * GCMockFaults go through the same timer queue, so a stalled or trickling response never holds up other connections.
+     */
+  public:
+    [[nodiscard]] static std::expected<std::unique_ptr<GCMockServer>, GCException> start(GCMockServerConfig const& config = {});
+
+    ~GCMockServer();
+
+    // No Copy or Move | Worker Threads Hold a Pointer
+    GCMockServer(GCMockServer const& obj) = delete;
+
+    GCMockServer& operator=(GCMockServer const& obj) = delete;
+
+    GCMockServer(GCMockServer&& obj) = delete;
+
+    GCMockServer& operator=(GCMockServer&& obj) = delete;
+
+    void stop();
+
+    [[nodiscard]] std::uint16_t port() const noexcept;
+
+    [[nodiscard]] std::string url() const;
+
+    [[nodiscard]] std::uint64_t requests_served() const noexcept;
+
+    [[nodiscard]] std::uint64_t faults_injected() const noexcept;
+
+  private:
+    struct Worker;
+    struct OrderBook;
+
+    GCMockServerConfig config;
+    std::uint16_t bound_port {};
+    int stop_fd {-1};
+    std::atomic<std::uint64_t> served {0};
+    std::atomic<std::uint64_t> faulted {0};
+    std::atomic<std::size_t> burst_remaining {0};
+    std::unique_ptr<OrderBook> order_book;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    GCMockServer();
+
+    void run(Worker& worker);
+};
+
+}// namespace gaincapital
+
+#endif
@@ -0,0 +1,466 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <algorithm>       // for sort, stable_sort, min, count
+#include <atomic>          // for atomic
+#include <cctype>          // for toupper
+#include <charconv>        // for from_chars
+#include <chrono>          // for sys_days, year_month_day, seconds, system_clock
+#include <cstddef>         // for size_t
+#include <cstdint>         // for int64_t, uint8_t
+#include <cstdio>          // for sscanf
+#include <cstdlib>         // for getenv
+#include <expected>        // for expected
+#include <filesystem>      // for path, exists, create_directories, rename, remove
+#include <initializer_list>// for initializer_list
+#include <iostream>        // for cout, cerr
+#include <mutex>           // for mutex, lock_guard
+#include <optional>        // for optional
+#include <source_location> // for source_location
+#include <string>          // for basic_string, to_string
+#include <string_view>     // for string_view
+#include <system_error>    // for errc, error_code
+#include <thread>          // for jthread
+#include <unordered_map>   // for unordered_map
+#include <utility>         // for move
+#include <vector>          // for vector
+
+#include "gain_capital_bar_builder.h"// for GCBarColumns
+#include "gain_capital_client.h"     // for GCClient
+#include "gain_capital_exception.h"  // for GCException
+#include "gain_capital_market_data.h"// for GCPriceTick, GCPriceBar
+#include "gain_capital_tick_store.h" // for GCTickWriter, write_bar_file
+
+namespace GC = gaincapital;
+
+namespace
+{
+
+/*
+ * Downloads bar and tick history for many markets into one directory tree:
+ *   <out>/<market>/<INTERVAL>_<span>/<from>_<to>.gcbr   bar columns, see write_bar_file
+ *   <out>/<market>/TICK/<from>_<to>.gctk                  tick blocks, see GCTickWriter
+ * The date range is cut into chunks and every chunk is one request. Chunks are written beside their final name
+ * and renamed into place, so the files on disk are the progress record: rerunning the same command skips
+ * finished chunks and retries only what is missing. --max-in-flight caps requests across every market at once.
+ */
+constexpr std::string_view USAGE =
+    "Usage: HistoryDownloader --markets USD/CAD,EUR/USD --from 2024-01-01 --to 2024-02-01 [options]\n"
+    "  --interval MINUTE|HOUR|DAY|WEEK|MONTH  bar interval (default MINUTE)\n"
+    "  --span N                                bar span, as accepted by get_ohlc (default 1)\n"
+    "  --data bars|ticks|bars,ticks            series to download (default bars)\n"
+    "  --out DIR                               output directory (default history)\n"
+    "  --max-in-flight N                       concurrent requests across all markets (default 8)\n"
+    "  --bars-per-request N                    bars covered by one request (default 1000)\n"
+    "  --tick-minutes N                        minutes of ticks covered by one request (default 60)\n"
+    "  --price-type MID|BID|ASK                tick price type (default MID)\n"
+    "  --retries N                             attempts after a failed request (default 2)\n"
+    "Dates are UTC, as YYYY-MM-DD, YYYY-MM-DDTHH:MM:SS or epoch seconds.\n"
+    "Credentials are read from GC_USERNAME, GC_PASSWORD and GC_APPKEY.\n";
+
+struct Options
+{
+    std::vector<std::string> markets;
+    std::int64_t from_s {};
+    std::int64_t to_s {};
+    std::string interval = "MINUTE";
+    std::size_t span     = 1;
+    bool bars            = true;
+    bool ticks           = false;
+    std::filesystem::path out_dir {"history"};
+    std::size_t max_in_flight    = 8;
+    std::size_t bars_per_request = 1000;
+    std::size_t tick_minutes     = 60;
+    std::string price_type       = "MID";
+    std::size_t retries          = 2;
+};
+
+struct Chunk
+{
+    std::string market_name;
+    bool ticks {};
+    std::int64_t from_s {};
+    std::int64_t to_s {};
+    std::filesystem::path path;
+};
+
+std::vector<std::string> split(std::string_view text, char const delimiter)
+{
+    std::vector<std::string> parts;
+    while (! text.empty())
+    {
+        std::size_t const end = std::min(text.find(delimiter), text.size());
+        if (end != 0)
+        {
+            parts.emplace_back(text.substr(0, end));
+        }
+        text.remove_prefix(std::min(end + 1, text.size()));
+    }
+    return parts;
+}
+
+std::optional<std::size_t> parse_count(std::string_view text)
+{
+    std::size_t value {};
+    auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc {} || end != text.data() + text.size())
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<std::int64_t> parse_timestamp(std::string const& text)
+{
+    /*
+     * :text: YYYY-MM-DD, YYYY-MM-DDTHH:MM[:SS] or epoch seconds, UTC
+     * :return: epoch seconds
+     */
+    if (auto const seconds = parse_count(text))
+    {
+        return static_cast<std::int64_t>(*seconds);
+    }
+    int year {}, month {}, day {}, hour {}, minute {}, second {};
+    int const fields = std::sscanf(text.c_str(), "%d-%d-%dT%d:%d:%d", &year, &month, &day, &hour, &minute, &second);
+    std::chrono::year_month_day const date {std::chrono::year {year}, std::chrono::month {static_cast<unsigned>(month)},
+                                            std::chrono::day {static_cast<unsigned>(day)}};
+    if ((fields != 3 && fields != 5 && fields != 6) || ! date.ok() || hour > 23 || minute > 59 || second > 59)
+    {
+        return std::nullopt;
+    }
+    std::chrono::sys_seconds const time_point = std::chrono::sys_days {date} + std::chrono::hours {hour} + std::chrono::minutes {minute} +
+                                                std::chrono::seconds {second};
+    return time_point.time_since_epoch().count();
+}
+
+std::optional<std::int64_t> bar_seconds(std::string const& interval, std::size_t const span)
+{
+    /*
+     * :return: length of one bar, or nullopt when get_ohlc does not serve the interval and span
+     */
+    auto const allowed = [span](std::initializer_list<std::size_t> spans) { return std::count(spans.begin(), spans.end(), span) != 0; };
+
+    if (interval == "MINUTE" && allowed({1, 2, 3, 5, 10, 15, 30}))
+    {
+        return static_cast<std::int64_t>(span) * 60;
+    }
+    if (interval == "HOUR" && allowed({1, 2, 4, 8}))
+    {
+        return static_cast<std::int64_t>(span) * 3'600;
+    }
+    if (interval == "DAY" || interval == "WEEK" || interval == "MONTH")
+    {
+        return interval == "DAY" ? 86'400 : interval == "WEEK" ? 7 * 86'400 : 31 * 86'400;
+    }
+    return std::nullopt;
+}
+
+std::optional<Options> parse_options(int const argc, char** argv)
+{
+    Options options;
+    bool has_from = false, has_to = false;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string_view const flag = argv[i];
+        std::string const value     = argv[i + 1];
+        std::optional<std::size_t> count;
+
+        if (flag == "--markets")
+        {
+            options.markets = split(value, ',');
+        }
+        else if (flag == "--from" || flag == "--to")
+        {
+            auto const timestamp = parse_timestamp(value);
+            if (! timestamp)
+            {
+                std::cerr << "Invalid Date - " << value << '\n';
+                return std::nullopt;
+            }
+            (flag == "--from" ? options.from_s : options.to_s) = *timestamp;
+            (flag == "--from" ? has_from : has_to)             = true;
+        }
+        else if (flag == "--interval")
+        {
+            options.interval = value;
+            std::transform(options.interval.begin(), options.interval.end(), options.interval.begin(),
+                           [](unsigned char const c) { return static_cast<char>(std::toupper(c)); });
+        }
+        else if (flag == "--data")
+        {
+            auto const series = split(value, ',');
+            options.bars      = std::count(series.begin(), series.end(), "bars") != 0;
+            options.ticks     = std::count(series.begin(), series.end(), "ticks") != 0;
+        }
+        else if (flag == "--out")
+        {
+            options.out_dir = value;
+        }
+        else if (flag == "--price-type")
+        {
+            options.price_type = value;
+        }
+        else if ((flag == "--span" || flag == "--max-in-flight" || flag == "--bars-per-request" || flag == "--tick-minutes" ||
+                  flag == "--retries") &&
+                 (count = parse_count(value)))
+        {
+            if (flag == "--span")
+            {
+                options.span = *count;
+            }
+            else if (flag == "--max-in-flight")
+            {
+                options.max_in_flight = *count;
+            }
+            else if (flag == "--bars-per-request")
+            {
+                options.bars_per_request = *count;
+            }
+            else if (flag == "--tick-minutes")
+            {
+                options.tick_minutes = *count;
+            }
+            else
+            {
+                options.retries = *count;
+            }
+        }
+        else
+        {
+            std::cerr << "Invalid Argument - " << flag << ' ' << value << '\n';
+            return std::nullopt;
+        }
+    }
+    // -------------------
+    if (argc % 2 == 0 || options.markets.empty() || ! has_from || ! has_to || options.from_s <= 0 || options.to_s <= options.from_s)
+    {
+        std::cerr << "Provide --markets and a --from date before the --to date\n";
+        return std::nullopt;
+    }
+    if (! options.bars && ! options.ticks)
+    {
+        std::cerr << "Provide --data bars, ticks or bars,ticks\n";
+        return std::nullopt;
+    }
+    if (! bar_seconds(options.interval, options.span))
+    {
+        std::cerr << "Invalid Interval - " << options.interval << " / " << options.span << '\n';
+        return std::nullopt;
+    }
+    if (options.max_in_flight == 0 || options.bars_per_request == 0 || options.tick_minutes == 0)
+    {
+        std::cerr << "--max-in-flight, --bars-per-request and --tick-minutes must be positive\n";
+        return std::nullopt;
+    }
+    return options;
+}
+
+std::string directory_name(std::string market_name)
+{
+    std::replace_if(market_name.begin(), market_name.end(), [](char const c) { return c == '/' || c == '\\' || c == ' '; }, '_');
+    return market_name;
+}
+
+void plan_chunks(Options const& options, std::string const& market_name, bool const ticks, std::int64_t const now_s, std::vector<Chunk>& chunks,
+                 std::size_t& finished, std::size_t& still_open)
+{
+    /*
+     * Cuts the date range at multiples of the chunk length since the epoch, so a bar always lands in the same
+     * chunk file whatever range a rerun asks for. Every chunk covers its whole aligned span, even past --from
+     * or --to, so a file's name always describes its contents. Chunks whose file already exists are counted
+     * as finished; chunks that end in the future are left for a later run, since their data is incomplete.
+     */
+    std::int64_t const length = ticks ? static_cast<std::int64_t>(options.tick_minutes) * 60
+                                      : *bar_seconds(options.interval, options.span) * static_cast<std::int64_t>(options.bars_per_request);
+    std::filesystem::path const directory =
+        options.out_dir / directory_name(market_name) / (ticks ? std::string("TICK") : options.interval + "_" + std::to_string(options.span));
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    for (std::int64_t from_s = options.from_s - options.from_s % length; from_s < options.to_s; from_s += length)
+    {
+        std::int64_t const to_s = from_s + length;
+        if (to_s > now_s)
+        {
+            ++still_open;
+            continue;
+        }
+        std::filesystem::path path =
+            directory / (std::to_string(from_s) + "_" + std::to_string(to_s) + (ticks ? std::string(".gctk") : std::string(".gcbr")));
+        if (std::filesystem::exists(path))
+        {
+            ++finished;
+            continue;
+        }
+        chunks.emplace_back(market_name, ticks, from_s, to_s, std::move(path));
+    }
+}
+
+std::expected<std::size_t, GC::GCException> download_chunk(GC::GCClient& client, Options const& options, Chunk const& chunk,
+                                                           std::uint8_t const decimals)
+{
+    /*
+     * Requests [from, to - 1] so neighbouring chunks never share a boundary second.
+     * :return: rows written
+     */
+    auto const from_ts = static_cast<std::size_t>(chunk.from_s);
+    auto const to_ts   = static_cast<std::size_t>(chunk.to_s - 1);
+    if (! chunk.ticks)
+    {
+        auto bars = client.get_bar_history(chunk.market_name, options.interval, 1, options.span, from_ts, to_ts);
+        if (! bars)
+        {
+            return std::expected<std::size_t, GC::GCException> {std::unexpect, std::move(bars.error())};
+        }
+        std::sort(bars.value().begin(), bars.value().end(),
+                  [](GC::GCPriceBar const& lhs, GC::GCPriceBar const& rhs) { return lhs.timestamp_ms < rhs.timestamp_ms; });
+        auto written = GC::write_bar_file(chunk.path, GC::GCBarColumns::from_bars(bars.value(), decimals));
+        if (! written)
+        {
+            return std::expected<std::size_t, GC::GCException> {std::unexpect, std::move(written.error())};
+        }
+        return bars.value().size();
+    }
+    // -------------------
+    auto ticks = client.get_tick_history(chunk.market_name, 1, from_ts, to_ts, options.price_type);
+    if (! ticks)
+    {
+        return std::expected<std::size_t, GC::GCException> {std::unexpect, std::move(ticks.error())};
+    }
+    std::stable_sort(ticks.value().begin(), ticks.value().end(),
+                     [](GC::GCPriceTick const& lhs, GC::GCPriceTick const& rhs) { return lhs.timestamp_ms < rhs.timestamp_ms; });
+
+    std::filesystem::path temporary_path = chunk.path;
+    temporary_path += ".tmp";
+    std::error_code error;
+    std::filesystem::remove(temporary_path, error);
+    {
+        auto writer = GC::GCTickWriter::open(temporary_path, decimals);
+        if (! writer)
+        {
+            return std::expected<std::size_t, GC::GCException> {std::unexpect, std::move(writer.error())};
+        }
+        auto appended = writer.value().append(ticks.value());
+        auto closed   = appended ? writer.value().close() : std::expected<bool, GC::GCException> {true};
+        if (! appended || ! closed)
+        {
+            return std::expected<std::size_t, GC::GCException> {std::unexpect, appended ? std::move(closed.error()) : std::move(appended.error())};
+        }
+    }
+    std::filesystem::rename(temporary_path, chunk.path, error);
+    if (error)
+    {
+        return std::expected<std::size_t, GC::GCException> {std::unexpect, std::source_location::current().function_name(),
+                                                            "Tick File Error - Rename Failed - " + chunk.path.string()};
+    }
+    return ticks.value().size();
+}
+
+}// namespace
+
+int main(int argc, char** argv)
+{
+    auto const parsed = parse_options(argc, argv);
+    if (! parsed)
+    {
+        std::cerr << USAGE;
+        return 2;
+    }
+    Options const& options = *parsed;
+
+    char const* username = std::getenv("GC_USERNAME");
+    char const* password = std::getenv("GC_PASSWORD");
+    char const* appkey   = std::getenv("GC_APPKEY");
+    if (username == nullptr || password == nullptr || appkey == nullptr)
+    {
+        std::cerr << "Set GC_USERNAME, GC_PASSWORD and GC_APPKEY\n";
+        return 2;
+    }
+
+    GC::GCClient client {username, password, appkey};
+    auto authentication_response = client.authenticate_session();
+    if (! authentication_response)
+    {
+        std::cerr << "Error Location: " << authentication_response.error().where() << '\n';
+        std::cerr << authentication_response.error().what() << '\n';
+        return 1;
+    }
+
+    // Resolve Every Market ID and Price Precision in Two Concurrent Rounds
+    auto spec_response = client.load_market_specs(options.markets);
+    if (! spec_response)
+    {
+        std::cerr << spec_response.error().what() << '\n';
+    }
+
+    std::vector<Chunk> chunks;
+    std::size_t finished = 0, still_open = 0, skipped_markets = 0;
+    auto const now_s     = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    std::unordered_map<std::string, std::uint8_t> decimals;
+    for (std::string const& market_name : options.markets)
+    {
+        auto const spec = client.get_market_spec(market_name);
+        if (! spec)
+        {
+            std::cerr << "Skipping Market - No Market Information - " << market_name << '\n';
+            ++skipped_markets;
+            continue;
+        }
+        decimals[market_name] = spec->price_decimals;
+        if (options.bars)
+        {
+            plan_chunks(options, market_name, false, now_s, chunks, finished, still_open);
+        }
+        if (options.ticks)
+        {
+            plan_chunks(options, market_name, true, now_s, chunks, finished, still_open);
+        }
+    }
+    std::cout << chunks.size() << " chunks to download, " << finished << " already on disk\n";
+    if (still_open != 0)
+    {
+        std::cout << still_open << " chunks end in the future and are left for a later run\n";
+    }
+
+    // Download | Workers Pull the Next Chunk, So at Most max_in_flight Requests Are Outstanding
+    std::atomic<std::size_t> next_chunk {0};
+    std::atomic<std::size_t> completed {0};
+    std::atomic<std::size_t> failed {0};
+    std::mutex output_mutex;
+    {
+        std::vector<std::jthread> workers;
+        for (std::size_t i = 0; i < std::min(options.max_in_flight, chunks.size()); ++i)
+        {
+            workers.emplace_back(
+                [&]()
+                {
+                    for (std::size_t index = next_chunk++; index < chunks.size(); index = next_chunk++)
+                    {
+                        Chunk const& chunk = chunks[index];
+                        auto response      = download_chunk(client, options, chunk, decimals.at(chunk.market_name));
+                        for (std::size_t attempt = 0; ! response && attempt < options.retries; ++attempt)
+                        {
+                            response = download_chunk(client, options, chunk, decimals.at(chunk.market_name));
+                        }
+
+                        std::lock_guard<std::mutex> const lock {output_mutex};
+                        if (! response)
+                        {
+                            ++failed;
+                            std::cerr << "Failed " << chunk.path.string() << " - " << response.error().what() << '\n';
+                            continue;
+                        }
+                        std::cout << '[' << ++completed << '/' << chunks.size() << "] " << chunk.market_name << (chunk.ticks ? " ticks " : " bars ")
+                                  << chunk.from_s << " - " << chunk.to_s << ": " << response.value() << " rows\n";
+                    }
+                });
+        }
+    }
+
+    if (failed != 0 || skipped_markets != 0)
+    {
+        std::cerr << failed << " chunks failed and " << skipped_markets << " markets were skipped; rerun the same command to resume\n";
+        return 1;
+    }
+    return 0;
+}
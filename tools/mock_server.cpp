@@ -0,0 +1,168 @@
+// Copyright 2024, Andrew Drogalis
+// GNU License
+
+#include <charconv>   // for from_chars
+#include <chrono>     // for microseconds
+#include <csignal>    // for sigwait, SIGINT, SIGTERM
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t, uint16_t
+#include <iostream>   // for cout, cerr
+#include <optional>   // for optional
+#include <pthread.h>  // for pthread_sigmask
+#include <string_view>// for string_view
+
+#include "gain_capital_mock_server.h"// for GCMockServer, GCMockServerConfig
+
+namespace GC = gaincapital;
+
+namespace
+{
+
+constexpr std::string_view USAGE = "Usage: MockServer [--port N] [--threads N] [--history-rows N] [--latency-us N] [--price-decimals N]\n"
+                                   "                  [--jitter-us N] [--tail-probability P] [--tail-us N] [--body-bytes-per-second N]\n"
+                                   "                  [--reset-probability P] [--burst-probability P] [--burst-length N] [--burst-status N]\n"
+                                   "                  [--stall-probability P] [--stall-us N] [--seed N]\n"
+                                   "  Serves the Gain Capital REST API on 127.0.0.1 until interrupted.\n"
+                                   "  --history-rows 0 serves the number of ticks or bars each request asks for.\n"
+                                   "  Probabilities are per response, from 0 to 1; logon is never faulted.\n";
+
+std::optional<std::size_t> parse_count(std::string_view text)
+{
+    std::size_t value {};
+    auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc {} || end != text.data() + text.size())
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<double> parse_probability(std::string_view text)
+{
+    double value {};
+    auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc {} || end != text.data() + text.size() || value < 0 || value > 1)
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+}// namespace
+
+int main(int argc, char** argv)
+{
+    GC::GCMockServerConfig config;
+    config.port = 9300;
+    GC::GCMockFaults& faults = config.faults;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string_view const flag = argv[i];
+        if (flag.ends_with("-probability"))
+        {
+            auto const probability = parse_probability(argv[i + 1]);
+            if (! probability)
+            {
+                std::cerr << USAGE;
+                return 2;
+            }
+            double* const target = flag == "--tail-probability"    ? &faults.tail_probability
+                                   : flag == "--reset-probability" ? &faults.reset_probability
+                                   : flag == "--burst-probability" ? &faults.burst_probability
+                                   : flag == "--stall-probability" ? &faults.stall_probability
+                                                                   : nullptr;
+            if (! target)
+            {
+                std::cerr << USAGE;
+                return 2;
+            }
+            *target = *probability;
+            continue;
+        }
+        auto const value = parse_count(argv[i + 1]);
+        if (! value)
+        {
+            std::cerr << USAGE;
+            return 2;
+        }
+        if (flag == "--port")
+        {
+            config.port = static_cast<std::uint16_t>(*value);
+        }
+        else if (flag == "--threads")
+        {
+            config.threads = *value;
+        }
+        else if (flag == "--history-rows")
+        {
+            config.history_rows = *value;
+        }
+        else if (flag == "--latency-us")
+        {
+            config.latency = std::chrono::microseconds {*value};
+        }
+        else if (flag == "--price-decimals")
+        {
+            config.price_decimals = static_cast<std::uint8_t>(*value);
+        }
+        else if (flag == "--jitter-us")
+        {
+            faults.jitter = std::chrono::microseconds {*value};
+        }
+        else if (flag == "--tail-us")
+        {
+            faults.tail_latency = std::chrono::microseconds {*value};
+        }
+        else if (flag == "--body-bytes-per-second")
+        {
+            faults.body_bytes_per_second = *value;
+        }
+        else if (flag == "--burst-length")
+        {
+            faults.burst_length = *value;
+        }
+        else if (flag == "--burst-status")
+        {
+            faults.burst_status = static_cast<int>(*value);
+        }
+        else if (flag == "--stall-us")
+        {
+            faults.stall = std::chrono::microseconds {*value};
+        }
+        else if (flag == "--seed")
+        {
+            faults.seed = *value;
+        }
+        else
+        {
+            std::cerr << USAGE;
+            return 2;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        std::cerr << USAGE;
+        return 2;
+    }
+
+    // Block Shutdown Signals Before the Worker Threads Inherit the Mask
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    auto server = GC::GCMockServer::start(config);
+    if (! server)
+    {
+        std::cerr << server.error().what() << '\n';
+        return 1;
+    }
+    std::cout << "Serving " << server.value()->url() << " on " << config.threads << " threads\n" << std::flush;
+
+    int signal = 0;
+    sigwait(&signals, &signal);
+    server.value()->stop();
+    std::cout << server.value()->requests_served() << " requests served, " << server.value()->faults_injected() << " faulted\n";
+    return 0;
+}